@@ -254,7 +254,18 @@ bool AssetList::VerifyNoUnsavedChanges(Asset* asset, bool allowCancel)
 
 	switch (action)
 	{
-	case QMessageBox::StandardButton::Save: return Save(asset);
+	case QMessageBox::StandardButton::Save:
+	{
+		if (!Save(asset))
+		{
+			return false;
+		}
+
+		// The save may still be in progress. The asset is only clean if it was written successfully.
+		asset->WaitForPendingSave();
+		return asset->GetUndoStack()->isClean();
+	}
+
 	case QMessageBox::StandardButton::Discard: return true;
 	default:
 	case QMessageBox::StandardButton::Cancel: return false;
@@ -1,16 +1,21 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iterator>
-#include <stdexcept>
 
+#include <QEvent>
 #include <QFileInfo>
 #include <QLayout>
 #include <QMessageBox>
 #include <QOpenGLFunctions_1_1>
 #include <QOpenGLDebugLogger>
+#include <QMouseEvent>
 #include <QProcess>
+#include <QScreen>
 #include <QSettings>
+#include <QUndoStack>
+#include <QWindow>
 
 #include <spdlog/logger.h>
 
@@ -22,6 +27,7 @@
 #include "filesystem/IFileSystem.hpp"
 
 #include "graphics/IGraphicsContext.hpp"
+#include "graphics/RenderStatistics.hpp"
 #include "graphics/TextureLoader.hpp"
 
 #include "plugins/IAssetManagerPlugin.hpp"
@@ -49,6 +55,7 @@
 #include "ui/options/gameconfigurations/OptionsPageFileSystem.hpp"
 #include "ui/options/gameconfigurations/OptionsPageGameConfigurations.hpp"
 
+#include "utility/FrameScheduler.hpp"
 #include "utility/WorldTime.hpp"
 
 Q_LOGGING_CATEGORY(HLAM, "hlam")
@@ -81,6 +88,8 @@ AssetManager::AssetManager(
 		? std::unique_ptr<ISoundSystem>(std::make_unique<SoundSystem>(CreateQtLoggerSt(HLAMSoundSystem())))
 		: std::make_unique<DummySoundSystem>())
 	, _worldTime(std::make_unique<WorldTime>())
+	, _frameScheduler(std::make_unique<FrameScheduler>())
+	, _renderStatistics(std::make_unique<graphics::RenderStatisticsHistory>())
 	, _assets(std::make_unique<AssetList>(this, _logger))
 {
 	_logger->debug("Initializing OpenGL");
@@ -112,12 +121,9 @@ AssetManager::AssetManager(
 
 	_logger->debug("Initialized OpenGL");
 
+	// The timer is restarted every tick with the time remaining until the next frame.
 	_timer->setTimerType(Qt::TimerType::PreciseTimer);
-
-	if (!_soundSystem->Initialize())
-	{
-		throw std::runtime_error("Failed to initialize sound system");
-	}
+	_timer->setSingleShot(true);
 
 	connect(_guiApplication, &QGuiApplication::applicationStateChanged, this, &AssetManager::OnApplicationStateChanged);
 
@@ -139,6 +145,19 @@ AssetManager::AssetManager(
 
 	connect(_applicationSettings.get(), &ApplicationSettings::SceneWidgetSettingsChanged,
 		this, &AssetManager::RecreateSceneWidget);
+	// Frame pacing depends on whether vertical sync is enabled.
+	connect(_applicationSettings.get(), &ApplicationSettings::SceneWidgetSettingsChanged,
+		this, [this] { OnTickRateChanged(_applicationSettings->GetTickRate()); });
+
+	// Anything that can change what the scene looks like should request a redraw.
+	connect(_applicationSettings.get(), &ApplicationSettings::SettingsLoaded, this, &AssetManager::RequestRedraw);
+	connect(_applicationSettings.get(), &ApplicationSettings::SettingsSaved, this, &AssetManager::RequestRedraw);
+	connect(_applicationSettings.get(), &ApplicationSettings::TextureFiltersChanged, this, &AssetManager::RequestRedraw);
+	connect(this, &AssetManager::SettingsChanged, this, &AssetManager::RequestRedraw);
+	connect(_assets.get(), &AssetList::ActiveAssetChanged, this, &AssetManager::OnActiveAssetChanged);
+
+	// Camera input and edits made through the UI both arrive as input events.
+	_guiApplication->installEventFilter(this);
 
 	_optionsPageRegistry->AddPage(std::make_unique<OptionsPageGeneral>(applicationSettings));
 	_optionsPageRegistry->AddPage(std::make_unique<OptionsPageColors>(applicationSettings));
@@ -211,6 +230,8 @@ void AssetManager::RecreateSceneWidget()
 	_sceneWidget = new SceneWidget(this, GetOpenGLFunctions(), GetTextureLoader());
 	_sceneWidget->installEventFilter(GetDragNDropEventFilter());
 
+	RequestRedraw();
+
 	emit SceneWidgetRecreated();
 
 	// Delete the widget after notifying everybody so any remaining references to this can be removed.
@@ -227,7 +248,26 @@ bool AssetManager::IsInFullscreenMode()
 
 void AssetManager::StartTimer()
 {
-	_timer->start(1000 / _applicationSettings->GetTickRate());
+	using namespace std::chrono;
+
+	double interval = 1'000'000.0 / _applicationSettings->GetTickRate();
+
+	// With vertical sync enabled, tick at a whole multiple of the display refresh interval
+	// so every tick lines up with a presented frame.
+	if (_applicationSettings->ShouldEnableVSync())
+	{
+		QScreen* screen = _mainWindow && _mainWindow->windowHandle()
+			? _mainWindow->windowHandle()->screen() : _guiApplication->primaryScreen();
+
+		if (const qreal refreshRate = screen ? screen->refreshRate() : 0; refreshRate > 0)
+		{
+			const double refreshInterval = 1'000'000.0 / refreshRate;
+			interval = refreshInterval * std::max(1.0, std::round(interval / refreshInterval));
+		}
+	}
+
+	_frameScheduler->SetInterval(microseconds{static_cast<microseconds::rep>(interval)});
+	_timer->start(0);
 }
 
 void AssetManager::PauseTimer()
@@ -328,6 +368,21 @@ void AssetManager::Start()
 	StartTimer();
 }
 
+void AssetManager::InitializeSoundSystem()
+{
+	_logger->debug("Initializing sound system");
+
+	if (!_soundSystem->Initialize())
+	{
+		_logger->error("Failed to initialize sound system");
+	}
+
+	// Initializing unmutes the sound system, so restore the mute state for the current application state.
+	OnApplicationStateChanged(_guiApplication->applicationState());
+
+	emit SoundSystemInitialized();
+}
+
 void AssetManager::OnMainWindowClosing()
 {
 	_mainWindow = nullptr;
@@ -365,6 +420,19 @@ void AssetManager::OnApplicationStateChanged(Qt::ApplicationState state)
 	}
 }
 
+void AssetManager::OnActiveAssetChanged(Asset* asset)
+{
+	disconnect(_undoStackConnection);
+	_undoStackConnection = {};
+
+	if (asset)
+	{
+		_undoStackConnection = connect(asset->GetUndoStack(), &QUndoStack::indexChanged, this, &AssetManager::RequestRedraw);
+	}
+
+	RequestRedraw();
+}
+
 void AssetManager::OnSettingsChanged()
 {
 	// Just in case settings are changed while not active.
@@ -376,32 +444,67 @@ void AssetManager::OnSettingsChanged()
 
 void AssetManager::OnTimerTick()
 {
-	const auto timeMillis{std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()};
+	using namespace std::chrono;
 
-	const double currentTime = timeMillis / 1000.0;
+	const auto frameStart = FrameScheduler::Clock::now();
 
-	double flFrameTime = currentTime - _worldTime->GetPreviousRealTime();
+	_frameScheduler->SetFixedTimeStep(_applicationSettings->FixedTimeStep);
 
-	_worldTime->SetRealTime(currentTime);
+	const auto frame = _frameScheduler->BeginFrame(frameStart);
 
-	if (flFrameTime > 1.0)
+	_worldTime->SetPreviousRealTime(_worldTime->GetRealTime());
+	_worldTime->SetRealTime(duration<double>{frameStart.time_since_epoch()}.count());
+
+	for (std::size_t step = 0; step < frame.StepCount; ++step)
 	{
-		flFrameTime = 0.1;
+		_worldTime->Advance(frame.StepTime);
+
+		if (auto asset = _assets->GetCurrent(); asset)
+		{
+			asset->GetProvider()->Tick();
+		}
 	}
 
-#if false
-	if (flFrameTime < (1.0 / /*max_fps.GetFloat()*/60.0f))
+	if (_sceneWidget && _redrawRequested)
 	{
-		return;
+		_redrawRequested = false;
+		_sceneWidget->update();
 	}
-#endif
 
-	_worldTime->TimeChanged(currentTime);
+	// Don't restart the timer if it was paused or stopped while ticking.
+	if (_timerPauseCount == 0 && _mainWindow)
+	{
+		const auto timeUntilNextFrame = _frameScheduler->GetTimeUntilNextFrame(FrameScheduler::Clock::now());
+		_timer->start(static_cast<int>(duration_cast<milliseconds>(timeUntilNextFrame).count()));
+	}
+}
 
-	if (auto asset = _assets->GetCurrent(); asset)
+bool AssetManager::eventFilter(QObject* watched, QEvent* event)
+{
+	switch (event->type())
 	{
-		asset->GetProvider()->Tick();
+	case QEvent::Type::MouseMove:
+		// Hovering over widgets doesn't change the scene.
+		if (static_cast<QMouseEvent*>(event)->buttons() == Qt::MouseButton::NoButton)
+		{
+			break;
+		}
+
+		[[fallthrough]];
+
+	case QEvent::Type::MouseButtonPress:
+	case QEvent::Type::MouseButtonRelease:
+	case QEvent::Type::MouseButtonDblClick:
+	case QEvent::Type::Wheel:
+	case QEvent::Type::KeyPress:
+	case QEvent::Type::KeyRelease:
+		RequestRedraw();
+		break;
+
+	default: break;
 	}
+
+	return QObject::eventFilter(watched, event);
 }
 
 void AssetManager::OnTickRateChanged(int value)
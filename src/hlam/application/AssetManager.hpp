@@ -14,10 +14,12 @@
 #include <spdlog/logger.h>
 
 class ApplicationSettings;
+class Asset;
 class AssetList;
 class AssetProviderRegistry;
 class ColorSettings;
 class DragNDropEventFilter;
+class FrameScheduler;
 class GameConfigurationsSettings;
 class IAssetManagerPlugin;
 class IFileSystem;
@@ -36,6 +38,7 @@ class WorldTime;
 namespace graphics
 {
 class IGraphicsContext;
+class RenderStatisticsHistory;
 class TextureLoader;
 }
 
@@ -96,6 +99,13 @@ public:
 
 	WorldTime* GetWorldTime() const { return _worldTime.get(); }
 
+	FrameScheduler* GetFrameScheduler() const { return _frameScheduler.get(); }
+
+	/**
+	*	@brief Statistics for frames drawn by the scene widget.
+	*/
+	graphics::RenderStatisticsHistory* GetRenderStatistics() const { return _renderStatistics.get(); }
+
 	AssetList* GetAssets() const { return _assets.get(); }
 
 	MainWindow* GetMainWindow() const { return _mainWindow; }
@@ -107,6 +117,12 @@ public:
 
 	void RecreateSceneWidget();
 
+	/**
+	*	@brief Marks the scene as dirty so it is redrawn on the next tick.
+	*	In continuous rendering mode the scene widget redraws itself regardless.
+	*/
+	void RequestRedraw() { _redrawRequested = true; }
+
 	bool IsInFullscreenMode();
 
 	void StartTimer();
@@ -135,6 +151,12 @@ public:
 
 	void Start();
 
+	/**
+	*	@brief Opens the audio device. Deferred until after the main window is shown because it can take a while.
+	*	Sounds are not played until this has been called.
+	*/
+	void InitializeSoundSystem();
+
 	void OnMainWindowClosing();
 
 	void OnExit();
@@ -143,6 +165,9 @@ public:
 
 	void InitializeFileSystem(IFileSystem& fileSystem, const QString& fileName);
 
+protected:
+	bool eventFilter(QObject* watched, QEvent* event) override;
+
 private:
 	template<typename TFunction, typename... Args>
 	void CallPlugins(TFunction&& function, Args&&... args)
@@ -160,11 +185,19 @@ signals:
 
 	void FullscreenModeChanged();
 
-	void LogMessageReceived(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+	void SoundSystemInitialized();
+
+	/**
+	*	@brief Emitted for every message passed to Qt's logging system. Always emitted on the main thread;
+	*	messages logged on other threads are queued to it.
+	*/
+	void LogMessageReceived(QtMsgType type, const QString& category, const QString& msg);
 
 private slots:
 	void OnApplicationStateChanged(Qt::ApplicationState state);
 
+	void OnActiveAssetChanged(Asset* asset);
+
 	void OnSettingsChanged();
 
 	void OnTimerTick();
@@ -202,11 +235,16 @@ private:
 
 	const std::unique_ptr<ISoundSystem> _soundSystem;
 	const std::unique_ptr<WorldTime> _worldTime;
+	const std::unique_ptr<FrameScheduler> _frameScheduler;
+	const std::unique_ptr<graphics::RenderStatisticsHistory> _renderStatistics;
 
 	const std::unique_ptr<AssetList> _assets;
 
 	MainWindow* _mainWindow{};
 	QPointer<SceneWidget> _sceneWidget;
+
+	bool _redrawRequested{true};
+	QMetaObject::Connection _undoStackConnection;
 };
 
 struct TimerSuspender final
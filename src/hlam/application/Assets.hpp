@@ -59,8 +59,16 @@ public:
 	*/
 	virtual QWidget* GetEditWidget() = 0;
 
+	/**
+	*	@brief Saves the asset. Assets may finish writing the file asynchronously.
+	*/
 	virtual void Save() = 0;
 
+	/**
+	*	@brief Blocks until the save in progress, if any, has finished and reports its result.
+	*/
+	virtual void WaitForPendingSave() {}
+
 	virtual bool TryRefresh() = 0;
 
 	virtual bool CanTakeScreenshot() const = 0;
@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <QImage>
+#include <QString>
+
+#include "application/AssetIO.hpp"
+#include "application/BatchProcessor.hpp"
+
+#include "filesystem/FileSystem.hpp"
+
+#include "formats/studiomodel/DumpModelInfo.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/MeshOptimization.hpp"
+#include "formats/studiomodel/StudioModelIO.hpp"
+#include "formats/studiomodel/StudioModelUtils.hpp"
+
+#include "plugins/halflife/studiomodel/ui/StudioModelTextureUtilities.hpp"
+
+#include "utility/IOUtils.hpp"
+#include "utility/ThreadPool.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t SlowestFileCount = 5;
+
+struct BatchFileResult
+{
+	std::filesystem::path FileName;
+	bool Success{false};
+	std::string Message;
+	double Milliseconds{};
+};
+
+const char* BatchOperationToString(BatchOperation operation)
+{
+	switch (operation)
+	{
+	case BatchOperation::Validate: return "validate";
+	case BatchOperation::Dump: return "dump";
+	case BatchOperation::Resave: return "resave";
+	case BatchOperation::ExportTextures: return "export-textures";
+
+	default: return "invalid";
+	}
+}
+
+std::string PathToString(const std::filesystem::path& path)
+{
+	return reinterpret_cast<const char*>(path.u8string().c_str());
+}
+
+/**
+*	@brief Gets the directory that files generated for a model are written to, creating it if needed.
+*/
+std::filesystem::path GetOutputDirectory(const BatchOptions& options, const std::filesystem::path& fileName)
+{
+	if (options.OutputDirectory.empty())
+	{
+		return fileName.parent_path();
+	}
+
+	const auto directory = options.OutputDirectory / fileName.parent_path().lexically_relative(options.Directory);
+
+	// Other threads may be creating the same directory, so only fail if it doesn't exist afterwards.
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+
+	if (!std::filesystem::is_directory(directory))
+	{
+		throw AssetException(fmt::format("Could not create output directory \"{}\": {}", directory, error.message()));
+	}
+
+	return directory;
+}
+
+std::string ValidateModel(const std::filesystem::path& fileName, const studiomdl::EditableStudioModel& editableModel)
+{
+	// Converting back checks the limits the model must stay within to be saved.
+	studiomdl::ConvertFromEditable(fileName, editableModel);
+
+	return fmt::format("{} bones, {} sequences, {} textures{}",
+		editableModel.Bones.size(), editableModel.Sequences.size(), editableModel.Textures.size(),
+		editableModel.IsXashModel ? ", Xash model" : "");
+}
+
+std::string DumpModel(const BatchOptions& options, const std::filesystem::path& fileName,
+	const studiomdl::EditableStudioModel& editableModel)
+{
+	const auto outputFileName = GetOutputDirectory(options, fileName)
+		/ (fileName.stem().u8string() + u8"_modelinfo.txt");
+
+	FilePtr file{utf8_fopen(outputFileName.u8string().c_str(), "w")};
+
+	if (!file)
+	{
+		throw AssetException(fmt::format("Could not open file \"{}\" for writing", outputFileName));
+	}
+
+	studiomdl::DumpModelInfo(file.get(), fileName, editableModel);
+
+	return PathToString(outputFileName);
+}
+
+std::string ResaveModel(const BatchOptions& options, const std::filesystem::path& fileName,
+	studiomdl::EditableStudioModel& editableModel)
+{
+	if (editableModel.IsXashModel)
+	{
+		throw AssetException("Xash models are not resaved because Xash-specific data would be lost");
+	}
+
+	// Same as saving in the editor: textures and sequence groups are merged into the main file.
+	editableModel.HasExternalTextureFile = false;
+
+	const auto outputFileName = GetOutputDirectory(options, fileName) / fileName.filename();
+
+	if (options.OptimizeMeshes)
+	{
+		studiomdl::ApplyTriangleCommands(editableModel, studiomdl::OptimizeMeshes(editableModel, nullptr).Commands);
+	}
+
+	// Files are already processed in parallel, so each model's animations are compressed on the thread resaving it.
+	studiomdl::ConvertFromEditableOptions convertOptions;
+	convertOptions.CompressAnimations = options.CompressAnimations;
+
+	auto result = studiomdl::ConvertFromEditable(outputFileName, editableModel, convertOptions);
+
+	studiomdl::SaveStudioModel(outputFileName, result);
+
+	return PathToString(outputFileName);
+}
+
+std::string ExportTextures(const BatchOptions& options, const std::filesystem::path& fileName,
+	const studiomdl::EditableStudioModel& editableModel)
+{
+	const auto directory = GetOutputDirectory(options, fileName) / (fileName.stem().u8string() + u8"_textures");
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+
+	if (error)
+	{
+		throw AssetException(fmt::format("Could not create directory \"{}\": {}", directory, error.message()));
+	}
+
+	std::string failedTextures;
+
+	for (const auto& texture : editableModel.Textures)
+	{
+		// Texture names come from the file and may contain anything, so never let them leave the directory.
+		const auto textureFileName = directory / std::filesystem::u8path(texture->Name).filename();
+
+		const auto image = ConvertTextureToIndexed8Image(texture->Data);
+
+		if (!image.save(QString::fromStdString(PathToString(textureFileName))))
+		{
+			failedTextures += fmt::format(" \"{}\"", texture->Name);
+		}
+	}
+
+	if (!failedTextures.empty())
+	{
+		throw AssetException(fmt::format("Failed to save textures:{}", failedTextures));
+	}
+
+	return fmt::format("{} textures to {}", editableModel.Textures.size(), directory);
+}
+
+BatchFileResult ProcessFile(const BatchOptions& options, const std::filesystem::path& fileName)
+{
+	BatchFileResult result;
+
+	result.FileName = fileName;
+
+	const auto start = Clock::now();
+
+	try
+	{
+		FileSystem fileSystem;
+
+		studiomdl::EditableStudioModel editableModel;
+
+		{
+			FilePtr file{utf8_fopen(fileName.u8string().c_str(), "rb")};
+
+			if (!file)
+			{
+				throw AssetException("Could not open file");
+			}
+
+			// Close the file before doing anything else so it can be overwritten by resave.
+			const auto studioModel = studiomdl::LoadStudioModel(fileName, file.get(), fileSystem);
+
+			editableModel = studiomdl::ConvertToEditable(*studioModel);
+		}
+
+		switch (options.Operation)
+		{
+		case BatchOperation::Validate:
+			result.Message = ValidateModel(fileName, editableModel);
+			break;
+
+		case BatchOperation::Dump:
+			result.Message = DumpModel(options, fileName, editableModel);
+			break;
+
+		case BatchOperation::Resave:
+			result.Message = ResaveModel(options, fileName, editableModel);
+			break;
+
+		case BatchOperation::ExportTextures:
+			result.Message = ExportTextures(options, fileName, editableModel);
+			break;
+		}
+
+		result.Success = true;
+	}
+	catch (const std::exception& e)
+	{
+		result.Message = e.what();
+	}
+
+	result.Milliseconds = std::chrono::duration<double, std::milli>{Clock::now() - start}.count();
+
+	return result;
+}
+}
+
+std::optional<BatchOperation> BatchOperationFromString(std::string_view value)
+{
+	for (const auto operation : {BatchOperation::Validate, BatchOperation::Dump,
+		BatchOperation::Resave, BatchOperation::ExportTextures})
+	{
+		if (value == BatchOperationToString(operation))
+		{
+			return operation;
+		}
+	}
+
+	return {};
+}
+
+int RunBatch(const BatchOptions& options, FILE* output)
+{
+	const auto start = Clock::now();
+
+	std::vector<std::filesystem::path> fileNames;
+
+	try
+	{
+		fileNames = studiomdl::FindMainStudioModels(options.Directory);
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(output, "Error reading directory \"{}\": {}\n", options.Directory, e.what());
+		return EXIT_FAILURE;
+	}
+
+	fmt::print(output, "Running {} on {} models using {} threads\n",
+		BatchOperationToString(options.Operation), fileNames.size(), options.ThreadCount + 1);
+
+	std::vector<BatchFileResult> results(fileNames.size());
+
+	std::mutex outputMutex;
+	std::size_t completedCount = 0;
+
+	ThreadPool threadPool{options.ThreadCount};
+
+	// Indices are claimed one at a time, so threads that finish small models early pick up the remaining work.
+	threadPool.ParallelFor(fileNames.size(), [&](std::size_t index)
+		{
+			auto result = ProcessFile(options, fileNames[index]);
+
+			{
+				std::lock_guard lock{outputMutex};
+
+				++completedCount;
+
+				fmt::print(output, "[{}/{}] {} {:.1f} ms {}: {}\n", completedCount, fileNames.size(),
+					result.Success ? "OK" : "FAILED", result.Milliseconds, result.FileName, result.Message);
+				std::fflush(output);
+			}
+
+			results[index] = std::move(result);
+		});
+
+	const double totalSeconds = std::chrono::duration<double>{Clock::now() - start}.count();
+
+	const auto failedCount = static_cast<std::size_t>(std::count_if(
+		results.begin(), results.end(), [](const auto& result) { return !result.Success; }));
+
+	double fileMilliseconds = 0;
+
+	for (const auto& result : results)
+	{
+		fileMilliseconds += result.Milliseconds;
+	}
+
+	fmt::print(output, "\nProcessed {} models in {:.2f} s: {} succeeded, {} failed\n",
+		results.size(), totalSeconds, results.size() - failedCount, failedCount);
+
+	if (!results.empty())
+	{
+		fmt::print(output, "Average time per model: {:.1f} ms\n", fileMilliseconds / results.size());
+
+		std::vector<const BatchFileResult*> slowest;
+
+		for (const auto& result : results)
+		{
+			slowest.push_back(&result);
+		}
+
+		const auto slowestCount = std::min(SlowestFileCount, slowest.size());
+
+		std::partial_sort(slowest.begin(), slowest.begin() + slowestCount, slowest.end(),
+			[](const auto lhs, const auto rhs) { return lhs->Milliseconds > rhs->Milliseconds; });
+
+		fmt::print(output, "Slowest models:\n");
+
+		for (std::size_t i = 0; i < slowestCount; ++i)
+		{
+			fmt::print(output, "\t{:.1f} ms {}\n", slowest[i]->Milliseconds, slowest[i]->FileName);
+		}
+	}
+
+	if (failedCount > 0)
+	{
+		fmt::print(output, "\nFailed models:\n");
+
+		for (const auto& result : results)
+		{
+			if (!result.Success)
+			{
+				fmt::print(output, "\t{}: {}\n", result.FileName, result.Message);
+			}
+		}
+	}
+
+	return failedCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
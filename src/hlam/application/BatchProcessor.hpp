@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+/**
+*	@brief Operations that can be performed on models from the command line without opening the editor.
+*/
+enum class BatchOperation
+{
+	Validate = 0,
+	Dump,
+	Resave,
+	ExportTextures
+};
+
+std::optional<BatchOperation> BatchOperationFromString(std::string_view value);
+
+struct BatchOptions
+{
+	BatchOperation Operation{BatchOperation::Validate};
+
+	/**
+	*	@brief Directory to search for models, including subdirectories.
+	*/
+	std::filesystem::path Directory;
+
+	/**
+	*	@brief If not empty, files are written here, mirroring the layout of @ref Directory.
+	*	Otherwise files are written next to the model.
+	*/
+	std::filesystem::path OutputDirectory;
+
+	/**
+	*	@brief Whether resaved models should have their animation data re-encoded as compactly as possible.
+	*/
+	bool CompressAnimations{false};
+
+	/**
+	*	@brief Whether resaved models should have their meshes rebuilt into fewer, longer strips and fans.
+	*/
+	bool OptimizeMeshes{false};
+
+	/**
+	*	@brief Number of worker threads in addition to the calling thread.
+	*/
+	std::size_t ThreadCount{};
+};
+
+/**
+*	@brief Performs a batch operation on all models in a directory in parallel.
+*	Does not need a GUI application or OpenGL context.
+*	@param output Stream that receives per-file results and a summary.
+*	@return Program exit code.
+*/
+int RunBatch(const BatchOptions& options, FILE* output);
@@ -1,9 +1,14 @@
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
@@ -11,20 +16,25 @@
 #include <QLocale>
 #include <QLoggingCategory>
 #include <QMessageBox>
+#include <QMetaObject>
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
 #include <QSettings>
 #include <QSurfaceFormat>
 #include <QTextCodec>
 #include <QTextStream>
+#include <QThread>
+#include <QTimer>
 
 #include "application/AssetList.hpp"
+#include "application/BatchProcessor.hpp"
 #include "application/ToolApplication.hpp"
 
 #include "plugins/IAssetManagerPlugin.hpp"
 #include "plugins/forwarding/ForwardingAssetManagerPlugin.hpp"
 #include "plugins/halflife/HalfLifeAssetManagerPlugin.hpp"
 
+#include "qt/AsyncLogBackend.hpp"
 #include "qt/QtLogging.hpp"
 
 #include "settings/ApplicationSettings.hpp"
@@ -32,6 +42,12 @@
 #include "ui/AboutDialog.hpp"
 #include "ui/OpenGLGraphicsContext.hpp"
 
+#include "utility/ThreadPool.hpp"
+
+#ifdef WIN32
+#include <Windows.h>
+#endif
+
 const QString LogBaseFileName{QStringLiteral("HLAM-Log.txt")};
 
 QString LogDirectory;
@@ -47,6 +63,25 @@ static void SetLogFileName(const QString& logFileName)
 
 const QtMessageHandler DefaultMessageHandler = qInstallMessageHandler(nullptr);
 
+/**
+*	@brief Runs a function on the main thread.
+*	Messages are usually written on the log thread, which must not show message boxes or access the application.
+*/
+template<typename Function>
+static void RunOnMainThread(Function&& function)
+{
+	const auto application = QCoreApplication::instance();
+
+	if (!application || QThread::currentThread() == application->thread())
+	{
+		function();
+	}
+	else
+	{
+		QMetaObject::invokeMethod(application, std::forward<Function>(function), Qt::QueuedConnection);
+	}
+}
+
 void AssetManagerMessageOutput(QtMsgType type, const QMessageLogContext& context, const QString& msg)
 {
 	QDir{LogDirectory}.mkpath(".");
@@ -55,8 +90,17 @@ void AssetManagerMessageOutput(QtMsgType type, const QMessageLogContext& context
 
 	if (!logFile.open(QFile::WriteOnly | QFile::Append))
 	{
-		QMessageBox::critical(nullptr, "Error", QString{"Couldn't open file \"%1\" for writing log messages"}
-		.arg(QFileInfo{logFile}.absoluteFilePath()));
+		// Only report this once, otherwise every message would show another message box.
+		static std::atomic<bool> ReportedLogFileError{false};
+
+		if (!ReportedLogFileError.exchange(true))
+		{
+			RunOnMainThread([fileName = QFileInfo{logFile}.absoluteFilePath()]
+				{
+					QMessageBox::critical(nullptr, "Error",
+						QString{"Couldn't open file \"%1\" for writing log messages"}.arg(fileName));
+				});
+		}
 	}
 	else
 	{
@@ -91,10 +135,14 @@ void AssetManagerMessageOutput(QtMsgType type, const QMessageLogContext& context
 			<< msg << " (" << context.file << ":" << context.line << ", " << context.function << ")\n";
 	}
 
-	if (auto application = ToolApplication::GetApplication(); application)
-	{
-		emit application->LogMessageReceived(type, context, msg);
-	}
+	// The application is created and destroyed on the main thread, so it is only accessed there.
+	RunOnMainThread([type, category = QString::fromUtf8(context.category), msg]
+		{
+			if (auto application = ToolApplication::GetApplication(); application)
+			{
+				emit application->LogMessageReceived(type, category, msg);
+			}
+		});
 
 	//Let the default handler handle abort
 	/*
@@ -122,6 +170,12 @@ int ToolApplication::Run(int argc, char* argv[])
 		const QString programName{QStringLiteral("Half-Life Asset Manager")};
 
 		ConfigureApplication(programName);
+
+		if (IsBatchMode(argc, argv))
+		{
+			return RunBatch(argc, argv);
+		}
+
 		ConfigureOpenGL();
 
 		QApplication app(argc, argv);
@@ -130,17 +184,24 @@ int ToolApplication::Run(int argc, char* argv[])
 
 		connect(&app, &QApplication::aboutToQuit, this, &ToolApplication::OnExit);
 
-		const auto commandLine = ParseCommandLine(QCoreApplication::arguments());
+		_startupProfile.EndPhase("Create Qt application");
+
+		_commandLine = ParseCommandLine(QCoreApplication::arguments());
 
-		auto settings = CreateSettings(argv[0], programName, commandLine.IsPortable);
+		auto settings = CreateSettings(argv[0], programName, _commandLine.IsPortable);
 
 		_singleInstance = std::make_unique<SingleInstance>();
 
-		if (!_singleInstance->Create(programName, commandLine.FileName))
+		if (!_singleInstance->Create(programName, _commandLine.FileName))
 		{
 			return EXIT_SUCCESS;
 		}
 
+		_startupProfile.EndPhase("Check for running instance");
+
+		// Log messages can arrive from worker threads and the log thread, so they need to be queued to the main thread.
+		qRegisterMetaType<QtMsgType>("QtMsgType");
+
 		// Install the file logger after the single instance check to ensure only one instance writes to the log file.
 		SetLogFileName(QFileInfo{settings->fileName()}.absolutePath() + QDir::separator() + LogBaseFileName);
 
@@ -148,14 +209,21 @@ int ToolApplication::Run(int argc, char* argv[])
 
 		qInstallMessageHandler(&AssetManagerMessageOutput);
 
+		StartAsyncLogging(*settings);
+
 		LogAppInfo();
 
+		_startupProfile.EndPhase("Start logging");
+
 		CheckOpenGLVersion(programName, *settings);
 
+		_startupProfile.EndPhase("Check OpenGL version");
+
 		_application = CreateApplication(std::move(settings));
 
 		if (!_application)
 		{
+			AsyncLogBackend::SetInstance({});
 			return EXIT_FAILURE;
 		}
 
@@ -163,10 +231,10 @@ int ToolApplication::Run(int argc, char* argv[])
 
 		_application->Start();
 
-		if (!commandLine.FileName.isEmpty())
-		{
-			_application->LoadFile(commandLine.FileName);
-		}
+		_startupProfile.EndPhase("Create main window");
+
+		// Runs once pending events have been processed, which includes showing the main window.
+		QTimer::singleShot(0, this, &ToolApplication::OnStartupFinished);
 
 		return app.exec();
 	}
@@ -192,6 +260,11 @@ ParsedCommandLine ToolApplication::ParseCommandLine(const QStringList& arguments
 	QCommandLineParser parser;
 
 	parser.addOption(QCommandLineOption{"portable", "Launch in portable mode"});
+	parser.addOption(QCommandLineOption{"profile-startup", "Log the time taken by each phase of startup"});
+	// Handled by RunBatch; listed here so it shows up in the help text.
+	parser.addOption(QCommandLineOption{"batch",
+		"Run <operation> (validate, dump, resave, export-textures) on all models in a directory without opening the editor",
+		"operation"});
 	parser.addPositionalArgument("fileName", "Filename of the model to load on startup", "[fileName]");
 
 	parser.process(arguments);
@@ -199,6 +272,7 @@ ParsedCommandLine ToolApplication::ParseCommandLine(const QStringList& arguments
 	ParsedCommandLine result;
 
 	result.IsPortable = parser.isSet("portable");
+	result.ProfileStartup = parser.isSet("profile-startup");
 
 	const auto positionalArguments = parser.positionalArguments();
 
@@ -223,6 +297,96 @@ ParsedCommandLine ToolApplication::ParseCommandLine(const QStringList& arguments
 	return result;
 }
 
+bool ToolApplication::IsBatchMode(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--batch") == 0 || std::strncmp(argv[i], "--batch=", 8) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int ToolApplication::RunBatch(int argc, char* argv[])
+{
+#ifdef WIN32
+	// The program uses the GUI subsystem so output is only visible if we attach to the console that started us.
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+	{
+		std::freopen("CONOUT$", "w", stdout);
+		std::freopen("CONOUT$", "w", stderr);
+	}
+#endif
+
+	QCoreApplication app(argc, argv);
+
+	QCommandLineParser parser;
+
+	parser.setApplicationDescription("Processes all models in a directory and its subdirectories");
+	parser.addHelpOption();
+
+	parser.addOption(QCommandLineOption{"batch", "Operation to perform: validate, dump, resave or export-textures", "operation"});
+	parser.addOption(QCommandLineOption{"output",
+		"Directory to write files to. Defaults to writing files next to each model", "directory"});
+	parser.addOption(QCommandLineOption{"threads", "Number of threads to use. Defaults to the number of processors", "count"});
+	parser.addOption(QCommandLineOption{"compress-animations", "Re-encode animation data as compactly as possible when resaving"});
+	parser.addOption(QCommandLineOption{"optimize-meshes", "Rebuild meshes into fewer, longer triangle strips and fans when resaving"});
+	parser.addPositionalArgument("directory", "Directory containing the models to process");
+
+	parser.process(QCoreApplication::arguments());
+
+	const auto operation = BatchOperationFromString(parser.value("batch").toStdString());
+
+	if (!operation)
+	{
+		std::fprintf(stderr, "Unknown batch operation \"%s\"\n", qPrintable(parser.value("batch")));
+		return EXIT_FAILURE;
+	}
+
+	const auto positionalArguments = parser.positionalArguments();
+
+	if (positionalArguments.size() != 1)
+	{
+		std::fprintf(stderr, "Expected exactly one directory\n");
+		return EXIT_FAILURE;
+	}
+
+	BatchOptions options;
+
+	options.Operation = *operation;
+	options.Directory = std::filesystem::u8path(positionalArguments[0].toStdString());
+
+	if (parser.isSet("output"))
+	{
+		options.OutputDirectory = std::filesystem::u8path(parser.value("output").toStdString());
+	}
+
+	options.CompressAnimations = parser.isSet("compress-animations");
+	options.OptimizeMeshes = parser.isSet("optimize-meshes");
+
+	// The calling thread also processes files, so one fewer worker is needed.
+	options.ThreadCount = ThreadPool::GetDefaultThreadCount(1, 256);
+
+	if (parser.isSet("threads"))
+	{
+		bool ok = false;
+		const int threadCount = parser.value("threads").toInt(&ok);
+
+		if (!ok || threadCount < 1)
+		{
+			std::fprintf(stderr, "Invalid thread count \"%s\"\n", qPrintable(parser.value("threads")));
+			return EXIT_FAILURE;
+		}
+
+		options.ThreadCount = static_cast<std::size_t>(threadCount - 1);
+	}
+
+	return ::RunBatch(options, stdout);
+}
+
 std::unique_ptr<QSettings> ToolApplication::CreateSettings(
 	const QString& applicationFileName, const QString& programName, bool isPortable)
 {
@@ -238,6 +402,31 @@ std::unique_ptr<QSettings> ToolApplication::CreateSettings(
 	}
 }
 
+void ToolApplication::StartAsyncLogging(QSettings& settings)
+{
+	settings.beginGroup("Logging");
+
+	const int queueDepth = settings.value("AsyncQueueDepth", static_cast<int>(AsyncLogOptions::DefaultQueueDepth)).toInt();
+	const QString overflowPolicy = settings.value("OverflowPolicy", QStringLiteral("Drop")).toString();
+
+	settings.endGroup();
+
+	// A depth of 0 writes messages on the thread that logs them, which can help when debugging crashes.
+	if (queueDepth <= 0)
+	{
+		return;
+	}
+
+	AsyncLogOptions options;
+
+	options.QueueDepth = static_cast<std::size_t>(queueDepth);
+	options.OverflowPolicy = overflowPolicy.compare(QStringLiteral("Block"), Qt::CaseInsensitive) == 0
+		? LogOverflowPolicy::Block
+		: LogOverflowPolicy::Drop;
+
+	AsyncLogBackend::SetInstance(std::make_shared<AsyncLogBackend>(options));
+}
+
 void ToolApplication::ConfigureOpenGL()
 {
 	//Neither OpenGL ES nor Software OpenGL will work here
@@ -339,11 +528,15 @@ std::unique_ptr<AssetManager> ToolApplication::CreateApplication(std::unique_ptr
 		return {};
 	}
 
+	_startupProfile.EndPhase("Create OpenGL context");
+
 	const auto applicationSettings = std::make_shared<ApplicationSettings>(
 		settings.release(), CreateQtLoggerSt(HLAMFileSystem()));
 
 	auto application = std::make_unique<AssetManager>(_guiApplication, applicationSettings, std::move(graphicsContext));
 
+	_startupProfile.EndPhase("Create asset manager");
+
 	{
 		bool success = true;
 
@@ -356,15 +549,64 @@ std::unique_ptr<AssetManager> ToolApplication::CreateApplication(std::unique_ptr
 		}
 	}
 
+	_startupProfile.EndPhase("Initialize plugins");
+
 	applicationSettings->LoadSettings();
 
+	_startupProfile.EndPhase("Load settings");
+
 	return application;
 }
 
+void ToolApplication::LogStartupProfile()
+{
+	const auto logPhase = [this](const QString& message)
+	{
+		if (_commandLine.ProfileStartup)
+		{
+			qCInfo(HLAM).noquote() << message;
+		}
+		else
+		{
+			qCDebug(HLAM).noquote() << message;
+		}
+	};
+
+	for (const auto& phase : _startupProfile.GetPhases())
+	{
+		logPhase(QString{"Startup phase \"%1\": %2 ms"}
+			.arg(QString::fromStdString(phase.Name))
+			.arg(phase.Duration, 0, 'f', 1));
+	}
+
+	logPhase(QString{"Startup took %1 ms"}.arg(_startupProfile.GetTotalTime(), 0, 'f', 1));
+}
+
+void ToolApplication::OnStartupFinished()
+{
+	_startupProfile.EndPhase("Show main window");
+
+	_application->InitializeSoundSystem();
+
+	_startupProfile.EndPhase("Initialize sound system");
+
+	if (!_commandLine.FileName.isEmpty())
+	{
+		_application->LoadFile(_commandLine.FileName);
+
+		_startupProfile.EndPhase("Load file");
+	}
+
+	LogStartupProfile();
+}
+
 void ToolApplication::OnExit()
 {
 	_application->OnExit();
 
 	_application.reset();
 	_singleInstance.reset();
+
+	// The backend writes any remaining messages once the last logger using it has been destroyed.
+	AsyncLogBackend::SetInstance({});
 }
@@ -8,6 +8,8 @@
 #include "application/AssetManager.hpp"
 #include "application/SingleInstance.hpp"
 
+#include "utility/StartupProfile.hpp"
+
 class QApplication;
 class QSettings;
 class QStringList;
@@ -20,6 +22,7 @@ class IGraphicsContext;
 struct ParsedCommandLine
 {
 	bool IsPortable{false};
+	bool ProfileStartup{false};
 	QString FileName;
 };
 
@@ -37,6 +40,16 @@ public:
 	int Run(int argc, char* argv[]);
 
 private:
+	/**
+	*	@brief Checks whether the program was started in batch mode, before any Qt application object exists.
+	*/
+	static bool IsBatchMode(int argc, char* argv[]);
+
+	/**
+	*	@brief Runs a batch operation without creating any windows or OpenGL contexts.
+	*/
+	int RunBatch(int argc, char* argv[]);
+
 	void ConfigureApplication(const QString& programName);
 	
 	ParsedCommandLine ParseCommandLine(const QStringList& arguments);
@@ -44,6 +57,12 @@ private:
 	std::unique_ptr<QSettings> CreateSettings(
 		const QString& applicationFileName, const QString& programName, bool isPortable);
 
+	/**
+	*	@brief Moves writing of log messages to a separate thread unless disabled in the settings.
+	*	Must be called before any loggers are created.
+	*/
+	void StartAsyncLogging(QSettings& settings);
+
 	void ConfigureOpenGL();
 
 	void CheckOpenGLVersion(const QString& programName, QSettings& settings);
@@ -52,7 +71,19 @@ private:
 
 	std::unique_ptr<AssetManager> CreateApplication(std::unique_ptr<QSettings> settings);
 
+	/**
+	*	@brief Logs the time taken by each startup phase.
+	*	Phases are logged as debug messages unless startup profiling was requested on the command line.
+	*/
+	void LogStartupProfile();
+
 private slots:
+	/**
+	*	@brief Called once the event loop is running and the main window has been shown.
+	*	Performs work that isn't needed to show the main window.
+	*/
+	void OnStartupFinished();
+
 	void OnExit();
 
 private:
@@ -61,4 +92,7 @@ private:
 	static inline std::unique_ptr<AssetManager> _application;
 
 	std::unique_ptr<SingleInstance> _singleInstance;
+
+	StartupProfile _startupProfile;
+	ParsedCommandLine _commandLine;
 };
@@ -0,0 +1,188 @@
+#include <utility>
+
+#include <QTemporaryFile>
+
+#include "application/UndoDataStore.hpp"
+
+UndoData::UndoData(std::shared_ptr<UndoDataStore> store, std::uint64_t id)
+	: _store(std::move(store))
+	, _id(id)
+{
+}
+
+UndoData::~UndoData()
+{
+	Discard();
+}
+
+UndoData::UndoData(UndoData&& other) noexcept
+	: _store(std::move(other._store))
+	, _id(std::exchange(other._id, 0))
+{
+}
+
+UndoData& UndoData::operator=(UndoData&& other) noexcept
+{
+	if (this != &other)
+	{
+		Discard();
+		_store = std::move(other._store);
+		_id = std::exchange(other._id, 0);
+	}
+
+	return *this;
+}
+
+QByteArray UndoData::Load() const
+{
+	assert(_store);
+	return _store->Load(_id);
+}
+
+void UndoData::Discard()
+{
+	if (_store)
+	{
+		_store->Release(_id);
+		_store.reset();
+		_id = 0;
+	}
+}
+
+UndoDataStore::UndoDataStore() = default;
+UndoDataStore::~UndoDataStore() = default;
+
+void UndoDataStore::SetMemoryBudget(qint64 value)
+{
+	if (_memoryBudget != value)
+	{
+		_memoryBudget = value;
+		SpillToFile();
+	}
+}
+
+UndoData UndoDataStore::Store(const QByteArray& data)
+{
+	Entry entry;
+	entry.Data = qCompress(data);
+	entry.Size = entry.Data.size();
+
+	const auto id = _nextId++;
+
+	_memoryUsage += entry.Size;
+	_entries.emplace(id, std::move(entry));
+
+	SpillToFile();
+
+	return UndoData{shared_from_this(), id};
+}
+
+QByteArray UndoDataStore::Load(std::uint64_t id) const
+{
+	const auto it = _entries.find(id);
+
+	assert(it != _entries.end());
+
+	if (it == _entries.end())
+	{
+		return {};
+	}
+
+	const auto& entry = it->second;
+
+	if (entry.FileOffset == -1)
+	{
+		return qUncompress(entry.Data);
+	}
+
+	if (!_file->seek(entry.FileOffset))
+	{
+		return {};
+	}
+
+	const auto compressed = _file->read(entry.Size);
+
+	if (compressed.size() != entry.Size)
+	{
+		return {};
+	}
+
+	return qUncompress(compressed);
+}
+
+void UndoDataStore::Release(std::uint64_t id)
+{
+	const auto it = _entries.find(id);
+
+	if (it == _entries.end())
+	{
+		return;
+	}
+
+	if (it->second.FileOffset != -1)
+	{
+		_fileUsage -= it->second.Size;
+
+		// The file is only appended to, so space is reclaimed once nothing in it is used anymore.
+		if (_fileUsage == 0)
+		{
+			_file->resize(0);
+		}
+	}
+	else
+	{
+		_memoryUsage -= it->second.Size;
+	}
+
+	_entries.erase(it);
+}
+
+void UndoDataStore::SpillToFile()
+{
+	if (_memoryUsage <= _memoryBudget)
+	{
+		return;
+	}
+
+	if (!_file)
+	{
+		_file = std::make_unique<QTemporaryFile>();
+
+		if (!_file->open())
+		{
+			_file.reset();
+		}
+	}
+
+	if (!_file)
+	{
+		return;
+	}
+
+	// Entries are ordered by age, so the oldest data is moved first.
+	for (auto& [id, entry] : _entries)
+	{
+		if (_memoryUsage <= _memoryBudget)
+		{
+			break;
+		}
+
+		if (entry.FileOffset != -1)
+		{
+			continue;
+		}
+
+		const qint64 offset = _file->size();
+
+		if (!_file->seek(offset) || _file->write(entry.Data) != entry.Size)
+		{
+			break;
+		}
+
+		entry.FileOffset = offset;
+		entry.Data = QByteArray{};
+
+		_memoryUsage -= entry.Size;
+		_fileUsage += entry.Size;
+	}
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <QByteArray>
+
+class QTemporaryFile;
+class UndoDataStore;
+
+/**
+*	@brief Handle to a block of data kept in an UndoDataStore.
+*	The data is released when the handle is destroyed or discarded.
+*/
+class UndoData final
+{
+public:
+	UndoData() = default;
+	UndoData(std::shared_ptr<UndoDataStore> store, std::uint64_t id);
+	~UndoData();
+
+	UndoData(const UndoData&) = delete;
+	UndoData& operator=(const UndoData&) = delete;
+
+	UndoData(UndoData&& other) noexcept;
+	UndoData& operator=(UndoData&& other) noexcept;
+
+	bool IsValid() const { return _store != nullptr; }
+
+	/**
+	*	@brief Gets the uncompressed data. Must not be called on a discarded handle.
+	*	@return The data, or an empty array if it could not be loaded.
+	*/
+	QByteArray Load() const;
+
+	/**
+	*	@brief Releases the data. The handle is no longer valid afterwards.
+	*/
+	void Discard();
+
+private:
+	std::shared_ptr<UndoDataStore> _store;
+	std::uint64_t _id{};
+};
+
+/**
+*	@brief Compressed storage for data kept alive by undo commands.
+*	Data is compressed when it is stored. Once the compressed data exceeds the memory budget
+*	the oldest data is moved to a temporary file.
+*	Handles keep the store alive, so commands can outlive the asset that created them.
+*/
+class UndoDataStore final : public std::enable_shared_from_this<UndoDataStore>
+{
+public:
+	UndoDataStore();
+	~UndoDataStore();
+
+	UndoDataStore(const UndoDataStore&) = delete;
+	UndoDataStore& operator=(const UndoDataStore&) = delete;
+
+	/**
+	*	@brief Sets the number of bytes of compressed data to keep in memory before moving data to the temporary file.
+	*/
+	void SetMemoryBudget(qint64 value);
+
+	/**
+	*	@brief Sets the number of bytes of compressed data that can be stored in total before history should be trimmed.
+	*	0 means there is no limit.
+	*/
+	void SetHistoryLimit(qint64 value)
+	{
+		_historyLimit = value;
+	}
+
+	qint64 GetMemoryUsage() const { return _memoryUsage; }
+
+	qint64 GetFileUsage() const { return _fileUsage; }
+
+	bool IsOverHistoryLimit() const
+	{
+		return _historyLimit > 0 && (_memoryUsage + _fileUsage) > _historyLimit;
+	}
+
+	UndoData Store(const QByteArray& data);
+
+	QByteArray Load(std::uint64_t id) const;
+
+	void Release(std::uint64_t id);
+
+private:
+	struct Entry
+	{
+		QByteArray Data;
+
+		/**
+		*	@brief Offset of the data in the temporary file, or -1 if the data is in memory.
+		*/
+		qint64 FileOffset{-1};
+		qint64 Size{};
+	};
+
+	/**
+	*	@brief Moves the oldest entries to the temporary file until the memory budget is no longer exceeded.
+	*	Entries stay in memory if the file can't be written.
+	*/
+	void SpillToFile();
+
+private:
+	std::map<std::uint64_t, Entry> _entries;
+	std::uint64_t _nextId{1};
+
+	std::unique_ptr<QTemporaryFile> _file;
+
+	qint64 _memoryBudget{};
+	qint64 _historyLimit{};
+
+	qint64 _memoryUsage{};
+	qint64 _fileUsage{};
+};
+
+/**
+*	@brief Builds the data for an UndoData block out of plain values and arrays of plain values.
+*/
+class UndoDataWriter final
+{
+public:
+	template<typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copy_constructible_v<T> && std::is_trivially_destructible_v<T>);
+		_data.append(reinterpret_cast<const char*>(&value), static_cast<int>(sizeof(T)));
+	}
+
+	template<typename T>
+	void WriteVector(const std::vector<T>& values)
+	{
+		static_assert(std::is_trivially_copy_constructible_v<T> && std::is_trivially_destructible_v<T>);
+		Write(static_cast<std::uint64_t>(values.size()));
+		_data.append(reinterpret_cast<const char*>(values.data()), static_cast<int>(values.size() * sizeof(T)));
+	}
+
+	const QByteArray& GetData() const { return _data; }
+
+private:
+	QByteArray _data;
+};
+
+/**
+*	@brief Reads values written by UndoDataWriter, in the same order.
+*	Reading past the end of the data puts the reader in a failed state in which all reads return empty values.
+*	Check IsValid after reading everything before using the values.
+*/
+class UndoDataReader final
+{
+public:
+	explicit UndoDataReader(QByteArray&& data)
+		: _data(std::move(data))
+		, _failed(_data.isEmpty())
+	{
+	}
+
+	/**
+	*	@brief Whether all reads so far were within the bounds of the data.
+	*	Empty data is never valid, since UndoDataStore::Load returns it when loading fails.
+	*/
+	bool IsValid() const { return !_failed; }
+
+	template<typename T>
+	T Read()
+	{
+		static_assert(std::is_trivially_copy_constructible_v<T> && std::is_trivially_destructible_v<T>);
+
+		if (!CanRead(1, sizeof(T)))
+		{
+			return T{};
+		}
+
+		T value;
+		std::memcpy(&value, _data.constData() + _offset, sizeof(T));
+		_offset += sizeof(T);
+		return value;
+	}
+
+	template<typename T>
+	std::vector<T> ReadVector()
+	{
+		const auto count = Read<std::uint64_t>();
+
+		if (!CanRead(count, sizeof(T)))
+		{
+			return {};
+		}
+
+		std::vector<T> values(static_cast<std::size_t>(count));
+
+		if (count > 0)
+		{
+			std::memcpy(values.data(), _data.constData() + _offset, values.size() * sizeof(T));
+			_offset += values.size() * sizeof(T);
+		}
+
+		return values;
+	}
+
+private:
+	bool CanRead(std::uint64_t count, std::size_t size)
+	{
+		if (_failed)
+		{
+			return false;
+		}
+
+		const auto remaining = static_cast<std::size_t>(_data.size()) - _offset;
+
+		// Compare by dividing so corrupt counts can't overflow.
+		if (size > 0 && count > (remaining / size))
+		{
+			_failed = true;
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	const QByteArray _data;
+	std::size_t _offset{};
+	bool _failed{};
+};
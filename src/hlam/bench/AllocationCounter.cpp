@@ -0,0 +1,166 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "bench/AllocationCounter.hpp"
+
+namespace
+{
+std::atomic<std::uint64_t> AllocationCount{0};
+std::atomic<std::uint64_t> AllocatedBytes{0};
+
+void* CountedAllocate(std::size_t size) noexcept
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	// malloc(0) may return null, which would look like a failed allocation.
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void* CountedAllocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	const auto alignmentInBytes = static_cast<std::size_t>(alignment);
+
+	// aligned_alloc requires the size to be a multiple of the alignment.
+	size = ((size + alignmentInBytes - 1) / alignmentInBytes) * alignmentInBytes;
+
+#ifdef _WIN32
+	return _aligned_malloc(size > 0 ? size : alignmentInBytes, alignmentInBytes);
+#else
+	return std::aligned_alloc(alignmentInBytes, size > 0 ? size : alignmentInBytes);
+#endif
+}
+
+void FreeAligned(void* pointer) noexcept
+{
+#ifdef _WIN32
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+}
+
+AllocationCounts GetAllocationCounts()
+{
+	return {AllocationCount.load(std::memory_order_relaxed), AllocatedBytes.load(std::memory_order_relaxed)};
+}
+
+AllocationCounts operator-(const AllocationCounts& lhs, const AllocationCounts& rhs)
+{
+	return {lhs.Allocations - rhs.Allocations, lhs.Bytes - rhs.Bytes};
+}
+
+void* operator new(std::size_t size)
+{
+	if (auto pointer = CountedAllocate(size); pointer)
+	{
+		return pointer;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (auto pointer = CountedAllocateAligned(size, alignment); pointer)
+	{
+		return pointer;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pointer);
+}
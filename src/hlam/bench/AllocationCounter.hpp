@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+*	@brief Number of heap allocations made through the global operator new.
+*	Only available in hlam_bench, which replaces the global allocation functions.
+*/
+struct AllocationCounts
+{
+	std::uint64_t Allocations{};
+	std::uint64_t Bytes{};
+};
+
+AllocationCounts GetAllocationCounts();
+
+AllocationCounts operator-(const AllocationCounts& lhs, const AllocationCounts& rhs);
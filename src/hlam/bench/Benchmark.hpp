@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "bench/AllocationCounter.hpp"
+
+/**
+*	@brief Timing and allocation results for a single benchmark.
+*/
+struct BenchmarkResult
+{
+	std::string Name;
+
+	std::size_t Iterations{};
+
+	/**
+	*	@brief Number of items processed by each iteration, in units of @ref ItemName.
+	*/
+	std::uint64_t ItemsPerIteration{};
+	std::string ItemName;
+
+	double TotalSeconds{};
+	double FastestSeconds{};
+
+	AllocationCounts Allocations;
+
+	double GetMeanSeconds() const
+	{
+		return Iterations > 0 ? TotalSeconds / Iterations : 0;
+	}
+
+	/**
+	*	@brief Items processed per second, based on the mean iteration time.
+	*/
+	double GetThroughput() const
+	{
+		const double mean = GetMeanSeconds();
+		return mean > 0 ? ItemsPerIteration / mean : 0;
+	}
+};
+
+/**
+*	@brief Runs @p function @p iterations times and measures the time and allocations of each run.
+*	@param function Callable that returns the number of items it processed.
+*/
+template<typename Function>
+BenchmarkResult RunBenchmark(std::string name, std::string itemName, std::size_t iterations, Function&& function)
+{
+	using Clock = std::chrono::steady_clock;
+
+	BenchmarkResult result;
+
+	result.Name = std::move(name);
+	result.ItemName = std::move(itemName);
+	result.Iterations = iterations;
+	result.FastestSeconds = iterations > 0 ? std::numeric_limits<double>::max() : 0;
+
+	const auto allocationsBefore = GetAllocationCounts();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		const auto start = Clock::now();
+
+		result.ItemsPerIteration = function();
+
+		const double seconds = std::chrono::duration<double>{Clock::now() - start}.count();
+
+		result.TotalSeconds += seconds;
+		result.FastestSeconds = std::min(result.FastestSeconds, seconds);
+	}
+
+	result.Allocations = GetAllocationCounts() - allocationsBefore;
+
+	return result;
+}
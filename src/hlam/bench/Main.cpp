@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "bench/MathBenchmarks.hpp"
+#include "bench/ModelBenchmarks.hpp"
+
+#include "formats/studiomodel/StudioModelIO.hpp"
+
+#include "utility/IOUtils.hpp"
+#include "utility/SIMDMath.hpp"
+
+/**
+*	@file
+*
+*	Measures the performance of the Qt-free core code over a directory of models.
+*	Results are written as JSON so runs can be compared by scripts.
+*/
+
+namespace
+{
+constexpr std::size_t DefaultIterationCount = 10;
+
+void PrintUsage()
+{
+	fmt::print(stderr,
+		"Usage: hlam_bench <corpus directory> [--iterations <count>] [--output <file>] [--no-math]\n"
+		"Benchmarks every studio model in the corpus directory and its subdirectories\n"
+		"and validates the conversions done while saving them.\n");
+}
+
+std::string EscapeJson(std::string_view text)
+{
+	std::string result;
+	result.reserve(text.size());
+
+	for (const char c : text)
+	{
+		switch (c)
+		{
+		case '"': result += "\\\""; break;
+		case '\\': result += "\\\\"; break;
+		case '\n': result += "\\n"; break;
+		case '\r': result += "\\r"; break;
+		case '\t': result += "\\t"; break;
+
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				result += fmt::format("\\u{:04x}", static_cast<unsigned int>(c));
+			}
+			else
+			{
+				result += c;
+			}
+			break;
+		}
+	}
+
+	return result;
+}
+
+std::string FormatNumber(double value)
+{
+	// JSON has no representation for infinity or NaN.
+	return std::isfinite(value) ? fmt::format("{}", value) : std::string{"null"};
+}
+
+std::string PathToString(const std::filesystem::path& path)
+{
+	return reinterpret_cast<const char*>(path.u8string().c_str());
+}
+
+void WriteResult(FILE* file, const BenchmarkResult& result, std::string_view indent, bool last)
+{
+	const double iterations = static_cast<double>(std::max<std::size_t>(result.Iterations, 1));
+
+	fmt::print(file,
+		"{0}{{\"name\": \"{1}\", \"iterations\": {2}, \"items_per_iteration\": {3}, \"item_name\": \"{4}\", "
+		"\"mean_seconds\": {5}, \"fastest_seconds\": {6}, \"items_per_second\": {7}, "
+		"\"allocations_per_iteration\": {8}, \"allocated_bytes_per_iteration\": {9}}}{10}\n",
+		indent,
+		EscapeJson(result.Name),
+		result.Iterations,
+		result.ItemsPerIteration,
+		EscapeJson(result.ItemName),
+		FormatNumber(result.GetMeanSeconds()),
+		FormatNumber(result.FastestSeconds),
+		FormatNumber(result.GetThroughput()),
+		FormatNumber(result.Allocations.Allocations / iterations),
+		FormatNumber(result.Allocations.Bytes / iterations),
+		last ? "" : ",");
+}
+
+void WriteResults(FILE* file, const std::vector<BenchmarkResult>& results, std::string_view indent)
+{
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		WriteResult(file, results[i], indent, i + 1 == results.size());
+	}
+}
+
+void WriteValidations(FILE* file, const std::vector<ValidationResult>& validations, std::string_view indent)
+{
+	for (std::size_t i = 0; i < validations.size(); ++i)
+	{
+		const auto& validation = validations[i];
+
+		fmt::print(file, "{}{{\"name\": \"{}\", \"passed\": {}, \"error\": {}}}{}\n",
+			indent,
+			EscapeJson(validation.Name),
+			validation.Error.empty(),
+			validation.Error.empty() ? std::string{"null"} : fmt::format("\"{}\"", EscapeJson(validation.Error)),
+			i + 1 == validations.size() ? "" : ",");
+	}
+}
+}
+
+int main(int argc, char* argv[])
+{
+	std::filesystem::path corpusDirectory;
+	std::filesystem::path outputFileName;
+	std::size_t iterations = DefaultIterationCount;
+	bool benchmarkMath = true;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view argument{argv[i]};
+
+		if (argument == "--iterations" && (i + 1) < argc)
+		{
+			const std::string_view value{argv[++i]};
+
+			if (const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), iterations);
+				error != std::errc{} || end != value.data() + value.size() || iterations == 0)
+			{
+				fmt::print(stderr, "Invalid iteration count \"{}\"\n", value);
+				return 1;
+			}
+		}
+		else if (argument == "--output" && (i + 1) < argc)
+		{
+			outputFileName = std::filesystem::u8path(argv[++i]);
+		}
+		else if (argument == "--no-math")
+		{
+			benchmarkMath = false;
+		}
+		else if (argument.starts_with("--") || !corpusDirectory.empty())
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			corpusDirectory = std::filesystem::u8path(argument);
+		}
+	}
+
+	if (corpusDirectory.empty())
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<std::filesystem::path> fileNames;
+
+	try
+	{
+		fileNames = studiomdl::FindMainStudioModels(corpusDirectory);
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(stderr, "Error reading corpus directory \"{}\": {}\n", PathToString(corpusDirectory), e.what());
+		return 1;
+	}
+
+	FilePtr outputFile;
+
+	if (!outputFileName.empty())
+	{
+		outputFile.reset(utf8_fopen(outputFileName.u8string().c_str(), "w"));
+
+		if (!outputFile)
+		{
+			fmt::print(stderr, "Could not open output file \"{}\"\n", PathToString(outputFileName));
+			return 1;
+		}
+	}
+
+	FILE* const output = outputFile ? outputFile.get() : stdout;
+
+	fmt::print(output, "{{\n  \"iterations\": {},\n  \"simd\": \"{}\",\n", iterations, HLAM_SIMD_SSE2 ? "SSE2" : "scalar");
+
+	if (benchmarkMath)
+	{
+		fmt::print(stderr, "Benchmarking math\n");
+
+		const auto report = BenchmarkMath(iterations);
+
+		fmt::print(output,
+			"  \"math\": {{\n    \"slerp_matches_glm\": {},\n    \"matrices_match_glm\": {},\n    \"bounds_match_glm\": {},\n"
+			"    \"results\": [\n",
+			report.SlerpMatchesGlm, report.MatricesMatchGlm, report.BoundsMatchGlm);
+		WriteResults(output, report.Results, "      ");
+		fmt::print(output, "    ]\n  }},\n");
+	}
+
+	fmt::print(output, "  \"models\": [\n");
+
+	std::size_t failedCount = 0;
+
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		fmt::print(stderr, "[{}/{}] {}\n", i + 1, fileNames.size(), PathToString(fileNames[i]));
+
+		const auto report = BenchmarkModel(fileNames[i], iterations);
+
+		fmt::print(output, "    {{\n      \"file\": \"{}\",\n", EscapeJson(PathToString(report.FileName)));
+
+		bool failed = false;
+
+		if (report.Error.empty())
+		{
+			fmt::print(output, "      \"error\": null,\n");
+		}
+		else
+		{
+			failed = true;
+			fmt::print(stderr, "Error: {}\n", report.Error);
+			fmt::print(output, "      \"error\": \"{}\",\n", EscapeJson(report.Error));
+		}
+
+		for (const auto& validation : report.Validations)
+		{
+			if (!validation.Error.empty())
+			{
+				failed = true;
+				fmt::print(stderr, "Validation {} failed: {}\n", validation.Name, validation.Error);
+			}
+		}
+
+		if (failed)
+		{
+			++failedCount;
+		}
+
+		fmt::print(output, "      \"results\": [\n");
+		WriteResults(output, report.Results, "        ");
+		fmt::print(output, "      ],\n      \"sequences\": [\n");
+		WriteResults(output, report.Sequences, "        ");
+		fmt::print(output, "      ],\n      \"validations\": [\n");
+		WriteValidations(output, report.Validations, "        ");
+		fmt::print(output, "      ]\n    }}{}\n", (i + 1) == fileNames.size() ? "" : ",");
+	}
+
+	fmt::print(output, "  ]\n}}\n");
+
+	fmt::print(stderr, "Benchmarked {} models, {} failed\n", fileNames.size(), failedCount);
+
+	return failedCount > 0 ? 2 : 0;
+}
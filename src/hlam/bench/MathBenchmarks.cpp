@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include "bench/MathBenchmarks.hpp"
+
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+
+#include "utility/SIMDMath.hpp"
+
+namespace
+{
+constexpr std::size_t ElementCount = MAXSTUDIOBONES;
+
+/**
+*	@brief Number of times each operation is repeated per iteration, so iterations take long enough to measure.
+*/
+constexpr std::size_t RepeatCount = 1000;
+
+constexpr float SlerpFraction = 0.35f;
+
+/**
+*	@brief Results are written here so the compiler can't remove the benchmarked code.
+*/
+volatile float Sink = 0;
+
+struct alignas(16) QuaternionData
+{
+	alignas(16) std::array<float, ElementCount> X;
+	alignas(16) std::array<float, ElementCount> Y;
+	alignas(16) std::array<float, ElementCount> Z;
+	alignas(16) std::array<float, ElementCount> W;
+
+	QuaternionArrays Get() { return {X.data(), Y.data(), Z.data(), W.data()}; }
+	ConstQuaternionArrays Get() const { return {X.data(), Y.data(), Z.data(), W.data()}; }
+
+	void Set(std::size_t index, const glm::quat& quaternion)
+	{
+		X[index] = quaternion.x;
+		Y[index] = quaternion.y;
+		Z[index] = quaternion.z;
+		W[index] = quaternion.w;
+	}
+
+	glm::quat Get(std::size_t index) const
+	{
+		return glm::quat{W[index], X[index], Y[index], Z[index]};
+	}
+};
+
+struct alignas(16) VectorData
+{
+	alignas(16) std::array<float, ElementCount> X;
+	alignas(16) std::array<float, ElementCount> Y;
+	alignas(16) std::array<float, ElementCount> Z;
+
+	ConstVector3Arrays Get() const { return {X.data(), Y.data(), Z.data()}; }
+};
+
+/**
+*	@brief Random but reproducible bone data.
+*/
+struct MathInputs
+{
+	std::array<glm::quat, ElementCount> From;
+	std::array<glm::quat, ElementCount> To;
+	std::array<glm::vec3, ElementCount> Positions;
+
+	QuaternionData FromArrays;
+	QuaternionData ToArrays;
+	VectorData PositionArrays;
+
+	MathInputs()
+	{
+		std::mt19937 random{12345};
+		std::uniform_real_distribution<float> unit{-1.f, 1.f};
+		std::uniform_real_distribution<float> position{-100.f, 100.f};
+
+		for (std::size_t i = 0; i < ElementCount; ++i)
+		{
+			From[i] = glm::normalize(glm::quat{unit(random), unit(random), unit(random), unit(random)});
+			To[i] = glm::normalize(glm::quat{unit(random), unit(random), unit(random), unit(random)});
+			Positions[i] = glm::vec3{position(random), position(random), position(random)};
+
+			FromArrays.Set(i, From[i]);
+			ToArrays.Set(i, To[i]);
+			PositionArrays.X[i] = Positions[i].x;
+			PositionArrays.Y[i] = Positions[i].y;
+			PositionArrays.Z[i] = Positions[i].z;
+		}
+	}
+};
+
+void SlerpGlm(std::array<glm::quat, ElementCount>& to, const std::array<glm::quat, ElementCount>& from)
+{
+	for (std::size_t i = 0; i < ElementCount; ++i)
+	{
+		to[i] = glm::slerp(to[i], from[i], SlerpFraction);
+	}
+}
+
+void MatricesGlm(const std::array<glm::quat, ElementCount>& rotations,
+	const std::array<glm::vec3, ElementCount>& positions, std::array<glm::mat4x4, ElementCount>& matrices)
+{
+	for (std::size_t i = 0; i < ElementCount; ++i)
+	{
+		matrices[i] = glm::translate(positions[i]) * glm::toMat4(rotations[i]);
+	}
+}
+
+void ExpandBoundsGlm(const glm::mat4x4& matrix, const std::array<glm::vec3, ElementCount>& points,
+	std::size_t first, std::size_t count, glm::vec3& mins, glm::vec3& maxs)
+{
+	for (std::size_t i = first; i < first + count; ++i)
+	{
+		const glm::vec3 point{matrix * glm::vec4{points[i], 1}};
+
+		mins = glm::vec3{std::min(mins.x, point.x), std::min(mins.y, point.y), std::min(mins.z, point.z)};
+		maxs = glm::vec3{std::max(maxs.x, point.x), std::max(maxs.y, point.y), std::max(maxs.z, point.z)};
+	}
+}
+
+/**
+*	@brief Compares ExpandBoundsByTransformedPoints against glm for counts that cover the SIMD groups of 4 and the scalar tail,
+*	with points that are not aligned and with bounds that already contain points.
+*/
+bool BoundsMatchGlm(const MathInputs& inputs, const glm::mat4x4& matrix)
+{
+	constexpr std::array<std::size_t, 9> Counts{0, 1, 3, 4, 5, 7, 8, ElementCount - 1, ElementCount};
+
+	constexpr float Largest = std::numeric_limits<float>::max();
+
+	for (const std::size_t count : Counts)
+	{
+		for (std::size_t first = 0; first < 2 && first + count <= ElementCount; ++first)
+		{
+			const auto& arrays = inputs.PositionArrays;
+			const ConstVector3Arrays points{arrays.X.data() + first, arrays.Y.data() + first, arrays.Z.data() + first};
+
+			glm::vec3 glmMins{Largest};
+			glm::vec3 glmMaxs{-Largest};
+			ExpandBoundsGlm(matrix, inputs.Positions, first, count, glmMins, glmMaxs);
+
+			glm::vec3 simdMins{Largest};
+			glm::vec3 simdMaxs{-Largest};
+			ExpandBoundsByTransformedPoints(matrix, points, count, simdMins, simdMaxs);
+
+			if (simdMins != glmMins || simdMaxs != glmMaxs)
+			{
+				return false;
+			}
+
+			// Start from bounds that already contain points, so the results have to be merged with them.
+			glm::vec3 grownMins{-1, 0, 1};
+			glm::vec3 grownMaxs{2, 3, 4};
+			glmMins = grownMins;
+			glmMaxs = grownMaxs;
+
+			ExpandBoundsGlm(matrix, inputs.Positions, first, count, glmMins, glmMaxs);
+			ExpandBoundsByTransformedPoints(matrix, points, count, grownMins, grownMaxs);
+
+			if (grownMins != glmMins || grownMaxs != glmMaxs)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+}
+
+MathBenchmarkReport BenchmarkMath(std::size_t iterations)
+{
+	MathBenchmarkReport report;
+
+	const auto inputs = std::make_unique<MathInputs>();
+
+	// Verify that both paths produce the same results before timing them.
+	{
+		auto glmResult = inputs->To;
+		SlerpGlm(glmResult, inputs->From);
+
+		auto simdResult = std::make_unique<QuaternionData>(inputs->ToArrays);
+		SlerpQuaternions(simdResult->Get(), inputs->FromArrays.Get(), SlerpFraction, ElementCount);
+
+		report.SlerpMatchesGlm = true;
+
+		for (std::size_t i = 0; i < ElementCount; ++i)
+		{
+			report.SlerpMatchesGlm = report.SlerpMatchesGlm && simdResult->Get(i) == glmResult[i];
+		}
+	}
+
+	{
+		std::array<glm::mat4x4, ElementCount> glmResult;
+		MatricesGlm(inputs->To, inputs->Positions, glmResult);
+
+		std::array<glm::mat4x4, ElementCount> simdResult;
+		QuaternionsToMatrices(inputs->ToArrays.Get(), inputs->PositionArrays.Get(), simdResult.data(), ElementCount);
+
+		report.MatricesMatchGlm = simdResult == glmResult;
+	}
+
+	const glm::mat4x4 boundsMatrix = glm::translate(inputs->Positions[0]) * glm::toMat4(inputs->To[0])
+		* glm::scale(glm::vec3{1.5f, 0.75f, 2.f});
+
+	report.BoundsMatchGlm = BoundsMatchGlm(*inputs, boundsMatrix);
+
+	// Each repetition starts from the same inputs so both paths do identical work.
+	report.Results.push_back(RunBenchmark("SlerpQuaternions/glm", "quaternions", iterations, [&]
+		{
+			std::array<glm::quat, ElementCount> working;
+
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				working = inputs->To;
+				SlerpGlm(working, inputs->From);
+			}
+
+			Sink = working[0].x;
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	report.Results.push_back(RunBenchmark("SlerpQuaternions/SIMDMath", "quaternions", iterations, [&]
+		{
+			QuaternionData working;
+
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				working = inputs->ToArrays;
+				SlerpQuaternions(working.Get(), inputs->FromArrays.Get(), SlerpFraction, ElementCount);
+			}
+
+			Sink = working.X[0];
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	std::array<glm::mat4x4, ElementCount> matrices;
+
+	report.Results.push_back(RunBenchmark("QuaternionsToMatrices/glm", "matrices", iterations, [&]
+		{
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				MatricesGlm(inputs->To, inputs->Positions, matrices);
+			}
+
+			Sink = matrices[0][3][0];
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	report.Results.push_back(RunBenchmark("QuaternionsToMatrices/SIMDMath", "matrices", iterations, [&]
+		{
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				QuaternionsToMatrices(inputs->ToArrays.Get(), inputs->PositionArrays.Get(), matrices.data(), ElementCount);
+			}
+
+			Sink = matrices[0][3][0];
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	report.Results.push_back(RunBenchmark("ExpandBoundsByTransformedPoints/glm", "points", iterations, [&]
+		{
+			glm::vec3 mins{std::numeric_limits<float>::max()};
+			glm::vec3 maxs{-std::numeric_limits<float>::max()};
+
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				ExpandBoundsGlm(boundsMatrix, inputs->Positions, 0, ElementCount, mins, maxs);
+			}
+
+			Sink = mins.x + maxs.x;
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	report.Results.push_back(RunBenchmark("ExpandBoundsByTransformedPoints/SIMDMath", "points", iterations, [&]
+		{
+			glm::vec3 mins{std::numeric_limits<float>::max()};
+			glm::vec3 maxs{-std::numeric_limits<float>::max()};
+
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat)
+			{
+				ExpandBoundsByTransformedPoints(boundsMatrix, inputs->PositionArrays.Get(), ElementCount, mins, maxs);
+			}
+
+			Sink = mins.x + maxs.x;
+
+			return std::uint64_t{ElementCount * RepeatCount};
+		}));
+
+	return report;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "bench/Benchmark.hpp"
+
+struct MathBenchmarkReport
+{
+	std::vector<BenchmarkResult> Results;
+
+	bool SlerpMatchesGlm{};
+	bool MatricesMatchGlm{};
+	bool BoundsMatchGlm{};
+};
+
+/**
+*	@brief Compares the batched SIMDMath operations used by BoneTransformer and the bounding box calculation
+*	against the equivalent glm code.
+*/
+MathBenchmarkReport BenchmarkMath(std::size_t iterations);
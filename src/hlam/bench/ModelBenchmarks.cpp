@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <memory>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "application/AssetIO.hpp"
+
+#include "bench/ModelBenchmarks.hpp"
+
+#include "filesystem/FileSystem.hpp"
+
+#include "formats/studiomodel/BoneTransformer.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModel.hpp"
+#include "formats/studiomodel/StudioModelIO.hpp"
+#include "formats/studiomodel/StudioModelUtils.hpp"
+
+#include "graphics/ImageUtils.hpp"
+
+#include "utility/IOUtils.hpp"
+
+namespace
+{
+std::uint64_t GetStudioModelSize(const studiomdl::StudioModel& studioModel)
+{
+	std::uint64_t size = studioModel.GetStudioHeaderPtr().SizeInBytes;
+
+	if (studioModel.HasSeparateTextureHeader())
+	{
+		size += studioModel.GetTextureHeaderPtr().SizeInBytes;
+	}
+
+	for (std::size_t i = 0; i < studioModel.GetSeqGroupCount(); ++i)
+	{
+		size += studioModel.GetSeqGroupHeaderPtr(i).SizeInBytes;
+	}
+
+	return size;
+}
+
+studiomdl::BoneTransformInfo MakeTransformInfo(int sequenceIndex, float frame)
+{
+	return {sequenceIndex, frame, glm::vec3{1}, {}, {}, 0};
+}
+
+/**
+*	@brief Sets up bones for every frame of a sequence.
+*/
+std::uint64_t SetUpSequenceBones(
+	studiomdl::BoneTransformer& boneTransformer, const studiomdl::EditableStudioModel& editableModel, int sequenceIndex)
+{
+	const auto& sequence = *editableModel.Sequences[sequenceIndex];
+
+	const int frameCount = std::max(1, sequence.NumFrames);
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		boneTransformer.SetUpBones(editableModel, MakeTransformInfo(sequenceIndex, static_cast<float>(frame)));
+	}
+
+	return static_cast<std::uint64_t>(frameCount);
+}
+}
+
+ModelBenchmarkReport BenchmarkModel(const std::filesystem::path& fileName, std::size_t iterations)
+{
+	ModelBenchmarkReport report;
+
+	report.FileName = fileName;
+
+	try
+	{
+		FileSystem fileSystem;
+
+		std::unique_ptr<studiomdl::StudioModel> studioModel;
+
+		report.Results.push_back(RunBenchmark("Load", "bytes", iterations, [&]
+			{
+				FilePtr file{utf8_fopen(fileName.u8string().c_str(), "rb")};
+
+				if (!file)
+				{
+					throw AssetException(fmt::format("Could not open file \"{}\"", fileName));
+				}
+
+				studioModel = studiomdl::LoadStudioModel(fileName, file.get(), fileSystem);
+
+				return GetStudioModelSize(*studioModel);
+			}));
+
+		studiomdl::EditableStudioModel editableModel;
+
+		report.Results.push_back(RunBenchmark("ConvertToEditable", "models", iterations, [&]
+			{
+				editableModel = studiomdl::ConvertToEditable(*studioModel);
+				return std::uint64_t{1};
+			}));
+
+		report.Results.push_back(RunBenchmark("ConvertFromEditable", "bytes", iterations, [&]
+			{
+				const auto convertedModel = studiomdl::ConvertFromEditable(fileName, editableModel);
+				return GetStudioModelSize(convertedModel);
+			}));
+
+		report.Validations.push_back(ValidateAnimationRoundTrip(fileName, editableModel));
+		report.Validations.push_back(ValidateMeshOptimization(editableModel));
+
+		// Large enough to cause stack overflows on some platforms if stored on the stack.
+		auto boneTransformer = std::make_unique<studiomdl::BoneTransformer>();
+
+		const int sequenceCount = static_cast<int>(editableModel.Sequences.size());
+
+		report.Results.push_back(RunBenchmark("SetUpBones", "frames", iterations, [&]
+			{
+				std::uint64_t frameCount = 0;
+
+				for (int sequenceIndex = 0; sequenceIndex < sequenceCount; ++sequenceIndex)
+				{
+					frameCount += SetUpSequenceBones(*boneTransformer, editableModel, sequenceIndex);
+				}
+
+				return frameCount;
+			}));
+
+		for (int sequenceIndex = 0; sequenceIndex < sequenceCount; ++sequenceIndex)
+		{
+			report.Sequences.push_back(RunBenchmark(
+				editableModel.Sequences[sequenceIndex]->Label, "frames", iterations, [&]
+				{
+					return SetUpSequenceBones(*boneTransformer, editableModel, sequenceIndex);
+				}));
+		}
+
+		// Skin the default body using the first frame of the first sequence, the same way the renderer does.
+		if (sequenceCount > 0)
+		{
+			const auto& boneTransforms = boneTransformer->SetUpBones(editableModel, MakeTransformInfo(0, 0));
+
+			std::vector<glm::vec3> transformedVertices(MAXSTUDIOVERTS);
+
+			report.Results.push_back(RunBenchmark("Skinning", "vertices", iterations, [&]
+				{
+					std::uint64_t vertexCount = 0;
+
+					for (std::size_t bodypart = 0; bodypart < editableModel.Bodyparts.size(); ++bodypart)
+					{
+						const auto model = editableModel.GetModelByBodyPart(0, static_cast<int>(bodypart));
+
+						const std::size_t count = std::min(model->Vertices.size(), transformedVertices.size());
+
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							transformedVertices[i] = boneTransforms[model->Vertices[i].Bone->ArrayIndex]
+								* glm::vec4{model->Vertices[i].Vertex, 1};
+						}
+
+						vertexCount += count;
+					}
+
+					return vertexCount;
+				}));
+		}
+
+		std::size_t largestTextureSize = 0;
+
+		for (const auto& texture : editableModel.Textures)
+		{
+			largestTextureSize = std::max(largestTextureSize, texture->Data.Pixels.size());
+		}
+
+		std::vector<std::byte> rgbaPixels(largestTextureSize * 4);
+
+		report.Results.push_back(RunBenchmark("TextureExpansion", "pixels", iterations, [&]
+			{
+				std::uint64_t pixelCount = 0;
+
+				for (const auto& texture : editableModel.Textures)
+				{
+					if (texture->Data.Pixels.empty())
+					{
+						continue;
+					}
+
+					graphics::RGBPalette palette{texture->Data.Palette};
+
+					int low, mid, high;
+
+					if (graphics::TryGetRemapColors(texture->Name, low, mid, high))
+					{
+						graphics::PaletteHueReplace(palette, editableModel.TopColor, low, mid);
+
+						if (high)
+						{
+							graphics::PaletteHueReplace(palette, editableModel.BottomColor, mid + 1, high);
+						}
+					}
+
+					graphics::ConvertIndexed8ToRGBA8888(texture->Data.Width, texture->Data.Height,
+						texture->Data.Pixels.data(), palette, (texture->Flags & STUDIO_NF_MASKED) != 0, rgbaPixels.data());
+
+					pixelCount += static_cast<std::uint64_t>(texture->Data.Width) * texture->Data.Height;
+				}
+
+				return pixelCount;
+			}));
+	}
+	catch (const std::exception& e)
+	{
+		report.Error = e.what();
+	}
+
+	return report;
+}
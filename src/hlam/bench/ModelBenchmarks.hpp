@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench/Benchmark.hpp"
+#include "bench/ModelValidation.hpp"
+
+struct ModelBenchmarkReport
+{
+	std::filesystem::path FileName;
+
+	/**
+	*	@brief If not empty, the model could not be benchmarked and the results are incomplete.
+	*/
+	std::string Error;
+
+	std::vector<BenchmarkResult> Results;
+
+	/**
+	*	@brief SetUpBones timings for each sequence, covering every frame of the sequence.
+	*/
+	std::vector<BenchmarkResult> Sequences;
+
+	/**
+	*	@brief Checks that the conversions done while saving leave the model unchanged.
+	*/
+	std::vector<ValidationResult> Validations;
+};
+
+/**
+*	@brief Measures loading, conversion, bone setup, CPU skinning and texture expansion for a single model
+*	and validates the conversions done while saving.
+*/
+ModelBenchmarkReport BenchmarkModel(const std::filesystem::path& fileName, std::size_t iterations);
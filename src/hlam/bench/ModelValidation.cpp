@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "bench/ModelValidation.hpp"
+
+#include "formats/studiomodel/AnimationCompression.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/MeshOptimization.hpp"
+#include "formats/studiomodel/StudioModel.hpp"
+#include "formats/studiomodel/StudioModelUtils.hpp"
+
+namespace
+{
+/**
+*	@brief Values the engine reads to animate a single frame.
+*/
+struct FrameRead
+{
+	short Value{};
+
+	/**
+	*	@brief Value the engine interpolates towards. Only valid if @ref HasNextValue is true.
+	*/
+	short NextValue{};
+
+	/**
+	*	@brief False if the engine reads the next value from outside of the axis data.
+	*/
+	bool HasNextValue{};
+};
+
+/**
+*	@brief Reads a frame the same way BoneTransformer::CalculateBonePosition and CalculateBoneQuaternion do,
+*	without reading outside of @p data.
+*	@return Whether the frame lies inside @p data.
+*/
+bool ReadFrame(const std::vector<mstudioanimvalue_t>& data, int frame, bool isPosition, FrameRead& read)
+{
+	// Axes without data use the bone's default value.
+	if (data.empty())
+	{
+		read = FrameRead{0, 0, true};
+		return true;
+	}
+
+	std::size_t run = 0;
+	int k = frame;
+
+	while (true)
+	{
+		if (run >= data.size())
+		{
+			return false;
+		}
+
+		if (data[run].num.total > k)
+		{
+			break;
+		}
+
+		k -= data[run].num.total;
+		run += data[run].num.valid + 1;
+	}
+
+	const int valid = data[run].num.valid;
+	const int total = data[run].num.total;
+
+	std::size_t valueIndex;
+	std::size_t nextValueIndex;
+
+	if (valid > k)
+	{
+		valueIndex = run + k + 1;
+
+		if (valid > k + 1)
+		{
+			nextValueIndex = run + k + 2;
+		}
+		else if (isPosition || total > k + 1)
+		{
+			// Positions don't interpolate from the last stored value of a run, even if the run ends there.
+			nextValueIndex = valueIndex;
+		}
+		else
+		{
+			nextValueIndex = run + valid + 2;
+		}
+	}
+	else
+	{
+		valueIndex = run + valid;
+		nextValueIndex = total > k + 1 ? valueIndex : run + valid + 2;
+	}
+
+	if (valueIndex >= data.size())
+	{
+		return false;
+	}
+
+	read.Value = data[valueIndex].value;
+	read.HasNextValue = nextValueIndex < data.size();
+	read.NextValue = read.HasNextValue ? data[nextValueIndex].value : 0;
+
+	return true;
+}
+
+std::string FormatAxis(const studiomdl::StudioSequence& sequence, std::size_t blend, std::size_t bone, std::size_t axis)
+{
+	return fmt::format("Sequence \"{}\" blend {} bone {} axis {}", sequence.Label, blend, bone, axis);
+}
+
+/**
+*	@brief Decodes, encodes and decodes again a single axis and checks that each frame reads the same values.
+*	@return Description of the first mismatch, or an empty string.
+*/
+std::string ValidateAxisRoundTrip(const std::vector<mstudioanimvalue_t>& data, int frameCount)
+{
+	std::vector<short> values;
+
+	// Axes that can't be decoded are saved as they are.
+	if (!studiomdl::DecodeAnimationValues(data, frameCount, values))
+	{
+		return {};
+	}
+
+	const auto encoded = studiomdl::EncodeAnimationValues(values);
+
+	std::vector<short> decoded;
+
+	if (encoded.empty())
+	{
+		decoded.resize(frameCount);
+	}
+	else if (!studiomdl::DecodeAnimationValues(encoded, frameCount, decoded))
+	{
+		return "the encoded data does not cover all frames";
+	}
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		if (decoded[frame] != values[frame])
+		{
+			return fmt::format("frame {} decodes to {} instead of {}", frame, decoded[frame], values[frame]);
+		}
+
+		// Rotations always interpolate towards the next frame, so they also check the reads across run boundaries.
+		FrameRead read;
+
+		if (!ReadFrame(encoded, frame, false, read) || read.Value != values[frame])
+		{
+			return fmt::format("frame {} is not read as {}", frame, values[frame]);
+		}
+
+		if (frame + 1 < frameCount && (!read.HasNextValue || read.NextValue != values[frame + 1]))
+		{
+			return fmt::format("frame {} does not interpolate towards {}", frame, values[frame + 1]);
+		}
+	}
+
+	return {};
+}
+
+/**
+*	@brief Checks that the engine reads the same values from @p converted as from @p original for each frame.
+*	The last frame is never interpolated, so only its value has to match.
+*	@return Description of the first mismatch, or an empty string.
+*/
+std::string CompareAxisReads(const std::vector<mstudioanimvalue_t>& original, const std::vector<mstudioanimvalue_t>& converted,
+	int frameCount, bool isPosition)
+{
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		FrameRead originalRead;
+
+		// The engine reads garbage for these frames, so there is nothing to preserve.
+		if (!ReadFrame(original, frame, isPosition, originalRead))
+		{
+			continue;
+		}
+
+		FrameRead convertedRead;
+
+		if (!ReadFrame(converted, frame, isPosition, convertedRead) || convertedRead.Value != originalRead.Value)
+		{
+			return fmt::format("frame {} is not read as {}", frame, originalRead.Value);
+		}
+
+		if (frame + 1 < frameCount && originalRead.HasNextValue
+			&& (!convertedRead.HasNextValue || convertedRead.NextValue != originalRead.NextValue))
+		{
+			return fmt::format("frame {} does not interpolate towards {}", frame, originalRead.NextValue);
+		}
+	}
+
+	return {};
+}
+
+/**
+*	@brief Vertex index, normal index and texture coordinates of a triangle command vertex.
+*/
+using CommandVertex = std::array<short, 4>;
+using CommandTriangle = std::array<CommandVertex, 3>;
+
+/**
+*	@brief Decodes the triangles drawn by @p commands, each in its lexicographically smallest rotation so
+*	triangles compare equal regardless of which vertex they start at, but not if their winding differs.
+*	@return The sorted triangles, or an empty optional if the commands are malformed.
+*/
+std::optional<std::vector<CommandTriangle>> DecodeSortedTriangles(const std::vector<short>& commands)
+{
+	std::vector<CommandTriangle> triangles;
+
+	std::size_t position = 0;
+
+	while (true)
+	{
+		if (position >= commands.size())
+		{
+			return {};
+		}
+
+		const int command = commands[position++];
+
+		if (command == 0)
+		{
+			break;
+		}
+
+		const std::size_t count = std::abs(command);
+
+		if (count * 4 > commands.size() - position)
+		{
+			return {};
+		}
+
+		const auto vertexAt = [&](std::size_t index)
+		{
+			CommandVertex vertex;
+			std::copy_n(commands.begin() + position + (index * 4), 4, vertex.begin());
+			return vertex;
+		};
+
+		for (std::size_t i = 2; i < count; ++i)
+		{
+			CommandTriangle triangle;
+
+			if (command < 0)
+			{
+				triangle = {vertexAt(0), vertexAt(i - 1), vertexAt(i)};
+			}
+			else if ((i % 2) == 0)
+			{
+				triangle = {vertexAt(i - 2), vertexAt(i - 1), vertexAt(i)};
+			}
+			else
+			{
+				// Odd triangles in a strip swap their first two vertices to keep the winding consistent.
+				triangle = {vertexAt(i - 1), vertexAt(i - 2), vertexAt(i)};
+			}
+
+			// Degenerate triangles can start at the smallest vertex in more than one way, so pick the smallest rotation.
+			CommandTriangle smallest = triangle;
+
+			for (int rotation = 1; rotation < 3; ++rotation)
+			{
+				std::rotate(triangle.begin(), triangle.begin() + 1, triangle.end());
+				smallest = std::min(smallest, triangle);
+			}
+
+			triangles.push_back(smallest);
+		}
+
+		position += count * 4;
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+
+	return triangles;
+}
+}
+
+ValidationResult ValidateAnimationRoundTrip(
+	const std::filesystem::path& fileName, const studiomdl::EditableStudioModel& editableModel)
+{
+	ValidationResult result;
+
+	result.Name = "animations_round_trip";
+
+	const std::size_t boneCount = editableModel.Bones.size();
+
+	for (const auto& sequence : editableModel.Sequences)
+	{
+		for (std::size_t blend = 0; blend < sequence->AnimationBlends.size(); ++blend)
+		{
+			for (std::size_t bone = 0; bone < boneCount; ++bone)
+			{
+				const auto& animation = sequence->AnimationBlends[blend][bone];
+
+				for (std::size_t axis = 0; axis < animation.Data.size(); ++axis)
+				{
+					if (animation.Data[axis].empty() || sequence->NumFrames <= 0)
+					{
+						continue;
+					}
+
+					if (auto error = ValidateAxisRoundTrip(animation.Data[axis], sequence->NumFrames); !error.empty())
+					{
+						result.Error = fmt::format("{}: {}", FormatAxis(*sequence, blend, bone, axis), error);
+						return result;
+					}
+				}
+			}
+		}
+	}
+
+	studiomdl::ConvertFromEditableOptions options;
+	options.CompressAnimations = true;
+
+	const auto convertedModel = studiomdl::ConvertFromEditable(fileName, editableModel, options);
+	const auto roundTripModel = studiomdl::ConvertToEditable(convertedModel);
+
+	if (roundTripModel.Sequences.size() != editableModel.Sequences.size() || roundTripModel.Bones.size() != boneCount)
+	{
+		result.Error = "The converted model has a different number of sequences or bones";
+		return result;
+	}
+
+	for (std::size_t i = 0; i < editableModel.Sequences.size(); ++i)
+	{
+		const auto& sequence = *editableModel.Sequences[i];
+		const auto& roundTripSequence = *roundTripModel.Sequences[i];
+
+		if (roundTripSequence.NumFrames != sequence.NumFrames
+			|| roundTripSequence.AnimationBlends.size() != sequence.AnimationBlends.size())
+		{
+			result.Error = fmt::format("Sequence \"{}\" has a different number of frames or blends", sequence.Label);
+			return result;
+		}
+
+		for (std::size_t blend = 0; blend < sequence.AnimationBlends.size(); ++blend)
+		{
+			for (std::size_t bone = 0; bone < boneCount; ++bone)
+			{
+				const auto& original = sequence.AnimationBlends[blend][bone];
+				const auto& converted = roundTripSequence.AnimationBlends[blend][bone];
+
+				for (std::size_t axis = 0; axis < original.Data.size(); ++axis)
+				{
+					// The first 3 axes are positions, the others are rotations.
+					if (auto error = CompareAxisReads(original.Data[axis], converted.Data[axis], sequence.NumFrames, axis < 3);
+						!error.empty())
+					{
+						result.Error = fmt::format("{}: {}", FormatAxis(sequence, blend, bone, axis), error);
+						return result;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+ValidationResult ValidateMeshOptimization(const studiomdl::EditableStudioModel& editableModel)
+{
+	ValidationResult result;
+
+	result.Name = "meshes_preserve_triangles";
+
+	const auto originalCommands = studiomdl::GetTriangleCommands(editableModel);
+	const auto optimization = studiomdl::OptimizeMeshes(editableModel, nullptr);
+
+	if (optimization.Commands.size() != originalCommands.size())
+	{
+		result.Error = fmt::format("Optimized {} meshes instead of {}", optimization.Commands.size(), originalCommands.size());
+		return result;
+	}
+
+	for (std::size_t mesh = 0; mesh < originalCommands.size(); ++mesh)
+	{
+		// Meshes that can't be improved are left alone, which includes meshes with malformed commands.
+		if (optimization.Commands[mesh] == originalCommands[mesh])
+		{
+			continue;
+		}
+
+		const auto originalTriangles = DecodeSortedTriangles(originalCommands[mesh]);
+		const auto optimizedTriangles = DecodeSortedTriangles(optimization.Commands[mesh]);
+
+		if (!originalTriangles || !optimizedTriangles)
+		{
+			result.Error = fmt::format("Mesh {}: the {} commands are malformed", mesh, originalTriangles ? "optimized" : "original");
+			return result;
+		}
+
+		if (*optimizedTriangles != *originalTriangles)
+		{
+			const auto difference = std::mismatch(
+				originalTriangles->begin(), originalTriangles->end(), optimizedTriangles->begin(), optimizedTriangles->end());
+
+			result.Error = fmt::format("Mesh {}: draws {} triangles instead of {}, first difference at sorted triangle {}",
+				mesh, optimizedTriangles->size(), originalTriangles->size(), difference.first - originalTriangles->begin());
+			return result;
+		}
+	}
+
+	return result;
+}
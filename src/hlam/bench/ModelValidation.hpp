@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace studiomdl
+{
+class EditableStudioModel;
+}
+
+/**
+*	@brief Result of a check that a conversion leaves the model unchanged as far as the engine is concerned.
+*/
+struct ValidationResult
+{
+	std::string Name;
+
+	/**
+	*	@brief Describes the first mismatch that was found. Empty if the check passed.
+	*/
+	std::string Error;
+};
+
+/**
+*	@brief Checks that recompressing the animation data changes nothing the engine reads.
+*	Every axis is decoded, encoded and decoded again, and the model is saved with compressed animations
+*	and converted back to compare each frame, including the first value of the next run
+*	that the engine reads to interpolate across run boundaries.
+*/
+ValidationResult ValidateAnimationRoundTrip(
+	const std::filesystem::path& fileName, const studiomdl::EditableStudioModel& editableModel);
+
+/**
+*	@brief Checks that optimizing the triangle commands of each mesh draws the same triangles with the same winding.
+*	The original and optimized commands are decoded independently of the optimizer and compared as multisets of
+*	triangles, each in its lexicographically smallest rotation.
+*/
+ValidationResult ValidateMeshOptimization(const studiomdl::EditableStudioModel& editableModel);
@@ -81,6 +81,9 @@ public:
 	*/
 	virtual void Spawn() {}
 
+	/**
+	*	@brief Scenes cache the entities drawn in each pass, so this must not change once the entity has been created.
+	*/
 	virtual RenderPasses GetRenderPasses() const { return RenderPass::None; }
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) {}
@@ -91,6 +94,12 @@ public:
 
 	virtual float GetRenderDistance(const glm::vec3& cameraOrigin) const { return 1000000000.0f; }
 
+	/**
+	*	@brief Gets a sphere in world space that encloses everything the entity draws.
+	*	@return Whether the entity has bounds. Entities without bounds are never culled.
+	*/
+	virtual bool GetRenderBounds(glm::vec3& center, float& radius) const { return false; }
+
 private:
 	EntityContext* _context{};
 	EntityList* _entityList{};
@@ -38,6 +38,7 @@ void EntityList::RunFrame()
 void EntityList::Add(const std::shared_ptr<BaseEntity>& entity)
 {
 	_entities.push_back(entity);
+	++_version;
 }
 
 void EntityList::Destroy(const std::shared_ptr<BaseEntity>& entity)
@@ -58,9 +59,11 @@ void EntityList::Destroy(const std::shared_ptr<BaseEntity>& entity)
 
 	// Entity will still exist until last strong reference has been cleared.
 	_entities.erase(it);
+	++_version;
 }
 
 void EntityList::DestroyAll()
 {
 	_entities.clear();
+	++_version;
 }
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,11 @@ public:
 
 	std::size_t GetNumEntities() const { return _entities.size(); }
 
+	/**
+	*	@brief Changes whenever entities are added or removed, so lists derived from this one can be kept up to date.
+	*/
+	std::uint64_t GetVersion() const { return _version; }
+
 	std::shared_ptr<BaseEntity> GetEntityByIndex(std::size_t index) const;
 
 	auto begin() const
@@ -76,4 +82,6 @@ private:
 	EntityContext* const _context;
 
 	std::vector<std::shared_ptr<BaseEntity>> _entities;
+
+	std::uint64_t _version{};
 };
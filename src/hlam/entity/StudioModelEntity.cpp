@@ -2,7 +2,9 @@
 
 #include <QOpenGLFunctions_1_1>
 
+#include <glm/common.hpp>
 #include <glm/geometric.hpp>
+#include <glm/vector_relational.hpp>
 
 #include "entity/GroundEntity.hpp"
 #include "entity/StudioModelEntity.hpp"
@@ -119,6 +121,22 @@ void StudioModelEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 	GetContext()->StudioModelRenderer->DrawModel(
 		renderInfo, GetContext()->Asset->GetGroundEntity()->GetOrigin().z, flags);
 
+	// Hitboxes can extend past the sequence bounding box, so remember how far they reached for culling.
+	if (const auto boneTransforms = GetContext()->StudioModelRenderer->GetBoneTransforms(); boneTransforms)
+	{
+		_drawnHitboxRadius = 0;
+
+		for (const auto& hitbox : _editableModel->Hitboxes)
+		{
+			const auto& transform = boneTransforms[hitbox->Bone->ArrayIndex];
+
+			for (const auto& corner : graphics::CreateBoxFromBounds(hitbox->Min, hitbox->Max))
+			{
+				_drawnHitboxRadius = std::max(_drawnHitboxRadius, glm::length(glm::vec3{transform * glm::vec4{corner, 1}}));
+			}
+		}
+	}
+
 	//TODO: this is a temporary hack. The graphics scene architecture needs a complete overhaul first,
 		//then this can be done by rendering the model in a separate viewmodel layer
 	if (asset->CameraIsFirstPerson())
@@ -168,6 +186,36 @@ float StudioModelEntity::GetRenderDistance(const glm::vec3& cameraOrigin) const
 	return glm::length(renderOrigin - cameraOrigin);
 }
 
+bool StudioModelEntity::GetRenderBounds(glm::vec3& center, float& radius) const
+{
+	auto asset = GetContext()->Asset;
+
+	// View models are drawn at the camera and often have inaccurate bounding boxes,
+	// and shadows are projected onto the ground outside of the model's bounds.
+	if (asset->CameraIsFirstPerson() || asset->DrawShadows)
+	{
+		return false;
+	}
+
+	glm::vec3 mins, maxs;
+	ExtractBbox(mins, maxs);
+
+	// Sequences compiled without a bounding box would always be culled.
+	if (glm::any(glm::greaterThanEqual(mins, maxs)))
+	{
+		return false;
+	}
+
+	// Centering the sphere on the origin makes it independent of the model's angles.
+	const glm::vec3& scale = GetScale();
+	const glm::vec3 farthestCorner = glm::max(glm::abs(mins * scale), glm::abs(maxs * scale));
+
+	center = GetOrigin();
+	radius = std::max(glm::length(farthestCorner), _drawnHitboxRadius);
+
+	return true;
+}
+
 studiomdl::ModelRenderInfo StudioModelEntity::GetRenderInfo() const
 {
 	studiomdl::ModelRenderInfo renderInfo{};
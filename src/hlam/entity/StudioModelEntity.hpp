@@ -48,6 +48,12 @@ public:
 
 	float GetRenderDistance(const glm::vec3& cameraOrigin) const override;
 
+	/**
+	*	@brief Encloses the current sequence's bounding box and the hitboxes in the pose the model was last drawn in.
+	*	The game culls models using only the sequence bounding box.
+	*/
+	bool GetRenderBounds(glm::vec3& center, float& radius) const override;
+
 	studiomdl::ModelRenderInfo GetRenderInfo() const;
 
 	/**
@@ -134,6 +140,11 @@ private:
 
 	const IBlender* _blender = &StandardBlender;
 
+	/**
+	*	@brief Distance from the origin to the farthest hitbox corner when the model was last drawn.
+	*/
+	float _drawnHitboxRadius = 0;
+
 public:
 	studiomdl::EditableStudioModel* GetEditableModel() const { return _editableModel; }
 
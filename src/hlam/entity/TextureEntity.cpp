@@ -88,7 +88,6 @@ void TextureEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 
 	if (ShowUVMap)
 	{
-		sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
 
 		sc.OpenGLFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
@@ -104,31 +103,15 @@ void TextureEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 			sc.OpenGLFunctions->glDisable(GL_BLEND);
 		}
 
-		int i;
-
-		for (const auto mesh : _meshes)
+		if (!_uvEdges.empty())
 		{
-			auto triCommands = mesh->Triangles.data();
-
-			while (i = *(triCommands++))
-			{
-				if (i < 0)
-				{
-					sc.OpenGLFunctions->glBegin(GL_TRIANGLE_FAN);
-					i = -i;
-				}
-				else
-				{
-					sc.OpenGLFunctions->glBegin(GL_TRIANGLE_STRIP);
-				}
-
-				for (; i > 0; i--, triCommands += 4)
-				{
-					// FIX: put these in as integer coords, not floats
-					sc.OpenGLFunctions->glVertex2f(x + triCommands[2] * TextureScale, y + triCommands[3] * TextureScale);
-				}
-				sc.OpenGLFunctions->glEnd();
-			}
+			sc.OpenGLFunctions->glTranslatef(x, y, 0);
+			sc.OpenGLFunctions->glScalef(TextureScale, TextureScale, 1);
+
+			sc.OpenGLFunctions->glEnableClientState(GL_VERTEX_ARRAY);
+			sc.OpenGLFunctions->glVertexPointer(2, GL_SHORT, 0, _uvEdges.data());
+			sc.OpenGLFunctions->glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(_uvEdges.size() * 2));
+			sc.OpenGLFunctions->glDisableClientState(GL_VERTEX_ARRAY);
 		}
 
 		if (AntiAliasLines)
@@ -160,18 +143,20 @@ void TextureEntity::SetMeshIndex(int meshIndex)
 {
 	if (_textureIndex == -1)
 	{
-		_meshes.clear();
+		_uvEdges.clear();
 		return;
 	}
 
 	const auto model = GetContext()->Asset->GetEntity()->GetEditableModel();
 
-	_meshes = model->ComputeMeshList(_textureIndex);
+	auto meshes = model->ComputeMeshList(_textureIndex);
 
 	if (meshIndex != -1)
 	{
-		auto singleMesh = _meshes[meshIndex];
-		_meshes.clear();
-		_meshes.emplace_back(singleMesh);
+		auto singleMesh = meshes[meshIndex];
+		meshes.clear();
+		meshes.emplace_back(singleMesh);
 	}
+
+	_uvEdges = studiomdl::ExtractUVEdges(meshes);
 }
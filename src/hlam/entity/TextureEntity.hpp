@@ -5,10 +5,7 @@
 
 #include "entity/BaseEntity.hpp"
 
-namespace studiomdl
-{
-struct StudioMesh;
-}
+#include "formats/studiomodel/StudioModelUVEdges.hpp"
 
 /**
 *	Draws the current model texture.
@@ -25,6 +22,10 @@ public:
 
 	void SetTextureIndex(int textureIndex, int meshIndex);
 
+	/**
+	*	@brief Selects the mesh whose UV map is drawn, or -1 for all meshes using the texture.
+	*	Also call this after texture coordinates have changed to update the UV map.
+	*/
 	void SetMeshIndex(int meshIndex);
 
 	float TextureScale = 1;
@@ -38,5 +39,9 @@ public:
 
 private:
 	int _textureIndex = -1;
-	std::vector<const studiomdl::StudioMesh*> _meshes;
+
+	/**
+	*	@brief UV map edges of the selected meshes, extracted once so redrawing only needs a transform change.
+	*/
+	std::vector<studiomdl::UVEdge> _uvEdges;
 };
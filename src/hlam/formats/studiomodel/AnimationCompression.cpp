@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <optional>
+
+#include "formats/studiomodel/AnimationCompression.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+
+#include "utility/ThreadPool.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+/**
+*	@brief Both the number of stored values and the number of frames in a run are stored in a byte.
+*/
+constexpr int MaximumRunLength = std::numeric_limits<std::uint8_t>::max();
+
+/**
+*	@brief Values the engine reads to animate a single frame.
+*/
+struct EngineFrameRead
+{
+	short Value{};
+
+	/**
+	*	@brief Value the engine interpolates towards, or an empty optional if it lies outside the data.
+	*/
+	std::optional<short> NextValue;
+};
+
+/**
+*	@brief Reads every frame the same way the engine's bone setup does.
+*	At the end of a run the engine interpolates towards the first value of the next run.
+*	Positions don't do this if the run ends on a stored value, so they depend on where the runs are split.
+*	@return One read per frame, or an empty optional for frames that lie outside @p data.
+*/
+std::vector<std::optional<EngineFrameRead>> ReadFramesLikeEngine(
+	const std::vector<mstudioanimvalue_t>& data, int frameCount, bool isPosition)
+{
+	std::vector<std::optional<EngineFrameRead>> reads;
+	reads.reserve(frameCount);
+
+	const auto valueAt = [&](std::size_t index) -> std::optional<short>
+	{
+		if (index >= data.size())
+		{
+			return {};
+		}
+
+		return data[index].value;
+	};
+
+	std::size_t position = 0;
+	int runStart = 0;
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		while (position < data.size() && data[position].num.total <= frame - runStart)
+		{
+			runStart += data[position].num.total;
+			position += data[position].num.valid + 1;
+		}
+
+		if (position >= data.size())
+		{
+			reads.emplace_back();
+			continue;
+		}
+
+		const int k = frame - runStart;
+		const int valid = data[position].num.valid;
+		const int total = data[position].num.total;
+
+		std::optional<short> value;
+		std::optional<short> nextValue;
+
+		if (valid > k)
+		{
+			value = valueAt(position + k + 1);
+
+			if (valid > k + 1)
+			{
+				nextValue = valueAt(position + k + 2);
+			}
+			else if (isPosition || total > k + 1)
+			{
+				nextValue = value;
+			}
+			else
+			{
+				nextValue = valueAt(position + valid + 2);
+			}
+		}
+		else
+		{
+			value = valueAt(position + valid);
+			nextValue = total > k + 1 ? value : valueAt(position + valid + 2);
+		}
+
+		if (value)
+		{
+			reads.push_back(EngineFrameRead{*value, nextValue});
+		}
+		else
+		{
+			reads.emplace_back();
+		}
+	}
+
+	return reads;
+}
+
+/**
+*	@brief Whether the engine animates every frame of @p encoded the same way as @p original.
+*	The last frame is never interpolated, so only its value has to match.
+*/
+bool ReadsLikeOriginal(const std::vector<mstudioanimvalue_t>& original, const std::vector<mstudioanimvalue_t>& encoded,
+	int frameCount, bool isPosition)
+{
+	const auto originalReads = ReadFramesLikeEngine(original, frameCount, isPosition);
+	const auto encodedReads = ReadFramesLikeEngine(encoded, frameCount, isPosition);
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		const auto& originalRead = originalReads[frame];
+		const auto& encodedRead = encodedReads[frame];
+
+		if (!originalRead)
+		{
+			continue;
+		}
+
+		if (!encodedRead || encodedRead->Value != originalRead->Value)
+		{
+			return false;
+		}
+
+		// If the original reads past its data the engine interpolates towards whatever follows it, so anything goes.
+		if (frame + 1 < frameCount && originalRead->NextValue && encodedRead->NextValue != originalRead->NextValue)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+}
+
+bool DecodeAnimationValues(const std::vector<mstudioanimvalue_t>& data, int frameCount, std::vector<short>& values)
+{
+	values.clear();
+	values.reserve(frameCount);
+
+	std::size_t position = 0;
+
+	while (values.size() < static_cast<std::size_t>(frameCount))
+	{
+		if (position >= data.size())
+		{
+			return false;
+		}
+
+		const int valid = data[position].num.valid;
+		const int total = data[position].num.total;
+
+		// Frames after the last valid value repeat it. The engine reads the run header itself if there are no values.
+		if (position + valid >= data.size())
+		{
+			return false;
+		}
+
+		for (int i = 0; i < total && values.size() < static_cast<std::size_t>(frameCount); ++i)
+		{
+			values.push_back(data[position + std::min(i + 1, valid)].value);
+		}
+
+		position += valid + 1;
+	}
+
+	return true;
+}
+
+std::vector<mstudioanimvalue_t> EncodeAnimationValues(const std::vector<short>& values)
+{
+	if (std::all_of(values.begin(), values.end(), [](short value) { return value == 0; }))
+	{
+		return {};
+	}
+
+	const std::size_t count = values.size();
+
+	// Number of frames starting at each frame that have the same value.
+	std::vector<int> repeats(count);
+
+	for (std::size_t i = count; i-- > 0;)
+	{
+		repeats[i] = (i + 1 < count && values[i + 1] == values[i]) ? repeats[i + 1] + 1 : 1;
+	}
+
+	struct Run
+	{
+		int Valid;
+		int Total;
+	};
+
+	// costs[i] is the smallest number of entries needed to encode frames [i, count).
+	// Encoding fewer frames never costs more, so a run with a given number of values
+	// should always repeat its last value for as many frames as possible.
+	std::vector<std::size_t> costs(count + 1);
+	std::vector<Run> runs(count);
+
+	costs[count] = 0;
+
+	for (std::size_t i = count; i-- > 0;)
+	{
+		costs[i] = std::numeric_limits<std::size_t>::max();
+
+		const int maximumValid = static_cast<int>(std::min<std::size_t>(MaximumRunLength, count - i));
+
+		// Each value costs an entry, so once a run with this many values costs more than the best encoding so far,
+		// longer runs can't do better.
+		for (int valid = 1; valid <= maximumValid && static_cast<std::size_t>(1 + valid) < costs[i]; ++valid)
+		{
+			const int total = std::min(MaximumRunLength, valid + repeats[i + valid - 1] - 1);
+			const std::size_t cost = 1 + valid + costs[i + total];
+
+			if (cost < costs[i])
+			{
+				costs[i] = cost;
+				runs[i] = {valid, total};
+			}
+		}
+	}
+
+	std::vector<mstudioanimvalue_t> data;
+	data.reserve(costs[0]);
+
+	for (std::size_t i = 0; i < count; i += runs[i].Total)
+	{
+		const auto& run = runs[i];
+
+		mstudioanimvalue_t header;
+		header.num.valid = static_cast<std::uint8_t>(run.Valid);
+		header.num.total = static_cast<std::uint8_t>(run.Total);
+		data.push_back(header);
+
+		for (int j = 0; j < run.Valid; ++j)
+		{
+			mstudioanimvalue_t value;
+			value.value = values[i + j];
+			data.push_back(value);
+		}
+	}
+
+	return data;
+}
+
+CompressedSequenceAnimations CompressSequenceAnimations(const EditableStudioModel& studioModel, const StudioSequence& sequence)
+{
+	CompressedSequenceAnimations result;
+
+	result.StreamIndices.reserve(sequence.AnimationBlends.size() * studioModel.Bones.size() * STUDIO_NUM_COORDINATE_AXES);
+
+	// Identical axes are stored once. Axes that can't be decoded, or that the engine would interpolate differently
+	// once re-encoded, are stored as they are and are not shared.
+	std::map<std::vector<short>, int> streamsByValues;
+	std::vector<short> values;
+
+	const auto storeOriginal = [&](const std::vector<mstudioanimvalue_t>& data)
+	{
+		result.StreamIndices.push_back(static_cast<int>(result.Streams.size()));
+		result.Streams.push_back(data);
+	};
+
+	for (const auto& blend : sequence.AnimationBlends)
+	{
+		for (std::size_t bone = 0; bone < studioModel.Bones.size(); ++bone)
+		{
+			for (std::size_t axis = 0; axis < blend[bone].Data.size(); ++axis)
+			{
+				const auto& data = blend[bone].Data[axis];
+
+				if (data.empty())
+				{
+					result.StreamIndices.push_back(-1);
+					continue;
+				}
+
+				if (sequence.NumFrames <= 0 || !DecodeAnimationValues(data, sequence.NumFrames, values))
+				{
+					storeOriginal(data);
+					continue;
+				}
+
+				// The first 3 axes are positions, the others are rotations.
+				const bool isPosition = axis < 3;
+
+				if (auto it = streamsByValues.find(values); it != streamsByValues.end())
+				{
+					if (ReadsLikeOriginal(data, result.Streams[it->second], sequence.NumFrames, isPosition))
+					{
+						result.StreamIndices.push_back(it->second);
+					}
+					else
+					{
+						storeOriginal(data);
+					}
+
+					continue;
+				}
+
+				auto encoded = EncodeAnimationValues(values);
+
+				// Axes without data use the bone's default value, which is what all zero values amount to.
+				if (encoded.empty())
+				{
+					result.StreamIndices.push_back(-1);
+					continue;
+				}
+
+				if (!ReadsLikeOriginal(data, encoded, sequence.NumFrames, isPosition))
+				{
+					storeOriginal(data);
+					continue;
+				}
+
+				const int index = static_cast<int>(result.Streams.size());
+
+				result.StreamIndices.push_back(index);
+				result.Streams.push_back(std::move(encoded));
+				streamsByValues.emplace(values, index);
+			}
+		}
+	}
+
+	return result;
+}
+
+std::vector<CompressedSequenceAnimations> CompressAnimations(const EditableStudioModel& studioModel, ThreadPool* threadPool)
+{
+	std::vector<CompressedSequenceAnimations> result(studioModel.Sequences.size());
+
+	const auto compressSequence = [&](std::size_t index)
+	{
+		result[index] = CompressSequenceAnimations(studioModel, *studioModel.Sequences[index]);
+	};
+
+	if (threadPool)
+	{
+		threadPool->ParallelFor(result.size(), compressSequence);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < result.size(); ++i)
+		{
+			compressSequence(i);
+		}
+	}
+
+	return result;
+}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+
+class ThreadPool;
+
+namespace studiomdl
+{
+class EditableStudioModel;
+struct StudioSequence;
+
+/**
+*	@brief Animation data of a sequence with each axis encoded in as few values as possible.
+*/
+struct CompressedSequenceAnimations
+{
+	/**
+	*	@brief Unique value streams. Axes that have the same values share a stream.
+	*/
+	std::vector<std::vector<mstudioanimvalue_t>> Streams;
+
+	/**
+	*	@brief Index of the stream for each blend, bone and axis, in that order, or -1 if the axis has no data.
+	*/
+	std::vector<int> StreamIndices;
+};
+
+/**
+*	@brief Decodes run length encoded values into one value per frame, the same way the engine does.
+*	@return Whether @p data covers all frames.
+*/
+bool DecodeAnimationValues(const std::vector<mstudioanimvalue_t>& data, int frameCount, std::vector<short>& values);
+
+/**
+*	@brief Encodes one value per frame using the fewest possible entries.
+*	Returns no data if all values are 0, because the engine uses the bone's default value for axes without data.
+*/
+std::vector<mstudioanimvalue_t> EncodeAnimationValues(const std::vector<short>& values);
+
+/**
+*	@brief Re-encodes the animation data of a sequence.
+*	Axes are kept as they are if the engine would read any frame differently from the re-encoded data.
+*/
+CompressedSequenceAnimations CompressSequenceAnimations(const EditableStudioModel& studioModel, const StudioSequence& sequence);
+
+/**
+*	@brief Re-encodes the animation data of all sequences.
+*	@param threadPool Optional pool used to compress sequences in parallel.
+*/
+std::vector<CompressedSequenceAnimations> CompressAnimations(const EditableStudioModel& studioModel, ThreadPool* threadPool);
+}
@@ -9,6 +9,8 @@
 #include "formats/studiomodel/EditableStudioModel.hpp"
 
 #include "utility/mathlib.hpp"
+#include "utility/SIMDMath.hpp"
+#include "utility/ThreadPool.hpp"
 
 namespace studiomdl
 {
@@ -26,6 +28,8 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 
 	const auto& sequence = sequenceIndex  != -1 ? *studioModel.Sequences[sequenceIndex] : emptySequence;
 
+	std::array<const StudioAnimation*, TransformStatesCount> blendAnims{};
+
 	if (sequence.AnimationBlends.size() == 9)
 	{
 		const auto blendX = static_cast<double>(transformInfo.Blenders[0]);
@@ -42,19 +46,19 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 			{
 				interpolantY = (blendY - 127.0) * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[5].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[7].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[8].data(), _transformStates[3]);
+				blendAnims[0] = sequence.AnimationBlends[4].data();
+				blendAnims[1] = sequence.AnimationBlends[5].data();
+				blendAnims[2] = sequence.AnimationBlends[7].data();
+				blendAnims[3] = sequence.AnimationBlends[8].data();
 			}
 			else
 			{
 				interpolantY = blendY * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[2].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[5].data(), _transformStates[3]);
+				blendAnims[0] = sequence.AnimationBlends[1].data();
+				blendAnims[1] = sequence.AnimationBlends[2].data();
+				blendAnims[2] = sequence.AnimationBlends[4].data();
+				blendAnims[3] = sequence.AnimationBlends[5].data();
 			}
 		}
 		else
@@ -65,22 +69,24 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 			{
 				interpolantY = blendY * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[0].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[3]);
+				blendAnims[0] = sequence.AnimationBlends[0].data();
+				blendAnims[1] = sequence.AnimationBlends[1].data();
+				blendAnims[2] = sequence.AnimationBlends[3].data();
+				blendAnims[3] = sequence.AnimationBlends[4].data();
 			}
 			else
 			{
 				interpolantY = (blendY - 127.0) * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[6].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[7].data(), _transformStates[3]);
+				blendAnims[0] = sequence.AnimationBlends[3].data();
+				blendAnims[1] = sequence.AnimationBlends[4].data();
+				blendAnims[2] = sequence.AnimationBlends[6].data();
+				blendAnims[3] = sequence.AnimationBlends[7].data();
 			}
 		}
 
+		CalculateBlendRotations(studioModel, transformInfo, sequence, blendAnims, 4);
+
 		const auto normalizedInterpolantX = interpolantX / 255.0;
 		SlerpBones(studioModel, normalizedInterpolantX, _transformStates[1], _transformStates[0]);
 		SlerpBones(studioModel, normalizedInterpolantX, _transformStates[3], _transformStates[2]);
@@ -90,20 +96,30 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 	}
 	else if (sequence.AnimationBlends.size() > 0)
 	{
-		CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[0].data(), _transformStates[0]);
+		blendAnims[0] = sequence.AnimationBlends[0].data();
 
 		if (sequence.AnimationBlends.size() > 1)
 		{
-			CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[1]);
+			blendAnims[1] = sequence.AnimationBlends[1].data();
+
+			if (sequence.AnimationBlends[0].size() == 4)
+			{
+				blendAnims[2] = sequence.AnimationBlends[2].data();
+				blendAnims[3] = sequence.AnimationBlends[3].data();
+
+				CalculateBlendRotations(studioModel, transformInfo, sequence, blendAnims, 4);
+			}
+			else
+			{
+				CalculateBlendRotations(studioModel, transformInfo, sequence, blendAnims, 2);
+			}
+
 			float s = transformInfo.Blenders[0] / 255.0;
 
 			SlerpBones(studioModel, s, _transformStates[1], _transformStates[0]);
 
 			if (sequence.AnimationBlends[0].size() == 4)
 			{
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[2].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[3]);
-
 				s = transformInfo.Blenders[0] / 255.0;
 				SlerpBones(studioModel, s, _transformStates[3], _transformStates[2]);
 
@@ -111,68 +127,121 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 				SlerpBones(studioModel, s, _transformStates[2], _transformStates[0]);
 			}
 		}
+		else
+		{
+			CalculateBlendRotations(studioModel, transformInfo, sequence, blendAnims, 1);
+		}
 	}
 	else
 	{
 		std::array<StudioAnimation, MAXSTUDIOBONES> dummyAnims;
 
-		CalculateRotations(studioModel, transformInfo, sequence, dummyAnims.data(), _transformStates[0]);
+		blendAnims[0] = dummyAnims.data();
+
+		CalculateBlendRotations(studioModel, transformInfo, sequence, blendAnims, 1);
 	}
 
-	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
+	const std::size_t boneCount = studioModel.Bones.size();
+
+	QuaternionsToMatrices(
+		_transformStates[0].GetQuaternions(), _transformStates[0].GetPositions(), _localBoneTransform.data(), boneCount);
+
+	//Apply scale to each root bone so only the model is scaled and mirrored, and not anything else in the scene
+	//Apply the scale *after* the root bone's position and rotation is set so the mirror effect occurs in the correct coordinate space
+	const auto scaleMatrix = glm::scale(transformInfo.Scale);
+
+	for (std::size_t i = 0; i < boneCount; ++i)
 	{
 		const auto& bone = *studioModel.Bones[i];
 
-		const auto bonematrix = glm::translate(_transformStates[0].Positions[i]) * glm::toMat4(_transformStates[0].Quaternions[i]);
+		const auto& parentMatrix = bone.Parent ? _boneTransform[bone.Parent->ArrayIndex] : scaleMatrix;
 
-		if (!bone.Parent)
-		{
-			//Apply scale to each root bone so only the model is scaled and mirrored, and not anything else in the scene
-			//Apply the scale *after* the root bone's position and rotation is set so the mirror effect occurs in the correct coordinate space
-			_boneTransform[i] = glm::scale(transformInfo.Scale) * bonematrix;
-		}
-		else
+		MultiplyMatrices(parentMatrix, _localBoneTransform[i], _boneTransform[i]);
+	}
+
+	return _boneTransform;
+}
+
+void BoneTransformer::CalculateBlendRotations(
+	const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo, const StudioSequence& sequence,
+	const std::array<const StudioAnimation*, TransformStatesCount>& blendAnims, const std::size_t blendCount)
+{
+	// add in programatic controllers
+	std::array<float, MAXSTUDIOCONTROLLERS> boneAdjust;
+	CalculateBoneAdjust(studioModel, transformInfo, boneAdjust);
+
+	const std::size_t boneCount = studioModel.Bones.size();
+
+	if (!_threadPool || _threadPool->GetThreadCount() == 0 || boneCount <= ParallelBoneCountThreshold)
+	{
+		for (std::size_t blend = 0; blend < blendCount; ++blend)
 		{
-			_boneTransform[i] = _boneTransform[bone.Parent->ArrayIndex] * bonematrix;
+			CalculateRotations(studioModel, transformInfo, boneAdjust, blendAnims[blend], 0, boneCount, _transformStates[blend]);
+			ApplyMotionType(sequence, _transformStates[blend]);
 		}
+
+		return;
 	}
 
-	return _boneTransform;
+	// Split each blend into bone ranges so there is one task per thread, including the calling thread.
+	// Every task writes to its own range of its own transform state so the result does not depend on scheduling.
+	const std::size_t threadCount = _threadPool->GetThreadCount() + 1;
+	const std::size_t rangesPerBlend = std::max<std::size_t>(1, threadCount / blendCount);
+	const std::size_t bonesPerRange = (boneCount + rangesPerBlend - 1) / rangesPerBlend;
+
+	_threadPool->ParallelFor(blendCount * rangesPerBlend, [&](std::size_t task)
+		{
+			const std::size_t blend = task / rangesPerBlend;
+			const std::size_t firstBone = (task % rangesPerBlend) * bonesPerRange;
+			const std::size_t lastBone = std::min(firstBone + bonesPerRange, boneCount);
+
+			CalculateRotations(studioModel, transformInfo, boneAdjust, blendAnims[blend], firstBone, lastBone, _transformStates[blend]);
+		});
+
+	for (std::size_t blend = 0; blend < blendCount; ++blend)
+	{
+		ApplyMotionType(sequence, _transformStates[blend]);
+	}
 }
 
 void BoneTransformer::CalculateRotations(
 	const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
-	const StudioSequence& sequence, const StudioAnimation* anims, TransformState& transformState)
+	const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, const StudioAnimation* anims,
+	std::size_t firstBone, std::size_t lastBone, TransformState& transformState)
 {
 	const int frame = (int)transformInfo.Frame;
 	const float s = (transformInfo.Frame - frame);
 
-	// add in programatic controllers
-	std::array<float, MAXSTUDIOCONTROLLERS> boneAdjust;
-	CalculateBoneAdjust(studioModel, transformInfo, boneAdjust);
-
-	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
+	for (std::size_t i = firstBone; i < lastBone; ++i)
 	{
 		const auto& bone = *studioModel.Bones[i];
 		const auto& anim = anims[i];
 
-		CalculateBoneQuaternion(frame, s, bone, anim, boneAdjust, transformState.Quaternions[i]);
-		CalculateBonePosition(frame, s, bone, anim, boneAdjust, transformState.Positions[i]);
+		glm::quat quaternion;
+		glm::vec3 position;
+
+		CalculateBoneQuaternion(frame, s, bone, anim, boneAdjust, quaternion);
+		CalculateBonePosition(frame, s, bone, anim, boneAdjust, position);
+
+		transformState.Set(i, position, quaternion);
 	}
+}
 
+void BoneTransformer::ApplyMotionType(const StudioSequence& sequence, TransformState& transformState)
+{
 	if (sequence.MotionType & STUDIO_X)
 	{
-		transformState.Positions[sequence.MotionBone][0] = 0.0;
+		transformState.PositionX[sequence.MotionBone] = 0.0;
 	}
 
 	if (sequence.MotionType & STUDIO_Y)
 	{
-		transformState.Positions[sequence.MotionBone][1] = 0.0;
+		transformState.PositionY[sequence.MotionBone] = 0.0;
 	}
 
 	if (sequence.MotionType & STUDIO_Z)
 	{
-		transformState.Positions[sequence.MotionBone][2] = 0.0;
+		transformState.PositionZ[sequence.MotionBone] = 0.0;
 	}
 }
 
@@ -370,13 +439,9 @@ void BoneTransformer::SlerpBones(
 {
 	s = std::clamp(s, 0.0f, 1.0f);
 
-	const float s1 = 1.0 - s;
+	const std::size_t boneCount = studioModel.Bones.size();
 
-	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
-	{
-		toState.Quaternions[i] = glm::slerp(toState.Quaternions[i], fromState.Quaternions[i], s);
-
-		toState.Positions[i] = toState.Positions[i] * s1 + fromState.Positions[i] * s;
-	}
+	SlerpQuaternions(toState.GetQuaternions(), fromState.GetQuaternions(), s, boneCount);
+	LerpVectors(toState.GetPositions(), fromState.GetPositions(), s, boneCount);
 }
 }
@@ -12,6 +12,10 @@
 
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 
+#include "utility/SIMDMath.hpp"
+
+class ThreadPool;
+
 namespace studiomdl
 {
 struct StudioAnimation;
@@ -34,17 +38,72 @@ struct BoneTransformInfo
 */
 class BoneTransformer final
 {
+public:
+	/**
+	*	@brief Models with more bones than this have their blends evaluated on the thread pool, if one was provided.
+	*	Below this the cost of waking the workers outweighs the work itself.
+	*/
+	static constexpr std::size_t ParallelBoneCountThreshold = 48;
+
 private:
 	static constexpr std::size_t TransformStatesCount = 4;
 
+	/**
+	*	@brief Positions and rotations stored as a structure of arrays so blending can process several bones at once.
+	*/
 	struct TransformState
 	{
-		std::array<glm::vec3, MAXSTUDIOBONES> Positions;
-		std::array<glm::quat, MAXSTUDIOBONES> Quaternions;
+		alignas(16) std::array<float, MAXSTUDIOBONES> PositionX;
+		alignas(16) std::array<float, MAXSTUDIOBONES> PositionY;
+		alignas(16) std::array<float, MAXSTUDIOBONES> PositionZ;
+
+		alignas(16) std::array<float, MAXSTUDIOBONES> QuaternionX;
+		alignas(16) std::array<float, MAXSTUDIOBONES> QuaternionY;
+		alignas(16) std::array<float, MAXSTUDIOBONES> QuaternionZ;
+		alignas(16) std::array<float, MAXSTUDIOBONES> QuaternionW;
+
+		void Set(std::size_t index, const glm::vec3& position, const glm::quat& quaternion)
+		{
+			PositionX[index] = position.x;
+			PositionY[index] = position.y;
+			PositionZ[index] = position.z;
+
+			QuaternionX[index] = quaternion.x;
+			QuaternionY[index] = quaternion.y;
+			QuaternionZ[index] = quaternion.z;
+			QuaternionW[index] = quaternion.w;
+		}
+
+		Vector3Arrays GetPositions()
+		{
+			return {PositionX.data(), PositionY.data(), PositionZ.data()};
+		}
+
+		ConstVector3Arrays GetPositions() const
+		{
+			return {PositionX.data(), PositionY.data(), PositionZ.data()};
+		}
+
+		QuaternionArrays GetQuaternions()
+		{
+			return {QuaternionX.data(), QuaternionY.data(), QuaternionZ.data(), QuaternionW.data()};
+		}
+
+		ConstQuaternionArrays GetQuaternions() const
+		{
+			return {QuaternionX.data(), QuaternionY.data(), QuaternionZ.data(), QuaternionW.data()};
+		}
 	};
 
 public:
-	BoneTransformer() = default;
+	/**
+	*	@param threadPool Optional pool used to evaluate blends in parallel. Results are identical with or without it.
+	*/
+	explicit BoneTransformer(ThreadPool* threadPool = nullptr)
+		: _threadPool(threadPool)
+	{
+	}
+
 	~BoneTransformer() = default;
 
 	/**
@@ -55,9 +114,19 @@ public:
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo);
 
 private:
+	/**
+	*	@brief Evaluates each of the given animation blends into the transform state with the same index.
+	*/
+	void CalculateBlendRotations(
+		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo, const StudioSequence& sequence,
+		const std::array<const StudioAnimation*, TransformStatesCount>& blendAnims, const std::size_t blendCount);
+
 	static void CalculateRotations(
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
-		const StudioSequence& sequence, const StudioAnimation* anims, TransformState& transformState);
+		const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, const StudioAnimation* anims,
+		std::size_t firstBone, std::size_t lastBone, TransformState& transformState);
+
+	static void ApplyMotionType(const StudioSequence& sequence, TransformState& transformState);
 
 	static void CalculateBoneAdjust(
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
@@ -72,9 +141,14 @@ private:
 		const EditableStudioModel& studioModel, float s, const TransformState& fromState, TransformState& toState);
 
 private:
+	ThreadPool* const _threadPool;
+
 	//Used to store temporary calculations before calculating final values stored in _boneTransform
 	std::array<TransformState, TransformStatesCount> _transformStates{};
 
+	//Bone transforms relative to their parent
+	std::array<glm::mat4x4, MAXSTUDIOBONES> _localBoneTransform{};
+
 	std::array<glm::mat4x4, MAXSTUDIOBONES> _boneTransform{};
 };
 }
@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <cassert>
 #include <limits>
 
 #include <glm/gtc/quaternion.hpp>
@@ -8,9 +7,6 @@
 #include "formats/studiomodel/BoneTransformer.hpp"
 #include "formats/studiomodel/EditableStudioModel.hpp"
 
-#include "graphics/GraphicsUtils.hpp"
-#include "graphics/TextureLoader.hpp"
-
 #include "utility/mathlib.hpp"
 
 namespace studiomdl
@@ -97,83 +93,6 @@ std::vector<const StudioMesh*> EditableStudioModel::ComputeMeshList(const int te
 	return meshes;
 }
 
-void EditableStudioModel::CreateTextures(graphics::TextureLoader& textureLoader)
-{
-	assert(TextureHandles.empty());
-
-	TextureHandles.resize(Textures.size(), GL_INVALID_TEXTURE_ID);
-
-	for (auto& textureId : TextureHandles)
-	{
-		textureId = textureLoader.CreateTexture();
-	}
-
-	UpdateTextures(textureLoader);
-}
-
-void EditableStudioModel::UpdateTexture(graphics::TextureLoader& textureLoader, std::size_t index)
-{
-	if (index >= Textures.size())
-	{
-		assert(false);
-		return;
-	}
-
-	auto& texture = *Textures[index];
-
-	graphics::RGBPalette palette{texture.Data.Palette};
-
-	int low, mid, high;
-
-	if (graphics::TryGetRemapColors(texture.Name, low, mid, high))
-	{
-		graphics::PaletteHueReplace(palette, TopColor, low, mid);
-
-		if (high)
-		{
-			graphics::PaletteHueReplace(palette, BottomColor, mid + 1, high);
-		}
-	}
-
-	textureLoader.UploadIndexed8(
-		TextureHandles[index],
-		texture.Data.Width, texture.Data.Height,
-		texture.Data.Pixels.data(),
-		palette,
-		(texture.Flags & STUDIO_NF_MIPMAPS) != 0,
-		(texture.Flags & STUDIO_NF_MASKED) != 0);
-}
-
-void EditableStudioModel::UpdateTextures(graphics::TextureLoader& textureLoader)
-{
-	for (std::size_t index = 0; index < Textures.size(); ++index)
-	{
-		UpdateTexture(textureLoader, index);
-	}
-}
-
-void EditableStudioModel::DeleteTextures(graphics::TextureLoader& textureLoader)
-{
-	for (auto& textureId : TextureHandles)
-	{
-		textureLoader.DeleteTexture(textureId);
-		textureId = GL_INVALID_TEXTURE_ID;
-	}
-
-	TextureHandles.clear();
-}
-
-void EditableStudioModel::UpdateFilters(graphics::TextureLoader& textureLoader)
-{
-	for (std::size_t i = 0; i < Textures.size(); ++i)
-	{
-		if (TextureHandles[i] != GL_INVALID_TEXTURE_ID)
-		{
-			textureLoader.SetFilters(TextureHandles[i], (Textures[i]->Flags & STUDIO_NF_MIPMAPS) != 0);
-		}
-	}
-}
-
 glm::vec3 FindAverageOfRootBones(const EditableStudioModel& studioModel)
 {
 	glm::vec3 center{0};
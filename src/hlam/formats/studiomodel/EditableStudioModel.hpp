@@ -12,7 +12,6 @@
 #include <glm/vec3.hpp>
 
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
-#include "graphics/OpenGL.hpp"
 #include "graphics/Palette.hpp"
 
 namespace graphics
@@ -234,7 +233,8 @@ public:
 	std::vector<std::vector<std::uint8_t>> Transitions;
 
 	// In-memory state.
-	std::vector<GLuint> TextureHandles;
+	// OpenGL texture names, stored as unsigned int so this header does not depend on OpenGL.
+	std::vector<unsigned int> TextureHandles;
 
 	// Used for remapping; not stored in the model.
 	int TopColor = 0;
@@ -254,6 +254,14 @@ public:
 
 	void CreateTextures(graphics::TextureLoader& textureLoader);
 
+	/**
+	*	Creates textures, taking over the textures of @p previous that are identical instead of uploading them again.
+	*	Textures of @p previous that are not taken over are deleted.
+	*	@param textureSources For each texture, the index of the identical texture in @p previous, if any.
+	*/
+	void CreateTexturesFrom(graphics::TextureLoader& textureLoader, EditableStudioModel& previous,
+		const std::vector<std::optional<std::size_t>>& textureSources);
+
 	/**
 	*	(Re)uploads a texture. Useful for making changes made to the texture's pixel, palette or flag data show up in the model itself.
 	* *	@param textureLoader Loader to use for texture uploading
@@ -0,0 +1,118 @@
+#include <cassert>
+#include <utility>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+
+#include "graphics/ImageUtils.hpp"
+#include "graphics/OpenGL.hpp"
+#include "graphics/TextureLoader.hpp"
+
+// Texture upload needs an OpenGL context, so it lives outside the core library.
+namespace studiomdl
+{
+void EditableStudioModel::CreateTextures(graphics::TextureLoader& textureLoader)
+{
+	assert(TextureHandles.empty());
+
+	TextureHandles.resize(Textures.size(), GL_INVALID_TEXTURE_ID);
+
+	for (auto& textureId : TextureHandles)
+	{
+		textureId = textureLoader.CreateTexture();
+	}
+
+	UpdateTextures(textureLoader);
+}
+
+void EditableStudioModel::CreateTexturesFrom(graphics::TextureLoader& textureLoader, EditableStudioModel& previous,
+	const std::vector<std::optional<std::size_t>>& textureSources)
+{
+	assert(TextureHandles.empty());
+	assert(textureSources.size() == Textures.size());
+
+	// Remapped textures are uploaded with the model's colors applied, so they can only be reused if those match.
+	const bool canReuseTextures = TopColor == previous.TopColor && BottomColor == previous.BottomColor;
+
+	TextureHandles.resize(Textures.size(), GL_INVALID_TEXTURE_ID);
+
+	for (std::size_t index = 0; index < Textures.size(); ++index)
+	{
+		if (const auto source = textureSources[index];
+			canReuseTextures && source && *source < previous.TextureHandles.size())
+		{
+			TextureHandles[index] = std::exchange(previous.TextureHandles[*source], GL_INVALID_TEXTURE_ID);
+		}
+
+		if (TextureHandles[index] == GL_INVALID_TEXTURE_ID)
+		{
+			TextureHandles[index] = textureLoader.CreateTexture();
+			UpdateTexture(textureLoader, index);
+		}
+	}
+
+	previous.DeleteTextures(textureLoader);
+}
+
+void EditableStudioModel::UpdateTexture(graphics::TextureLoader& textureLoader, std::size_t index)
+{
+	if (index >= Textures.size())
+	{
+		assert(false);
+		return;
+	}
+
+	auto& texture = *Textures[index];
+
+	graphics::RGBPalette palette{texture.Data.Palette};
+
+	int low, mid, high;
+
+	if (graphics::TryGetRemapColors(texture.Name, low, mid, high))
+	{
+		graphics::PaletteHueReplace(palette, TopColor, low, mid);
+
+		if (high)
+		{
+			graphics::PaletteHueReplace(palette, BottomColor, mid + 1, high);
+		}
+	}
+
+	textureLoader.UploadIndexed8(
+		TextureHandles[index],
+		texture.Data.Width, texture.Data.Height,
+		texture.Data.Pixels.data(),
+		palette,
+		(texture.Flags & STUDIO_NF_MIPMAPS) != 0,
+		(texture.Flags & STUDIO_NF_MASKED) != 0);
+}
+
+void EditableStudioModel::UpdateTextures(graphics::TextureLoader& textureLoader)
+{
+	for (std::size_t index = 0; index < Textures.size(); ++index)
+	{
+		UpdateTexture(textureLoader, index);
+	}
+}
+
+void EditableStudioModel::DeleteTextures(graphics::TextureLoader& textureLoader)
+{
+	for (auto& textureId : TextureHandles)
+	{
+		textureLoader.DeleteTexture(textureId);
+		textureId = GL_INVALID_TEXTURE_ID;
+	}
+
+	TextureHandles.clear();
+}
+
+void EditableStudioModel::UpdateFilters(graphics::TextureLoader& textureLoader)
+{
+	for (std::size_t i = 0; i < Textures.size(); ++i)
+	{
+		if (TextureHandles[i] != GL_INVALID_TEXTURE_ID)
+		{
+			textureLoader.SetFilters(TextureHandles[i], (Textures[i]->Flags & STUDIO_NF_MIPMAPS) != 0);
+		}
+	}
+}
+}
@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/MeshOptimization.hpp"
+
+#include "utility/ThreadPool.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+/**
+*	@brief Vertex index, normal index and texture coordinates.
+*/
+constexpr int ValuesPerVertex = 4;
+
+/**
+*	@brief The number of vertices in a strip or fan is stored in a short.
+*/
+constexpr std::size_t MaximumCommandVertices = std::numeric_limits<short>::max();
+
+using VertexValues = std::array<short, ValuesPerVertex>;
+using Triangle = std::array<std::uint32_t, 3>;
+
+struct DecodedMesh
+{
+	/**
+	*	@brief Unique combinations of vertex, normal and texture coordinates.
+	*/
+	std::vector<VertexValues> Vertices;
+
+	/**
+	*	@brief Triangles in the winding they are drawn with.
+	*/
+	std::vector<Triangle> Triangles;
+};
+
+std::optional<DecodedMesh> DecodeTriangleCommands(const std::vector<short>& commands)
+{
+	DecodedMesh mesh;
+
+	std::map<VertexValues, std::uint32_t> vertexIndices;
+
+	const auto getVertex = [&](std::size_t position)
+	{
+		VertexValues values;
+		std::copy_n(commands.begin() + position, ValuesPerVertex, values.begin());
+
+		const auto [it, inserted] = vertexIndices.try_emplace(values, static_cast<std::uint32_t>(mesh.Vertices.size()));
+
+		if (inserted)
+		{
+			mesh.Vertices.push_back(values);
+		}
+
+		return it->second;
+	};
+
+	std::size_t position = 0;
+
+	while (true)
+	{
+		if (position >= commands.size())
+		{
+			return {};
+		}
+
+		int count = commands[position++];
+
+		if (count == 0)
+		{
+			break;
+		}
+
+		const bool isFan = count < 0;
+
+		count = std::abs(count);
+
+		if (static_cast<std::size_t>(count) * ValuesPerVertex > commands.size() - position)
+		{
+			return {};
+		}
+
+		std::uint32_t first = 0;
+		std::uint32_t previous = 0;
+		std::uint32_t beforePrevious = 0;
+
+		for (int i = 0; i < count; ++i, position += ValuesPerVertex)
+		{
+			const auto vertex = getVertex(position);
+
+			if (i == 0)
+			{
+				first = vertex;
+			}
+			else if (i >= 2)
+			{
+				// Every other triangle in a strip has its first two vertices swapped to keep the winding consistent.
+				if (isFan)
+				{
+					mesh.Triangles.push_back({first, previous, vertex});
+				}
+				else if ((i % 2) == 0)
+				{
+					mesh.Triangles.push_back({beforePrevious, previous, vertex});
+				}
+				else
+				{
+					mesh.Triangles.push_back({previous, beforePrevious, vertex});
+				}
+			}
+
+			beforePrevious = previous;
+			previous = vertex;
+		}
+	}
+
+	// Anything after the terminator is never drawn, but leave such meshes alone rather than dropping data.
+	if (position != commands.size())
+	{
+		return {};
+	}
+
+	return mesh;
+}
+
+struct TriangleCommand
+{
+	bool IsFan{};
+	std::vector<std::uint32_t> Vertices;
+	std::vector<std::uint32_t> Triangles;
+};
+
+/**
+*	@brief Greedily covers triangles with strips and fans.
+*	Each command starts at the unused triangle with the fewest unused neighbors,
+*	preferring triangles next to the previous command.
+*	Starting from the triangles that are hardest to reach leaves fewer isolated triangles at the end.
+*	Strips and fans are grown in both directions from the starting triangle, and only across edges
+*	where the neighbor has the winding the strip or fan would draw it with.
+*/
+class Stripifier final
+{
+public:
+	explicit Stripifier(const std::vector<Triangle>& triangles)
+		: _triangles(triangles)
+		, _used(triangles.size(), false)
+		, _stamps(triangles.size(), 0)
+		, _degrees(triangles.size(), 0)
+	{
+		_edges.reserve(_triangles.size() * 3);
+
+		for (std::uint32_t triangle = 0; triangle < _triangles.size(); ++triangle)
+		{
+			for (std::uint32_t corner = 0; corner < 3; ++corner)
+			{
+				_edges.push_back({GetEdgeKey(_triangles[triangle][corner], _triangles[triangle][(corner + 1) % 3]),
+					triangle, corner});
+			}
+		}
+
+		std::sort(_edges.begin(), _edges.end(), [](const auto& lhs, const auto& rhs)
+			{
+				return std::tie(lhs.Key, lhs.Triangle) < std::tie(rhs.Key, rhs.Triangle);
+			});
+
+		for (std::uint32_t triangle = 0; triangle < _triangles.size(); ++triangle)
+		{
+			ForEachNeighbor(triangle, [&](std::uint32_t) { ++_degrees[triangle]; });
+			_seeds.push({_degrees[triangle], triangle});
+		}
+	}
+
+	std::vector<TriangleCommand> Build()
+	{
+		std::vector<TriangleCommand> commands;
+
+		std::vector<std::uint32_t> nearbySeeds;
+
+		while (true)
+		{
+			const auto seed = GetNextSeed(nearbySeeds);
+
+			if (!seed)
+			{
+				break;
+			}
+
+			TriangleCommand best;
+
+			for (std::uint32_t corner = 0; corner < 3; ++corner)
+			{
+				if (auto strip = BuildStrip(*seed, corner); strip.Triangles.size() > best.Triangles.size())
+				{
+					best = std::move(strip);
+				}
+			}
+
+			for (std::uint32_t corner = 0; corner < 3; ++corner)
+			{
+				if (auto fan = BuildFan(*seed, corner); fan.Triangles.size() > best.Triangles.size())
+				{
+					best = std::move(fan);
+				}
+			}
+
+			nearbySeeds.clear();
+
+			for (const auto triangle : best.Triangles)
+			{
+				_used[triangle] = true;
+			}
+
+			for (const auto triangle : best.Triangles)
+			{
+				ForEachNeighbor(triangle, [&](std::uint32_t neighbor)
+					{
+						--_degrees[neighbor];
+						_seeds.push({_degrees[neighbor], neighbor});
+						nearbySeeds.push_back(neighbor);
+					});
+			}
+
+			commands.push_back(std::move(best));
+		}
+
+		return commands;
+	}
+
+private:
+	struct Edge
+	{
+		std::uint64_t Key;
+		std::uint32_t Triangle;
+		std::uint32_t Corner;
+	};
+
+	static std::uint64_t GetEdgeKey(std::uint32_t from, std::uint32_t to)
+	{
+		return (static_cast<std::uint64_t>(from) << 32) | to;
+	}
+
+	std::pair<std::vector<Edge>::const_iterator, std::vector<Edge>::const_iterator> FindEdges(
+		std::uint32_t from, std::uint32_t to) const
+	{
+		const auto key = GetEdgeKey(from, to);
+
+		return {
+			std::lower_bound(_edges.begin(), _edges.end(), key, [](const Edge& edge, std::uint64_t key) { return edge.Key < key; }),
+			std::upper_bound(_edges.begin(), _edges.end(), key, [](std::uint64_t key, const Edge& edge) { return key < edge.Key; })};
+	}
+
+	/**
+	*	@brief Invokes @p callback for every unused triangle that shares an edge with @p triangle in the opposite direction.
+	*/
+	void ForEachNeighbor(std::uint32_t triangle, const std::function<void(std::uint32_t)>& callback) const
+	{
+		for (std::uint32_t corner = 0; corner < 3; ++corner)
+		{
+			const auto [begin, end] = FindEdges(_triangles[triangle][(corner + 1) % 3], _triangles[triangle][corner]);
+
+			for (auto it = begin; it != end; ++it)
+			{
+				if (it->Triangle != triangle && !_used[it->Triangle])
+				{
+					callback(it->Triangle);
+				}
+			}
+		}
+	}
+
+	/**
+	*	@brief Finds an available triangle that contains the directed edge @p from -> @p to and marks it as part of
+	*	the command being built.
+	*/
+	std::optional<std::pair<std::uint32_t, std::uint32_t>> TakeTriangle(std::uint32_t from, std::uint32_t to)
+	{
+		const auto [begin, end] = FindEdges(from, to);
+
+		for (auto it = begin; it != end; ++it)
+		{
+			if (!_used[it->Triangle] && _stamps[it->Triangle] != _stamp)
+			{
+				_stamps[it->Triangle] = _stamp;
+				return std::pair{it->Triangle, _triangles[it->Triangle][(it->Corner + 2) % 3]};
+			}
+		}
+
+		return {};
+	}
+
+	TriangleCommand BuildStrip(std::uint32_t seed, std::uint32_t corner)
+	{
+		++_stamp;
+		_stamps[seed] = _stamp;
+
+		const auto& triangle = _triangles[seed];
+
+		std::deque<std::uint32_t> vertices{triangle[corner], triangle[(corner + 1) % 3], triangle[(corner + 2) % 3]};
+		std::deque<std::uint32_t> triangles{seed};
+
+		// Triangles at odd positions are drawn with their first two vertices swapped,
+		// so the edge the next triangle has to share alternates direction.
+		while (vertices.size() < MaximumCommandVertices)
+		{
+			const auto first = vertices[vertices.size() - 2];
+			const auto second = vertices[vertices.size() - 1];
+			const bool isEven = ((vertices.size() - 2) % 2) == 0;
+
+			const auto next = isEven ? TakeTriangle(first, second) : TakeTriangle(second, first);
+
+			if (!next)
+			{
+				break;
+			}
+
+			triangles.push_back(next->first);
+			vertices.push_back(next->second);
+		}
+
+		std::size_t prepended = 0;
+
+		while (vertices.size() < MaximumCommandVertices)
+		{
+			const auto first = vertices[0];
+			const auto second = vertices[1];
+			// Positions count backwards from the seed, so the first prepended triangle is at an odd position.
+			const bool isOddPosition = (prepended % 2) == 0;
+
+			const auto previous = isOddPosition ? TakeTriangle(second, first) : TakeTriangle(first, second);
+
+			if (!previous)
+			{
+				break;
+			}
+
+			triangles.push_front(previous->first);
+			vertices.push_front(previous->second);
+			++prepended;
+		}
+
+		// Prepending an odd number of triangles would flip the winding of the rest of the strip.
+		if ((prepended % 2) != 0)
+		{
+			_stamps[triangles.front()] = 0;
+			triangles.pop_front();
+			vertices.pop_front();
+		}
+
+		return {false, {vertices.begin(), vertices.end()}, {triangles.begin(), triangles.end()}};
+	}
+
+	TriangleCommand BuildFan(std::uint32_t seed, std::uint32_t corner)
+	{
+		++_stamp;
+		_stamps[seed] = _stamp;
+
+		const auto& triangle = _triangles[seed];
+
+		const auto center = triangle[corner];
+
+		std::deque<std::uint32_t> rim{triangle[(corner + 1) % 3], triangle[(corner + 2) % 3]};
+		std::deque<std::uint32_t> triangles{seed};
+
+		while ((rim.size() + 1) < MaximumCommandVertices)
+		{
+			const auto next = TakeTriangle(center, rim.back());
+
+			if (!next)
+			{
+				break;
+			}
+
+			triangles.push_back(next->first);
+			rim.push_back(next->second);
+		}
+
+		while ((rim.size() + 1) < MaximumCommandVertices)
+		{
+			const auto previous = TakeTriangle(rim.front(), center);
+
+			if (!previous)
+			{
+				break;
+			}
+
+			triangles.push_front(previous->first);
+			rim.push_front(previous->second);
+		}
+
+		TriangleCommand fan{true, {center}, {triangles.begin(), triangles.end()}};
+		fan.Vertices.insert(fan.Vertices.end(), rim.begin(), rim.end());
+
+		return fan;
+	}
+
+	std::optional<std::uint32_t> GetNextSeed(const std::vector<std::uint32_t>& nearbySeeds)
+	{
+		std::optional<std::uint32_t> seed;
+
+		for (const auto triangle : nearbySeeds)
+		{
+			if (!_used[triangle] && (!seed || _degrees[triangle] < _degrees[*seed]
+				|| (_degrees[triangle] == _degrees[*seed] && triangle < *seed)))
+			{
+				seed = triangle;
+			}
+		}
+
+		if (seed)
+		{
+			return seed;
+		}
+
+		// Entries are not removed when a triangle's degree changes, so skip the outdated ones.
+		while (!_seeds.empty())
+		{
+			const auto [degree, triangle] = _seeds.top();
+			_seeds.pop();
+
+			if (!_used[triangle] && degree == _degrees[triangle])
+			{
+				return triangle;
+			}
+		}
+
+		return {};
+	}
+
+private:
+	const std::vector<Triangle>& _triangles;
+
+	std::vector<Edge> _edges;
+
+	std::vector<bool> _used;
+
+	/**
+	*	@brief Marks the triangles in the command being built.
+	*/
+	std::vector<std::uint32_t> _stamps;
+	std::uint32_t _stamp{};
+
+	/**
+	*	@brief Number of unused neighbors of each triangle.
+	*/
+	std::vector<std::uint32_t> _degrees;
+
+	std::priority_queue<std::pair<std::uint32_t, std::uint32_t>,
+		std::vector<std::pair<std::uint32_t, std::uint32_t>>, std::greater<>> _seeds;
+};
+}
+
+TriangleCommandStats GetTriangleCommandStats(const std::vector<short>& commands)
+{
+	TriangleCommandStats stats;
+
+	std::size_t position = 0;
+
+	while (position < commands.size())
+	{
+		const int count = commands[position++];
+
+		if (count == 0)
+		{
+			break;
+		}
+
+		if (count < 0)
+		{
+			++stats.Fans;
+		}
+		else
+		{
+			++stats.Strips;
+		}
+
+		stats.Triangles += std::max(0, std::abs(count) - 2);
+
+		position += static_cast<std::size_t>(std::abs(count)) * ValuesPerVertex;
+	}
+
+	return stats;
+}
+
+std::optional<std::vector<short>> OptimizeTriangleCommands(const std::vector<short>& commands)
+{
+	const auto mesh = DecodeTriangleCommands(commands);
+
+	if (!mesh)
+	{
+		return {};
+	}
+
+	const auto triangleCommands = Stripifier{mesh->Triangles}.Build();
+
+	if (triangleCommands.size() >= static_cast<std::size_t>(GetTriangleCommandStats(commands).GetCommandCount()))
+	{
+		return {};
+	}
+
+	std::vector<short> result;
+
+	for (const auto& command : triangleCommands)
+	{
+		const auto count = static_cast<short>(command.Vertices.size());
+
+		result.push_back(command.IsFan ? -count : count);
+
+		for (const auto vertex : command.Vertices)
+		{
+			const auto& values = mesh->Vertices[vertex];
+			result.insert(result.end(), values.begin(), values.end());
+		}
+	}
+
+	result.push_back(0);
+
+	return result;
+}
+
+std::vector<std::vector<short>> GetTriangleCommands(const EditableStudioModel& studioModel)
+{
+	std::vector<std::vector<short>> commands;
+
+	for (const auto& bodypart : studioModel.Bodyparts)
+	{
+		for (const auto& model : bodypart->Models)
+		{
+			for (const auto& mesh : model.Meshes)
+			{
+				commands.push_back(mesh.Triangles);
+			}
+		}
+	}
+
+	return commands;
+}
+
+void ApplyTriangleCommands(EditableStudioModel& studioModel, const std::vector<std::vector<short>>& commands)
+{
+	std::size_t index = 0;
+
+	for (auto& bodypart : studioModel.Bodyparts)
+	{
+		for (auto& model : bodypart->Models)
+		{
+			for (auto& mesh : model.Meshes)
+			{
+				assert(index < commands.size());
+				mesh.Triangles = commands[index++];
+			}
+		}
+	}
+
+	assert(index == commands.size());
+}
+
+MeshOptimizationResult OptimizeMeshes(const EditableStudioModel& studioModel, ThreadPool* threadPool)
+{
+	MeshOptimizationResult result;
+
+	result.Commands = GetTriangleCommands(studioModel);
+
+	for (const auto& commands : result.Commands)
+	{
+		result.Before += GetTriangleCommandStats(commands);
+	}
+
+	// Not vector<bool>, which cannot be written to from multiple threads.
+	std::vector<char> optimized(result.Commands.size(), 0);
+
+	const auto optimizeMesh = [&](std::size_t index)
+	{
+		if (auto commands = OptimizeTriangleCommands(result.Commands[index]); commands)
+		{
+			result.Commands[index] = std::move(*commands);
+			optimized[index] = 1;
+		}
+	};
+
+	if (threadPool)
+	{
+		threadPool->ParallelFor(result.Commands.size(), optimizeMesh);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < result.Commands.size(); ++i)
+		{
+			optimizeMesh(i);
+		}
+	}
+
+	for (const auto& commands : result.Commands)
+	{
+		result.After += GetTriangleCommandStats(commands);
+	}
+
+	result.OptimizedMeshCount = static_cast<int>(std::count(optimized.begin(), optimized.end(), 1));
+
+	return result;
+}
+}
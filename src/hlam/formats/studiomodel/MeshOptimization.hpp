@@ -0,0 +1,78 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+class ThreadPool;
+
+namespace studiomdl
+{
+class EditableStudioModel;
+
+/**
+*	@brief Number of strips, fans and triangles in a mesh's triangle commands.
+*/
+struct TriangleCommandStats
+{
+	int Strips{};
+	int Fans{};
+	int Triangles{};
+
+	int GetCommandCount() const { return Strips + Fans; }
+
+	/**
+	*	@brief Average number of triangles drawn by each strip or fan.
+	*/
+	float GetAverageLength() const
+	{
+		const int count = GetCommandCount();
+		return count > 0 ? static_cast<float>(Triangles) / count : 0.f;
+	}
+
+	TriangleCommandStats& operator+=(const TriangleCommandStats& other)
+	{
+		Strips += other.Strips;
+		Fans += other.Fans;
+		Triangles += other.Triangles;
+		return *this;
+	}
+};
+
+TriangleCommandStats GetTriangleCommandStats(const std::vector<short>& commands);
+
+/**
+*	@brief Rebuilds triangle commands into as few strips and fans as possible.
+*	Every triangle is drawn with the same vertex, normal and texture coordinates and the same winding as before.
+*	Each strip or fan is started next to the previous one where possible,
+*	so consecutive commands reuse vertices that were transformed and lit recently.
+*	@return The new commands, or an empty optional if they are invalid or would not use fewer strips and fans.
+*/
+std::optional<std::vector<short>> OptimizeTriangleCommands(const std::vector<short>& commands);
+
+/**
+*	@brief Gets the triangle commands of every mesh, in body part, submodel and mesh order.
+*/
+std::vector<std::vector<short>> GetTriangleCommands(const EditableStudioModel& studioModel);
+
+void ApplyTriangleCommands(EditableStudioModel& studioModel, const std::vector<std::vector<short>>& commands);
+
+struct MeshOptimizationResult
+{
+	/**
+	*	@brief Triangle commands of every mesh, in the same order as GetTriangleCommands.
+	*	Meshes that could not be improved keep their commands.
+	*/
+	std::vector<std::vector<short>> Commands;
+
+	TriangleCommandStats Before;
+	TriangleCommandStats After;
+
+	int OptimizedMeshCount{};
+};
+
+/**
+*	@brief Optimizes the triangle commands of all meshes.
+*	@param threadPool Optional pool used to optimize meshes in parallel.
+*/
+MeshOptimizationResult OptimizeMeshes(const EditableStudioModel& studioModel, ThreadPool* threadPool);
+}
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <glm/common.hpp>
+
+#include "formats/studiomodel/BoneTransformer.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelBounds.hpp"
+
+#include "utility/SIMDMath.hpp"
+#include "utility/ThreadPool.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+/**
+*	@brief Frames evaluated by a single task. Sequences are split up so long sequences don't end up on one thread.
+*/
+constexpr int FramesPerTask = 8;
+
+const std::pair<glm::vec3, glm::vec3> EmptyBounds{
+	glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+
+/**
+*	@brief Range of vertices attached to a single bone.
+*/
+struct BoneVertices
+{
+	int Bone;
+	std::size_t First;
+	std::size_t Count;
+};
+
+struct BoundsTask
+{
+	int Sequence;
+	int FirstFrame;
+	int EndFrame;
+};
+
+void AddBounds(std::pair<glm::vec3, glm::vec3>& bounds, const std::pair<glm::vec3, glm::vec3>& other)
+{
+	bounds.first = glm::min(bounds.first, other.first);
+	bounds.second = glm::max(bounds.second, other.second);
+}
+
+/**
+*	@brief Gets the controller settings of a newly spawned entity, which sets all controllers to 0.
+*/
+std::array<std::uint8_t, ControllerCount> GetDefaultControllers(const EditableStudioModel& studioModel)
+{
+	std::array<std::uint8_t, ControllerCount> controllers{};
+
+	for (const auto& controller : studioModel.BoneControllers)
+	{
+		if (controller->Index < 0 || controller->Index >= ControllerCount || controller->End == controller->Start)
+		{
+			continue;
+		}
+
+		const int setting = static_cast<int>(255 * (0 - controller->Start) / (controller->End - controller->Start));
+
+		controllers[controller->Index] = static_cast<std::uint8_t>(std::clamp(setting, 0, 255));
+	}
+
+	return controllers;
+}
+
+std::vector<std::array<std::uint8_t, SequenceBlendCount>> GetBlenderSamples(const StudioSequence& sequence)
+{
+	if (sequence.AnimationBlends.size() <= 1)
+	{
+		return {std::array<std::uint8_t, SequenceBlendCount>{}};
+	}
+
+	// Blends are interpolated, so the ends and center of each axis cover the blend animations.
+	constexpr std::array<std::uint8_t, 3> Values{0, 127, 255};
+
+	std::vector<std::array<std::uint8_t, SequenceBlendCount>> samples;
+
+	for (const auto x : Values)
+	{
+		if (sequence.AnimationBlends.size() > 2)
+		{
+			for (const auto y : Values)
+			{
+				samples.push_back({x, y});
+			}
+		}
+		else
+		{
+			samples.push_back({x, 0});
+		}
+	}
+
+	return samples;
+}
+}
+
+StudioModelBounds GetBounds(const EditableStudioModel& studioModel)
+{
+	StudioModelBounds bounds;
+
+	bounds.Model = {studioModel.BoundingMin, studioModel.BoundingMax};
+	bounds.Sequences = GetScaleSequenceBBoxesData(studioModel);
+
+	return bounds;
+}
+
+void ApplyBounds(EditableStudioModel& studioModel, const StudioModelBounds& bounds)
+{
+	studioModel.BoundingMin = bounds.Model.first;
+	studioModel.BoundingMax = bounds.Model.second;
+
+	ApplyScaleSequenceBBoxesData(studioModel, bounds.Sequences, std::nullopt);
+}
+
+std::optional<StudioModelBounds> CalculateBounds(const EditableStudioModel& studioModel, ThreadPool* threadPool)
+{
+	if (studioModel.Sequences.empty())
+	{
+		return {};
+	}
+
+	// Group vertices by bone so each bone's vertices are transformed by the same matrix in one batch.
+	std::vector<std::vector<glm::vec3>> verticesByBone(studioModel.Bones.size());
+
+	for (const auto& bodyPart : studioModel.Bodyparts)
+	{
+		for (const auto& subModel : bodyPart->Models)
+		{
+			for (const auto& vertex : subModel.Vertices)
+			{
+				verticesByBone[vertex.Bone->ArrayIndex].push_back(vertex.Vertex);
+			}
+		}
+	}
+
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<BoneVertices> boneVertices;
+
+	for (std::size_t bone = 0; bone < verticesByBone.size(); ++bone)
+	{
+		const auto& vertices = verticesByBone[bone];
+
+		if (vertices.empty())
+		{
+			continue;
+		}
+
+		boneVertices.push_back({static_cast<int>(bone), x.size(), vertices.size()});
+
+		for (const auto& vertex : vertices)
+		{
+			x.push_back(vertex.x);
+			y.push_back(vertex.y);
+			z.push_back(vertex.z);
+		}
+	}
+
+	if (x.empty())
+	{
+		return {};
+	}
+
+	std::vector<BoundsTask> tasks;
+
+	for (int sequence = 0; sequence < studioModel.Sequences.size(); ++sequence)
+	{
+		const int frameCount = std::max(1, studioModel.Sequences[sequence]->NumFrames);
+
+		for (int frame = 0; frame < frameCount; frame += FramesPerTask)
+		{
+			tasks.push_back({sequence, frame, std::min(frameCount, frame + FramesPerTask)});
+		}
+	}
+
+	const auto controllers = GetDefaultControllers(studioModel);
+
+	std::vector<std::pair<glm::vec3, glm::vec3>> taskBounds(tasks.size(), EmptyBounds);
+
+	const auto evaluateTask = [&](std::size_t index)
+	{
+		const auto& task = tasks[index];
+		const auto& sequence = *studioModel.Sequences[task.Sequence];
+
+		// The transformer holds the pose being evaluated, so each task needs its own.
+		const auto boneTransformer = std::make_unique<BoneTransformer>();
+
+		auto& bounds = taskBounds[index];
+
+		for (const auto& blenders : GetBlenderSamples(sequence))
+		{
+			for (int frame = task.FirstFrame; frame < task.EndFrame; ++frame)
+			{
+				const auto& boneTransforms = boneTransformer->SetUpBones(studioModel,
+					{
+						task.Sequence,
+						static_cast<float>(frame),
+						glm::vec3{1},
+						blenders,
+						controllers,
+						0
+					});
+
+				for (const auto& range : boneVertices)
+				{
+					ExpandBoundsByTransformedPoints(boneTransforms[range.Bone],
+						{x.data() + range.First, y.data() + range.First, z.data() + range.First},
+						range.Count, bounds.first, bounds.second);
+				}
+			}
+		}
+	};
+
+	if (threadPool)
+	{
+		threadPool->ParallelFor(tasks.size(), evaluateTask);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+		{
+			evaluateTask(i);
+		}
+	}
+
+	StudioModelBounds result;
+
+	result.Model = EmptyBounds;
+	result.Sequences.resize(studioModel.Sequences.size(), EmptyBounds);
+
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+	{
+		AddBounds(result.Sequences[tasks[i].Sequence], taskBounds[i]);
+	}
+
+	for (const auto& sequenceBounds : result.Sequences)
+	{
+		AddBounds(result.Model, sequenceBounds);
+	}
+
+	return result;
+}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+class ThreadPool;
+
+namespace studiomdl
+{
+class EditableStudioModel;
+
+/**
+*	@brief The model's bounding box and the bounding box of each sequence.
+*/
+struct StudioModelBounds
+{
+	std::pair<glm::vec3, glm::vec3> Model;
+	std::vector<std::pair<glm::vec3, glm::vec3>> Sequences;
+};
+
+StudioModelBounds GetBounds(const EditableStudioModel& studioModel);
+
+void ApplyBounds(EditableStudioModel& studioModel, const StudioModelBounds& bounds);
+
+/**
+*	@brief Computes tight bounds by posing the model at every frame of every sequence
+*	and transforming the vertices of all submodels in all body parts.
+*	Sequences with multiple blends are also posed at the ends and center of each blend axis.
+*	The model's bounding box encloses all sequence bounding boxes.
+*	@param threadPool Optional pool used to evaluate sequences and frames in parallel.
+*	@return The new bounds, or an empty optional if the model has no vertices or no sequences.
+*/
+std::optional<StudioModelBounds> CalculateBounds(const EditableStudioModel& studioModel, ThreadPool* threadPool);
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelDiff.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+bool AreTexturesEqual(const StudioTexture& lhs, const StudioTexture& rhs)
+{
+	return lhs.Name == rhs.Name
+		&& lhs.Flags == rhs.Flags
+		&& lhs.Data.Width == rhs.Data.Width
+		&& lhs.Data.Height == rhs.Data.Height
+		&& lhs.Data.Pixels == rhs.Data.Pixels
+		&& std::memcmp(lhs.Data.Palette.AsByteArray(), rhs.Data.Palette.AsByteArray(), sizeof(lhs.Data.Palette)) == 0;
+}
+
+bool AreAnimationValuesEqual(const std::vector<mstudioanimvalue_t>& lhs, const std::vector<mstudioanimvalue_t>& rhs)
+{
+	return lhs.size() == rhs.size()
+		&& std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const auto& a, const auto& b)
+			{
+				return a.value == b.value;
+			});
+}
+
+bool AreSequencesEqual(const StudioSequence& lhs, const StudioSequence& rhs)
+{
+	if (lhs.Label != rhs.Label
+		|| lhs.FPS != rhs.FPS
+		|| lhs.Flags != rhs.Flags
+		|| lhs.Activity != rhs.Activity
+		|| lhs.ActivityWeight != rhs.ActivityWeight
+		|| lhs.NumFrames != rhs.NumFrames
+		|| lhs.MotionType != rhs.MotionType
+		|| lhs.MotionBone != rhs.MotionBone
+		|| lhs.LinearMovement != rhs.LinearMovement
+		|| lhs.BBMin != rhs.BBMin
+		|| lhs.BBMax != rhs.BBMax
+		|| lhs.EntryNode != rhs.EntryNode
+		|| lhs.ExitNode != rhs.ExitNode
+		|| lhs.NodeFlags != rhs.NodeFlags
+		|| lhs.NextSequence != rhs.NextSequence)
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0; i < lhs.BlendData.size(); ++i)
+	{
+		const auto& lhsBlend = lhs.BlendData[i];
+		const auto& rhsBlend = rhs.BlendData[i];
+
+		if (lhsBlend.Type != rhsBlend.Type || lhsBlend.Start != rhsBlend.Start || lhsBlend.End != rhsBlend.End)
+		{
+			return false;
+		}
+	}
+
+	if (!std::equal(lhs.SortedEvents.begin(), lhs.SortedEvents.end(), rhs.SortedEvents.begin(), rhs.SortedEvents.end(),
+		[](const auto a, const auto b)
+		{
+			return a->Frame == b->Frame && a->EventId == b->EventId && a->Type == b->Type && a->Options == b->Options;
+		}))
+	{
+		return false;
+	}
+
+	if (!std::equal(lhs.Pivots.begin(), lhs.Pivots.end(), rhs.Pivots.begin(), rhs.Pivots.end(),
+		[](const auto& a, const auto& b)
+		{
+			return a.Origin == b.Origin && a.Start == b.Start && a.End == b.End;
+		}))
+	{
+		return false;
+	}
+
+	return std::equal(lhs.AnimationBlends.begin(), lhs.AnimationBlends.end(),
+		rhs.AnimationBlends.begin(), rhs.AnimationBlends.end(),
+		[](const auto& lhsBlend, const auto& rhsBlend)
+		{
+			return std::equal(lhsBlend.begin(), lhsBlend.end(), rhsBlend.begin(), rhsBlend.end(),
+				[](const auto& lhsAnimation, const auto& rhsAnimation)
+				{
+					for (std::size_t axis = 0; axis < lhsAnimation.Data.size(); ++axis)
+					{
+						if (!AreAnimationValuesEqual(lhsAnimation.Data[axis], rhsAnimation.Data[axis]))
+						{
+							return false;
+						}
+					}
+
+					return true;
+				});
+		});
+}
+}
+
+std::size_t StudioModelChanges::GetChangedTextureCount() const
+{
+	return std::count(TextureSources.begin(), TextureSources.end(), std::nullopt);
+}
+
+StudioModelChanges CompareStudioModels(const EditableStudioModel& oldModel, const EditableStudioModel& newModel)
+{
+	StudioModelChanges changes;
+
+	{
+		std::unordered_map<std::string_view, std::size_t> oldTextures;
+
+		for (std::size_t i = 0; i < oldModel.Textures.size(); ++i)
+		{
+			oldTextures.emplace(oldModel.Textures[i]->Name, i);
+		}
+
+		changes.TextureSources.reserve(newModel.Textures.size());
+
+		for (const auto& texture : newModel.Textures)
+		{
+			std::optional<std::size_t> source;
+
+			if (auto it = oldTextures.find(texture->Name);
+				it != oldTextures.end() && AreTexturesEqual(*oldModel.Textures[it->second], *texture))
+			{
+				source = it->second;
+			}
+
+			changes.TextureSources.push_back(source);
+		}
+	}
+
+	{
+		std::unordered_map<std::string_view, const StudioSequence*> oldSequences;
+
+		for (const auto& sequence : oldModel.Sequences)
+		{
+			oldSequences.emplace(sequence->Label, sequence.get());
+		}
+
+		for (std::size_t i = 0; i < newModel.Sequences.size(); ++i)
+		{
+			const auto& sequence = *newModel.Sequences[i];
+
+			if (auto it = oldSequences.find(sequence.Label);
+				it == oldSequences.end() || !AreSequencesEqual(*it->second, sequence))
+			{
+				changes.ChangedSequences.push_back(i);
+			}
+		}
+	}
+
+	return changes;
+}
+}
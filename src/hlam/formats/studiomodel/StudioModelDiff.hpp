@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace studiomdl
+{
+class EditableStudioModel;
+
+/**
+*	@brief Differences between two versions of the same model, for example before and after it was recompiled.
+*/
+struct StudioModelChanges
+{
+	/**
+	*	@brief For each texture in the new model, the index of the identical texture in the old model, if there is one.
+	*	Textures are matched by name.
+	*/
+	std::vector<std::optional<std::size_t>> TextureSources;
+
+	/**
+	*	@brief Indices of sequences in the new model that are new or differ from the sequence with the same name in the old model.
+	*/
+	std::vector<std::size_t> ChangedSequences;
+
+	std::size_t GetChangedTextureCount() const;
+};
+
+/**
+*	@brief Compares the textures and sequences of two models.
+*/
+StudioModelChanges CompareStudioModels(const EditableStudioModel& oldModel, const EditableStudioModel& newModel);
+}
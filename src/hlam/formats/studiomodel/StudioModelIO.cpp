@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <iterator>
+#include <system_error>
 
 #include <fmt/format.h>
 #include <fmt/std.h>
@@ -12,6 +14,7 @@
 #include "formats/studiomodel/StudioModelIO.hpp"
 
 #include "utility/IOUtils.hpp"
+#include "utility/Platform.hpp"
 
 namespace studiomdl
 {
@@ -75,6 +78,39 @@ bool IsMainStudioModel(FILE* file)
 	return boneindex > 0;
 }
 
+static bool IsStudioModelFileName(const std::filesystem::path& fileName)
+{
+	const auto extension = fileName.extension().u8string();
+	const auto extensionString = reinterpret_cast<const char*>(extension.c_str());
+
+	return strcasecmp(extensionString, ".mdl") == 0 || strcasecmp(extensionString, ".dol") == 0;
+}
+
+std::vector<std::filesystem::path> FindMainStudioModels(const std::filesystem::path& directory)
+{
+	std::vector<std::filesystem::path> fileNames;
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator{
+		directory, std::filesystem::directory_options::skip_permission_denied})
+	{
+		if (!entry.is_regular_file() || !IsStudioModelFileName(entry.path()))
+		{
+			continue;
+		}
+
+		FilePtr file{utf8_fopen(entry.path().u8string().c_str(), "rb")};
+
+		if (file && IsMainStudioModel(file.get()))
+		{
+			fileNames.push_back(entry.path());
+		}
+	}
+
+	std::sort(fileNames.begin(), fileNames.end());
+
+	return fileNames;
+}
+
 static std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadStudioFileIntoBuffer(
 	const std::filesystem::path& fileName, FILE* file)
 {
@@ -239,60 +275,73 @@ std::unique_ptr<StudioModel> LoadStudioModel(
 		std::move(sequenceHeaders), isDol);
 }
 
-void SaveStudioModel(const std::filesystem::path& fileName, StudioModel& model)
+namespace
 {
-	if (fileName.empty())
-	{
-		throw AssetException("Empty filename provided");
-	}
+/**
+*	@brief Writes @p data to a temporary file next to @p fileName, then replaces @p fileName with it.
+*	The data is flushed to disk before the rename so a crash or power loss leaves either the old or the new file, never a partial one.
+*/
+void WriteFileAtomically(const std::filesystem::path& fileName, const void* data, std::size_t sizeInBytes, const char* description)
+{
+	auto temporaryFileName{fileName};
+	temporaryFileName += ".tmp";
 
-	studiohdr_t* const pStudioHdr = model.GetStudioHeader();
+	{
+		FilePtr file{utf8_fopen(temporaryFileName.u8string().c_str(), "wb")};
 
-	assert(pStudioHdr->numseqgroups == 1);
+		if (!file)
+		{
+			throw AssetException(fmt::format("Could not open {} file for writing", description));
+		}
 
-	FILE* file = utf8_fopen(fileName.u8string().c_str(), "wb");
+		// The data is already in memory so write it in one block instead of going through the stdio buffer.
+		setvbuf(file.get(), nullptr, _IONBF, 0);
 
-	if (!file)
-	{
-		throw AssetException("Could not open main file for writing");
+		if (fwrite(data, 1, sizeInBytes, file.get()) != sizeInBytes || !FlushFileToDisk(file.get()))
+		{
+			file.reset();
+			std::error_code ignored;
+			std::filesystem::remove(temporaryFileName, ignored);
+			throw AssetException(fmt::format("Error while writing to {} file", description));
+		}
 	}
 
-	bool success = fwrite(pStudioHdr, sizeof(std::byte), pStudioHdr->length, file) == pStudioHdr->length;
+	std::error_code error;
+	std::filesystem::rename(temporaryFileName, fileName, error);
 
-	fclose(file);
+	if (error)
+	{
+		std::error_code ignored;
+		std::filesystem::remove(temporaryFileName, ignored);
+		throw AssetException(fmt::format("Could not replace {} file: {}", description, error.message()));
+	}
+}
+}
 
-	if (!success)
+void SaveStudioModel(const std::filesystem::path& fileName, const StudioModel& model)
+{
+	if (fileName.empty())
 	{
-		throw AssetException("Error while writing to main file");
+		throw AssetException("Empty filename provided");
 	}
 
-	auto baseFileName{fileName};
+	const studiohdr_t* const pStudioHdr = model.GetStudioHeader();
+
+	assert(pStudioHdr->numseqgroups == 1);
 
-	baseFileName.replace_extension();
+	WriteFileAtomically(fileName, pStudioHdr, pStudioHdr->length, "main");
 
 	// write texture model
 	if (model.HasSeparateTextureHeader())
 	{
 		const studiohdr_t* const pTextureHdr = model.GetTextureHeader();
 
-		std::filesystem::path texturename = baseFileName;
+		auto texturename{fileName};
 
+		texturename.replace_extension();
 		texturename += "T.mdl";
 
-		file = utf8_fopen(texturename.u8string().c_str(), "wb");
-
-		if (!file)
-		{
-			throw AssetException("Could not open texture file for writing");
-		}
-
-		success = fwrite(pTextureHdr, sizeof(std::byte), pTextureHdr->length, file) == pTextureHdr->length;
-		fclose(file);
-
-		if (!success)
-		{
-			throw AssetException("Error while writing to texture file");
-		}
+		WriteFileAtomically(texturename, pTextureHdr, pTextureHdr->length, "texture");
 	}
 }
 }
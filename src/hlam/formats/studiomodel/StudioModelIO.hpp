@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "application/AssetIO.hpp"
 
@@ -16,6 +17,13 @@ bool IsStudioModel(FILE* file, bool acceptSequenceFiles);
 
 bool IsMainStudioModel(FILE* file);
 
+/**
+*	@brief Recursively finds all main studio model files in a directory.
+*	Texture and sequence group files are skipped. The result is sorted.
+*	@exception std::filesystem::filesystem_error If the directory could not be read
+*/
+std::vector<std::filesystem::path> FindMainStudioModels(const std::filesystem::path& directory);
+
 /**
 *	@brief Loads a studio model
 *	@param fileName Name of the model to load. This is the entire path, including the extension
@@ -31,9 +39,12 @@ std::unique_ptr<StudioModel> LoadStudioModel(
 
 /**
 *	Saves a studio model.
+*	Each file is written to a temporary file first and flushed to disk before it replaces the existing file,
+*	so an interrupted save never leaves a partially written model behind.
+*	Does not modify the model and can be called on any thread.
 *	@param fileName Name of the file to save the model to. This is the entire path, including the extension.
 *	@param model Model to save.
 *	@exception assets::AssetException If an error occurs or if the given data is invalid
 */
-void SaveStudioModel(const std::filesystem::path& fileName, StudioModel& model);
+void SaveStudioModel(const std::filesystem::path& fileName, const StudioModel& model);
 }
@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelPicker.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+constexpr float NoHit = std::numeric_limits<float>::max();
+
+/**
+*	@brief Moller-Trumbore ray/triangle intersection. Triangles are hit from both sides.
+*/
+bool IntersectTriangle(const glm::vec3& origin, const glm::vec3& direction,
+	const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& distance)
+{
+	constexpr float Epsilon = 1e-7f;
+
+	const glm::vec3 edge1 = v1 - v0;
+	const glm::vec3 edge2 = v2 - v0;
+
+	const glm::vec3 p = glm::cross(direction, edge2);
+	const float determinant = glm::dot(edge1, p);
+
+	if (std::abs(determinant) < Epsilon)
+	{
+		return false;
+	}
+
+	const float inverseDeterminant = 1.f / determinant;
+
+	const glm::vec3 s = origin - v0;
+	const float u = glm::dot(s, p) * inverseDeterminant;
+
+	if (u < 0.f || u > 1.f)
+	{
+		return false;
+	}
+
+	const glm::vec3 q = glm::cross(s, edge1);
+	const float v = glm::dot(direction, q) * inverseDeterminant;
+
+	if (v < 0.f || (u + v) > 1.f)
+	{
+		return false;
+	}
+
+	distance = glm::dot(edge2, q) * inverseDeterminant;
+
+	return distance >= 0.f;
+}
+
+/**
+*	@brief Slab test against an axis aligned box. The direction does not need to be normalized;
+*	the distance is in units of the direction's length.
+*/
+bool IntersectBox(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& mins, const glm::vec3& maxs, float& distance)
+{
+	float entry = 0;
+	float exit = NoHit;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (direction[axis] == 0)
+		{
+			if (origin[axis] < mins[axis] || origin[axis] > maxs[axis])
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		const float inverse = 1.f / direction[axis];
+
+		float t0 = (mins[axis] - origin[axis]) * inverse;
+		float t1 = (maxs[axis] - origin[axis]) * inverse;
+
+		if (t0 > t1)
+		{
+			std::swap(t0, t1);
+		}
+
+		entry = std::max(entry, t0);
+		exit = std::min(exit, t1);
+
+		if (entry > exit)
+		{
+			return false;
+		}
+	}
+
+	distance = entry;
+
+	return true;
+}
+}
+
+PickResult StudioModelPicker::Pick(const ModelRenderInfo& renderInfo, const PickRay& ray, PickFlags flags)
+{
+	if (!renderInfo.Model || flags == PickFlag::None)
+	{
+		return {};
+	}
+
+	const auto& model = *renderInfo.Model;
+
+	// Same transformation as StudioModelRenderer::SetupPosition.
+	glm::mat4x4 modelMatrix = glm::translate(glm::identity<glm::mat4x4>(), renderInfo.Origin);
+	modelMatrix = glm::rotate(modelMatrix, glm::radians(renderInfo.Angles[1]), glm::vec3{0, 0, 1});
+	modelMatrix = glm::rotate(modelMatrix, glm::radians(renderInfo.Angles[0]), glm::vec3{0, 1, 0});
+	modelMatrix = glm::rotate(modelMatrix, glm::radians(renderInfo.Angles[2]), glm::vec3{1, 0, 0});
+
+	// Only rotation and translation are involved, so distances in model space are the same as in world space.
+	const glm::mat4x4 inverseModelMatrix = glm::inverse(modelMatrix);
+
+	const glm::vec3 origin{inverseModelMatrix * glm::vec4{ray.Origin, 1}};
+	const glm::vec3 direction{inverseModelMatrix * glm::vec4{ray.Direction, 0}};
+
+	UpdatePose(model, renderInfo, flags);
+
+	if (flags & (PickFlag::Bones | PickFlag::Attachments))
+	{
+		if (const auto result = PickPoints(model, origin, direction, ray, flags); result.Type != PickType::None)
+		{
+			return result;
+		}
+	}
+
+	if (flags & PickFlag::Hitboxes)
+	{
+		if (const auto result = PickHitboxes(model, origin, direction); result.Type != PickType::None)
+		{
+			return result;
+		}
+	}
+
+	if (flags & PickFlag::Meshes)
+	{
+		return PickMeshes(model, renderInfo, origin, direction);
+	}
+
+	return {};
+}
+
+void StudioModelPicker::UpdateTopology(const EditableStudioModel& model, int bodygroup)
+{
+	std::vector<const StudioSubModel*> subModels;
+	subModels.reserve(model.Bodyparts.size());
+
+	std::size_t vertexCount = 0;
+	std::size_t triangleCommandCount = 0;
+
+	for (int i = 0; i < model.Bodyparts.size(); ++i)
+	{
+		const auto subModel = model.GetModelByBodyPart(bodygroup, i);
+
+		subModels.push_back(subModel);
+		vertexCount += subModel->Vertices.size();
+
+		for (const auto& mesh : subModel->Meshes)
+		{
+			triangleCommandCount += mesh.Triangles.size();
+		}
+	}
+
+	if (subModels == _subModels && vertexCount == _vertexCount && triangleCommandCount == _triangleCommandCount)
+	{
+		return;
+	}
+
+	_subModels = std::move(subModels);
+	_vertexCount = vertexCount;
+	_triangleCommandCount = triangleCommandCount;
+
+	_triangles.clear();
+
+	std::uint32_t vertexOffset = 0;
+
+	for (int bodyPart = 0; bodyPart < _subModels.size(); ++bodyPart)
+	{
+		const auto& subModel = *_subModels[bodyPart];
+
+		for (int meshIndex = 0; meshIndex < subModel.Meshes.size(); ++meshIndex)
+		{
+			const auto& mesh = subModel.Meshes[meshIndex];
+
+			auto commands = mesh.Triangles.data();
+			const auto end = commands + mesh.Triangles.size();
+
+			// Same layout as drawn by StudioModelRenderer::DrawMeshes:
+			// a vertex count (negative for fans, positive for strips) followed by 4 values per vertex.
+			for (int count; commands < end && (count = *commands++) != 0;)
+			{
+				const bool isFan = count < 0;
+
+				count = std::abs(count);
+
+				std::uint32_t first = 0;
+				std::uint32_t previous = 0;
+				std::uint32_t beforePrevious = 0;
+
+				for (int i = 0; i < count && commands < end; ++i, commands += 4)
+				{
+					const std::uint32_t vertex = vertexOffset + static_cast<std::uint16_t>(commands[0]);
+
+					if (i == 0)
+					{
+						first = vertex;
+					}
+					else if (i >= 2)
+					{
+						_triangles.push_back({{isFan ? first : beforePrevious, previous, vertex}, bodyPart, meshIndex});
+					}
+
+					beforePrevious = previous;
+					previous = vertex;
+				}
+			}
+		}
+
+		vertexOffset += static_cast<std::uint32_t>(subModel.Vertices.size());
+	}
+
+	_triangleBounds.resize(_triangles.size());
+	_triangleTreeBuilt = false;
+}
+
+void StudioModelPicker::UpdatePose(const EditableStudioModel& model, const ModelRenderInfo& renderInfo, PickFlags flags)
+{
+	_boneTransforms = &_boneTransformer.SetUpBones(model,
+		{
+			renderInfo.Sequence,
+			renderInfo.Frame,
+			renderInfo.Scale,
+			renderInfo.Blender,
+			renderInfo.Controller,
+			renderInfo.Mouth
+		});
+
+	const auto& boneTransforms = *_boneTransforms;
+
+	if (flags & PickFlag::Hitboxes)
+	{
+		_hitboxBounds.resize(model.Hitboxes.size());
+
+		for (std::size_t i = 0; i < model.Hitboxes.size(); ++i)
+		{
+			const auto& hitbox = *model.Hitboxes[i];
+			const auto& transform = boneTransforms[hitbox.Bone->ArrayIndex];
+
+			auto& bounds = _hitboxBounds[i];
+			bounds = {};
+
+			for (int corner = 0; corner < 8; ++corner)
+			{
+				const glm::vec3 point{
+					(corner & 1) ? hitbox.Max.x : hitbox.Min.x,
+					(corner & 2) ? hitbox.Max.y : hitbox.Min.y,
+					(corner & 4) ? hitbox.Max.z : hitbox.Min.z};
+
+				bounds.Add(glm::vec3{transform * glm::vec4{point, 1}});
+			}
+		}
+
+		if (_hitboxTree.GetPrimitiveCount() != _hitboxBounds.size())
+		{
+			_hitboxTree.Build(_hitboxBounds);
+		}
+		else
+		{
+			_hitboxTree.Refit(_hitboxBounds);
+		}
+	}
+
+	if (flags & PickFlag::Meshes)
+	{
+		UpdateTopology(model, renderInfo.Bodygroup);
+
+		_vertices.resize(_vertexCount);
+
+		std::size_t vertexIndex = 0;
+
+		for (const auto subModel : _subModels)
+		{
+			for (const auto& vertex : subModel->Vertices)
+			{
+				_vertices[vertexIndex++] = glm::vec3{boneTransforms[vertex.Bone->ArrayIndex] * glm::vec4{vertex.Vertex, 1}};
+			}
+		}
+
+		for (std::size_t i = 0; i < _triangles.size(); ++i)
+		{
+			auto& bounds = _triangleBounds[i];
+			bounds = {};
+
+			for (const auto vertex : _triangles[i].Vertices)
+			{
+				bounds.Add(_vertices[vertex]);
+			}
+		}
+
+		if (!_triangleTreeBuilt)
+		{
+			_triangleTree.Build(_triangleBounds);
+			_triangleTreeBuilt = true;
+		}
+		else
+		{
+			_triangleTree.Refit(_triangleBounds);
+		}
+	}
+}
+
+PickResult StudioModelPicker::PickPoints(const EditableStudioModel& model,
+	const glm::vec3& origin, const glm::vec3& direction, const PickRay& ray, PickFlags flags) const
+{
+	const auto& boneTransforms = *_boneTransforms;
+
+	PickResult result;
+
+	// Points are picked by how close they are to the ray relative to the size of the cone,
+	// so the point closest to the cursor wins.
+	float bestFraction = NoHit;
+
+	const auto testPoint = [&](const glm::vec3& point, PickType type, int index)
+	{
+		const float distance = glm::dot(point - origin, direction);
+
+		if (distance < 0)
+		{
+			return;
+		}
+
+		const float radius = ray.PointRadius + (ray.PointRadiusPerUnit * distance);
+		const float offset = glm::length(point - (origin + (direction * distance)));
+
+		if (offset > radius)
+		{
+			return;
+		}
+
+		const float fraction = radius > 0 ? offset / radius : 0.f;
+
+		if (fraction < bestFraction)
+		{
+			bestFraction = fraction;
+			result.Type = type;
+			result.Index = index;
+			result.Distance = distance;
+		}
+	};
+
+	if (flags & PickFlag::Bones)
+	{
+		for (int i = 0; i < model.Bones.size(); ++i)
+		{
+			testPoint(glm::vec3{boneTransforms[i][3]}, PickType::Bone, i);
+		}
+	}
+
+	if (flags & PickFlag::Attachments)
+	{
+		for (int i = 0; i < model.Attachments.size(); ++i)
+		{
+			const auto& attachment = *model.Attachments[i];
+
+			testPoint(glm::vec3{boneTransforms[attachment.Bone->ArrayIndex] * glm::vec4{attachment.Origin, 1}},
+				PickType::Attachment, i);
+		}
+	}
+
+	return result;
+}
+
+PickResult StudioModelPicker::PickHitboxes(
+	const EditableStudioModel& model, const glm::vec3& origin, const glm::vec3& direction) const
+{
+	const auto& boneTransforms = *_boneTransforms;
+
+	PickResult result;
+
+	const float distance = _hitboxTree.Traverse(origin, direction, NoHit, [&](std::uint32_t index, float& closest)
+		{
+			const auto& hitbox = *model.Hitboxes[index];
+
+			// Test in the bone's space so the box is axis aligned. The transformation is affine,
+			// so distances along the transformed ray are the same as along the original ray.
+			const glm::mat4x4 inverse = glm::inverse(boneTransforms[hitbox.Bone->ArrayIndex]);
+
+			const glm::vec3 localOrigin{inverse * glm::vec4{origin, 1}};
+			const glm::vec3 localDirection{inverse * glm::vec4{direction, 0}};
+
+			if (float hitDistance; IntersectBox(localOrigin, localDirection, hitbox.Min, hitbox.Max, hitDistance)
+				&& hitDistance < closest)
+			{
+				closest = hitDistance;
+				result.Index = static_cast<int>(index);
+			}
+		});
+
+	if (result.Index != -1)
+	{
+		result.Type = PickType::Hitbox;
+		result.Distance = distance;
+	}
+
+	return result;
+}
+
+PickResult StudioModelPicker::PickMeshes(const EditableStudioModel& model, const ModelRenderInfo& renderInfo,
+	const glm::vec3& origin, const glm::vec3& direction) const
+{
+	int triangleIndex = -1;
+
+	const float distance = _triangleTree.Traverse(origin, direction, NoHit, [&](std::uint32_t index, float& closest)
+		{
+			const auto& triangle = _triangles[index];
+
+			if (float hitDistance; IntersectTriangle(origin, direction,
+				_vertices[triangle.Vertices[0]], _vertices[triangle.Vertices[1]], _vertices[triangle.Vertices[2]], hitDistance)
+				&& hitDistance < closest)
+			{
+				closest = hitDistance;
+				triangleIndex = static_cast<int>(index);
+			}
+		});
+
+	if (triangleIndex == -1)
+	{
+		return {};
+	}
+
+	const auto& triangle = _triangles[triangleIndex];
+
+	PickResult result;
+
+	result.Type = PickType::Mesh;
+	result.Index = triangle.Mesh;
+	result.BodyPart = triangle.BodyPart;
+	result.Distance = distance;
+
+	if (!model.SkinFamilies.empty())
+	{
+		const int skin = std::clamp(renderInfo.Skin, 0, static_cast<int>(model.SkinFamilies.size()) - 1);
+		const auto& mesh = _subModels[triangle.BodyPart]->Meshes[triangle.Mesh];
+
+		result.Texture = model.SkinFamilies[skin][mesh.SkinRef];
+	}
+
+	return result;
+}
+}
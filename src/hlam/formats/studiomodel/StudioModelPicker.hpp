@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "formats/studiomodel/BoneTransformer.hpp"
+#include "formats/studiomodel/ModelRenderInfo.hpp"
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+
+#include "utility/BoundingVolumeHierarchy.hpp"
+
+namespace studiomdl
+{
+struct StudioSubModel;
+
+enum class PickType
+{
+	None = 0,
+	Mesh,
+	Hitbox,
+	Bone,
+	Attachment
+};
+
+namespace PickFlag
+{
+enum PickFlag
+{
+	None = 0,
+	Meshes = 1 << 0,
+	Hitboxes = 1 << 1,
+	Bones = 1 << 2,
+	Attachments = 1 << 3
+};
+}
+
+using PickFlags = int;
+
+/**
+*	@brief Ray in world space used to pick objects.
+*	Bones and attachments are points, so they are hit if they are within a cone around the ray.
+*/
+struct PickRay
+{
+	glm::vec3 Origin{0};
+
+	/**
+	*	@brief Must be normalized.
+	*/
+	glm::vec3 Direction{1, 0, 0};
+
+	/**
+	*	@brief Radius of the cone at the ray origin.
+	*/
+	float PointRadius{};
+
+	/**
+	*	@brief How much the radius of the cone grows for each unit of distance along the ray.
+	*/
+	float PointRadiusPerUnit{};
+};
+
+struct PickResult
+{
+	PickType Type = PickType::None;
+
+	/**
+	*	@brief Index of the hitbox, bone or attachment, or the mesh index in the submodel for meshes.
+	*/
+	int Index = -1;
+
+	/**
+	*	@brief For meshes, the body part that contains the mesh.
+	*/
+	int BodyPart = -1;
+
+	/**
+	*	@brief For meshes, the texture used by the mesh with the current skin.
+	*/
+	int Texture = -1;
+
+	/**
+	*	@brief Distance from the ray origin.
+	*/
+	float Distance{};
+};
+
+/**
+*	@brief Finds the model element under a ray using the model's current pose.
+*	Triangles and hitboxes are stored in bounding volume hierarchies that are built once for a model and body group,
+*	and refitted to the pose on each query so animated models can be picked without rebuilding the trees.
+*/
+class StudioModelPicker final
+{
+public:
+	StudioModelPicker() = default;
+	StudioModelPicker(const StudioModelPicker&) = delete;
+	StudioModelPicker& operator=(const StudioModelPicker&) = delete;
+
+	/**
+	*	@brief Picks the element closest to the ray origin out of the requested types.
+	*	Bones and attachments are drawn on top of everything else and are picked first,
+	*	then hitboxes, then meshes.
+	*/
+	PickResult Pick(const ModelRenderInfo& renderInfo, const PickRay& ray, PickFlags flags);
+
+private:
+	struct Triangle
+	{
+		std::array<std::uint32_t, 3> Vertices;
+		int BodyPart;
+		int Mesh;
+	};
+
+	void UpdateTopology(const EditableStudioModel& model, int bodygroup);
+
+	void UpdatePose(const EditableStudioModel& model, const ModelRenderInfo& renderInfo, PickFlags flags);
+
+	PickResult PickPoints(const EditableStudioModel& model,
+		const glm::vec3& origin, const glm::vec3& direction, const PickRay& ray, PickFlags flags) const;
+
+	PickResult PickHitboxes(const EditableStudioModel& model, const glm::vec3& origin, const glm::vec3& direction) const;
+
+	PickResult PickMeshes(const EditableStudioModel& model, const ModelRenderInfo& renderInfo,
+		const glm::vec3& origin, const glm::vec3& direction) const;
+
+private:
+	BoneTransformer _boneTransformer;
+
+	const std::array<glm::mat4x4, MAXSTUDIOBONES>* _boneTransforms{};
+
+	/**
+	*	@brief Submodels the triangles were built from. The topology is rebuilt when this changes.
+	*/
+	std::vector<const StudioSubModel*> _subModels;
+	std::size_t _vertexCount{};
+	std::size_t _triangleCommandCount{};
+
+	std::vector<Triangle> _triangles;
+	std::vector<glm::vec3> _vertices;
+	std::vector<BoundingVolumeHierarchy::Bounds> _triangleBounds;
+	BoundingVolumeHierarchy _triangleTree;
+	bool _triangleTreeBuilt{false};
+
+	std::vector<BoundingVolumeHierarchy::Bounds> _hitboxBounds;
+	BoundingVolumeHierarchy _hitboxTree;
+};
+}
@@ -18,6 +18,7 @@
 #include "plugins/halflife/studiomodel/StudioModelColors.hpp"
 
 #include "utility/mathlib.hpp"
+#include "utility/ThreadPool.hpp"
 
 //Double to float conversion
 #pragma warning( disable: 4244 )
@@ -28,6 +29,8 @@ StudioModelRenderer::StudioModelRenderer(const std::shared_ptr<spdlog::logger>&
 	: _logger(logger)
 	, _openglFunctions(openglFunctions)
 	, _colorSettings(colorSettings)
+	, _boneThreadPool(std::make_unique<ThreadPool>(ThreadPool::GetDefaultThreadCount(1, 3)))
+	, _boneTransformer(_boneThreadPool.get())
 {
 	// Initialize them now so the colors don't flicker for the first fraction of a second.
 	UpdateColors();
@@ -72,9 +75,15 @@ unsigned int StudioModelRenderer::DrawModel(
 
 	SetupPosition(origin, _renderInfo->Angles);
 
-	SetUpBones();
+	{
+		graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::BoneSetup)};
+		SetUpBones();
+	}
 
-	SetupLighting();
+	{
+		graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::Lighting)};
+		SetupLighting();
+	}
 
 	unsigned int uiDrawnPolys = 0;
 
@@ -91,6 +100,7 @@ unsigned int StudioModelRenderer::DrawModel(
 
 				if (flags & renderer::DrawFlag::DRAW_SHADOWS)
 				{
+					graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::DrawSubmission)};
 					uiDrawnPolys += DrawShadows(fixShadowZFighting, false, floorHeight);
 				}
 			}
@@ -99,10 +109,10 @@ unsigned int StudioModelRenderer::DrawModel(
 
 	if (flags & renderer::DrawFlag::WIREFRAME_OVERLAY)
 	{
-		_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		_openglFunctions->glDisable(GL_TEXTURE_2D);
-		_openglFunctions->glDisable(GL_CULL_FACE);
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		SetPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+		DisableCapability(GL_TEXTURE_2D);
+		DisableCapability(GL_CULL_FACE);
+		EnableCapability(GL_DEPTH_TEST);
 
 		for (int i = 0; i < _studioModel->Bodyparts.size(); i++)
 		{
@@ -113,6 +123,7 @@ unsigned int StudioModelRenderer::DrawModel(
 
 				if (flags & renderer::DrawFlag::DRAW_SHADOWS)
 				{
+					graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::DrawSubmission)};
 					uiDrawnPolys += DrawShadows(fixShadowZFighting, true, floorHeight);
 				}
 			}
@@ -120,7 +131,9 @@ unsigned int StudioModelRenderer::DrawModel(
 	}
 
 	// Restore in case the above draw calls used wireframe.
-	_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	SetPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+	graphics::ScopedRenderTimer overlaysTimer{GetStageTime(graphics::RenderStage::DrawSubmission)};
 
 	// draw bones
 	if (flags & renderer::DrawFlag::DRAW_BONES)
@@ -170,8 +183,8 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_DEPTH_TEST);
 
 	const auto& bone = *model->Bones[iBone];
 
@@ -185,13 +198,13 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 
 		_openglFunctions->glPointSize(10.0f);
 		_openglFunctions->glColor3f(0, 0.7f, 1);
-		_openglFunctions->glBegin(GL_LINES);
+		BeginPrimitive(GL_LINES);
 		_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 		_openglFunctions->glEnd();
 
 		_openglFunctions->glColor3f(0, 0, 0.8f);
-		_openglFunctions->glBegin(GL_POINTS);
+		BeginPrimitive(GL_POINTS);
 		if (parentBone.Parent)
 			_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
@@ -202,7 +215,7 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 		// draw parent bone node
 		_openglFunctions->glPointSize(10.0f);
 		_openglFunctions->glColor3f(0.8f, 0, 0);
-		_openglFunctions->glBegin(GL_POINTS);
+		BeginPrimitive(GL_POINTS);
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 		_openglFunctions->glEnd();
 	}
@@ -228,9 +241,9 @@ void StudioModelRenderer::DrawSingleAttachment(ModelRenderInfo& renderInfo, cons
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_CULL_FACE);
+	DisableCapability(GL_DEPTH_TEST);
 
 	const auto& attachment = *_studioModel->Attachments[iAttachment];
 
@@ -243,7 +256,7 @@ void StudioModelRenderer::DrawSingleAttachment(ModelRenderInfo& renderInfo, cons
 	v[2] = attachmentBoneTransform * glm::vec4{attachment.Vectors[1], 1};
 	v[3] = attachmentBoneTransform * glm::vec4{attachment.Vectors[2], 1};
 
-	_openglFunctions->glBegin(GL_LINES);
+	BeginPrimitive(GL_LINES);
 	_openglFunctions->glColor3f(0, 1, 1);
 	_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 	_openglFunctions->glColor3f(1, 1, 1);
@@ -260,7 +273,7 @@ void StudioModelRenderer::DrawSingleAttachment(ModelRenderInfo& renderInfo, cons
 
 	_openglFunctions->glPointSize(10);
 	_openglFunctions->glColor3f(0, 1, 0);
-	_openglFunctions->glBegin(GL_POINTS);
+	BeginPrimitive(GL_POINTS);
 	_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 	_openglFunctions->glEnd();
 	_openglFunctions->glPointSize(1);
@@ -284,16 +297,16 @@ void StudioModelRenderer::DrawSingleHitbox(ModelRenderInfo& renderInfo, const in
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_CULL_FACE);
 	if (_renderInfo->Transparency < 1.0f)
-		_openglFunctions->glDisable(GL_DEPTH_TEST);
+		DisableCapability(GL_DEPTH_TEST);
 	else
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		EnableCapability(GL_DEPTH_TEST);
 
-	_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	_openglFunctions->glEnable(GL_BLEND);
-	_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	SetPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	EnableCapability(GL_BLEND);
+	SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	const auto& hitbox = *_studioModel->Hitboxes[hitboxIndex];
 
@@ -332,8 +345,8 @@ void StudioModelRenderer::SetupPosition(const glm::vec3& origin, const glm::vec3
 
 void StudioModelRenderer::DrawBones()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_DEPTH_TEST);
 
 	for (int i = 0; i < _studioModel->Bones.size(); i++)
 	{
@@ -347,13 +360,13 @@ void StudioModelRenderer::DrawBones()
 
 			_openglFunctions->glPointSize(3.0f);
 			_openglFunctions->glColor3f(1, 0.7f, 0);
-			_openglFunctions->glBegin(GL_LINES);
+			BeginPrimitive(GL_LINES);
 			_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 			_openglFunctions->glEnd();
 
 			_openglFunctions->glColor3f(0, 0, 0.8f);
-			_openglFunctions->glBegin(GL_POINTS);
+			BeginPrimitive(GL_POINTS);
 			if (bone.Parent->Parent)
 				_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
@@ -364,7 +377,7 @@ void StudioModelRenderer::DrawBones()
 			// draw parent bone node
 			_openglFunctions->glPointSize(5.0f);
 			_openglFunctions->glColor3f(0.8f, 0, 0);
-			_openglFunctions->glBegin(GL_POINTS);
+			BeginPrimitive(GL_POINTS);
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 			_openglFunctions->glEnd();
 		}
@@ -375,9 +388,9 @@ void StudioModelRenderer::DrawBones()
 
 void StudioModelRenderer::DrawAttachments()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_CULL_FACE);
+	DisableCapability(GL_DEPTH_TEST);
 
 	for (int i = 0; i < _studioModel->Attachments.size(); i++)
 	{
@@ -392,7 +405,7 @@ void StudioModelRenderer::DrawAttachments()
 		v[2] = attachmentBoneTransform * glm::vec4{attachment.Vectors[1], 1};
 		v[3] = attachmentBoneTransform * glm::vec4{attachment.Vectors[2], 1};
 
-		_openglFunctions->glBegin(GL_LINES);
+		BeginPrimitive(GL_LINES);
 		_openglFunctions->glColor3f(1, 0, 0);
 		_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 		_openglFunctions->glColor3f(1, 1, 1);
@@ -409,7 +422,7 @@ void StudioModelRenderer::DrawAttachments()
 
 		_openglFunctions->glPointSize(5);
 		_openglFunctions->glColor3f(0, 1, 0);
-		_openglFunctions->glBegin(GL_POINTS);
+		BeginPrimitive(GL_POINTS);
 		_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 		_openglFunctions->glEnd();
 		_openglFunctions->glPointSize(1);
@@ -418,13 +431,13 @@ void StudioModelRenderer::DrawAttachments()
 
 void StudioModelRenderer::DrawEyePosition()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_CULL_FACE);
+	DisableCapability(GL_DEPTH_TEST);
 
 	_openglFunctions->glPointSize(7);
 	_openglFunctions->glColor3f(1, 0, 1);
-	_openglFunctions->glBegin(GL_POINTS);
+	BeginPrimitive(GL_POINTS);
 	_openglFunctions->glVertex3fv(glm::value_ptr(_studioModel->EyePosition));
 	_openglFunctions->glEnd();
 	_openglFunctions->glPointSize(1);
@@ -432,16 +445,16 @@ void StudioModelRenderer::DrawEyePosition()
 
 void StudioModelRenderer::DrawHitBoxes()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
+	DisableCapability(GL_TEXTURE_2D);
+	DisableCapability(GL_CULL_FACE);
 	if (_renderInfo->Transparency < 1.0f)
-		_openglFunctions->glDisable(GL_DEPTH_TEST);
+		DisableCapability(GL_DEPTH_TEST);
 	else
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		EnableCapability(GL_DEPTH_TEST);
 
-	_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	_openglFunctions->glEnable(GL_BLEND);
-	_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	SetPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	EnableCapability(GL_BLEND);
+	SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	const glm::vec4 faceColor = _colorSettings->GetColor(studiomodel::HitboxFaceColor);
 	const glm::vec4 edgeColor = _colorSettings->GetColor(studiomodel::HitboxEdgeColor);
@@ -467,11 +480,11 @@ void StudioModelRenderer::DrawHitBoxes()
 
 void StudioModelRenderer::DrawNormals()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glEnable(GL_DEPTH_TEST);
+	DisableCapability(GL_TEXTURE_2D);
+	EnableCapability(GL_DEPTH_TEST);
 
 	_openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	_openglFunctions->glBegin(GL_LINES);
+	BeginPrimitive(GL_LINES);
 
 	for (int iBodyPart = 0; iBodyPart < _studioModel->Bodyparts.size(); ++iBodyPart)
 	{
@@ -561,9 +574,13 @@ unsigned int StudioModelRenderer::DrawPoints(const bool bWireframe)
 	//TODO: do this earlier
 	_renderInfo->Skin = std::clamp(_renderInfo->Skin, 0, static_cast<int>(_studioModel->SkinFamilies.size()));
 
-	for (int i = 0; i < _model->Vertices.size(); i++)
 	{
-		_xformverts[i] = _bonetransform[_model->Vertices[i].Bone->ArrayIndex] * glm::vec4{_model->Vertices[i].Vertex, 1};
+		graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::Skinning)};
+
+		for (int i = 0; i < _model->Vertices.size(); i++)
+		{
+			_xformverts[i] = _bonetransform[_model->Vertices[i].Bone->ArrayIndex] * glm::vec4{_model->Vertices[i].Vertex, 1};
+		}
 	}
 
 	SortedMesh meshes[MAXSTUDIOMESHES]{};
@@ -572,39 +589,45 @@ unsigned int StudioModelRenderer::DrawPoints(const bool bWireframe)
 	// clip and draw all triangles
 	//
 
-	auto normals = _model->Normals.data();
-
-	glm::vec3* lv = _lightvalues;
-	for (int j = 0; j < _model->Meshes.size(); j++)
 	{
-		const auto& mesh = _model->Meshes[j];
+		graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::Lighting)};
 
-		const int flags = _studioModel->Textures[_studioModel->SkinFamilies[_renderInfo->Skin][mesh.SkinRef]]->Flags;
+		auto normals = _model->Normals.data();
 
-		meshes[j].Mesh = &mesh;
-		meshes[j].Flags = flags;
-
-		for (int i = 0; i < mesh.NumNorms; i++, ++lv, ++normals)
+		glm::vec3* lv = _lightvalues;
+		for (int j = 0; j < _model->Meshes.size(); j++)
 		{
-			Lighting(*lv, normals->Bone->ArrayIndex, flags, normals->Vertex);
+			const auto& mesh = _model->Meshes[j];
 
-			// FIX: move this check out of the inner loop
-			if (flags & STUDIO_NF_CHROME)
+			const int flags = _studioModel->Textures[_studioModel->SkinFamilies[_renderInfo->Skin][mesh.SkinRef]]->Flags;
+
+			meshes[j].Mesh = &mesh;
+			meshes[j].Flags = flags;
+
+			for (int i = 0; i < mesh.NumNorms; i++, ++lv, ++normals)
 			{
-				auto& c = _chrome[reinterpret_cast<glm::vec3*>(lv) - _lightvalues];
+				Lighting(*lv, normals->Bone->ArrayIndex, flags, normals->Vertex);
+
+				// FIX: move this check out of the inner loop
+				if (flags & STUDIO_NF_CHROME)
+				{
+					auto& c = _chrome[reinterpret_cast<glm::vec3*>(lv) - _lightvalues];
 
-				Chrome(c, normals->Bone->ArrayIndex, normals->Vertex);
+					Chrome(c, normals->Bone->ArrayIndex, normals->Vertex);
+				}
 			}
 		}
 	}
 
+	graphics::ScopedRenderTimer timer{GetStageTime(graphics::RenderStage::DrawSubmission)};
+
 	//Sort meshes by render modes so additive meshes are drawn after solid meshes.
 	//Masked meshes are drawn before solid meshes.
 	std::stable_sort(meshes, meshes + _model->Meshes.size(), CompareSortedMeshes);
 
 	uiDrawnPolys += DrawMeshes(bWireframe, meshes);
 
-	_openglFunctions->glDepthMask(GL_TRUE);
+	SetDepthMask(GL_TRUE);
 
 	return uiDrawnPolys;
 }
@@ -620,7 +643,7 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 	unsigned int uiDrawnPolys = 0;
 
 	//Polygons may overlap, so make sure they can blend together.
-	_openglFunctions->glDepthFunc(GL_LEQUAL);
+	SetDepthFunc(GL_LEQUAL);
 
 	for (int j = 0; j < _model->Meshes.size(); j++)
 	{
@@ -637,32 +660,32 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 		if (!bWireframe)
 		{
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
-				_openglFunctions->glDepthMask(GL_FALSE);
+				SetDepthMask(GL_FALSE);
 			else
-				_openglFunctions->glDepthMask(GL_TRUE);
+				SetDepthMask(GL_TRUE);
 
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
 			{
-				_openglFunctions->glEnable(GL_BLEND);
-				_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+				EnableCapability(GL_BLEND);
+				SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
 			}
 			else if (_renderInfo->Transparency < 1.0f)
 			{
-				_openglFunctions->glEnable(GL_BLEND);
-				_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				EnableCapability(GL_BLEND);
+				SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			}
 			else
 			{
-				_openglFunctions->glDisable(GL_BLEND);
+				DisableCapability(GL_BLEND);
 			}
 
 			if (texture.Flags & STUDIO_NF_MASKED)
 			{
-				_openglFunctions->glEnable(GL_ALPHA_TEST);
-				_openglFunctions->glAlphaFunc(GL_GREATER, 0.5f);
+				EnableCapability(GL_ALPHA_TEST);
+				SetAlphaFunc(GL_GREATER, 0.5f);
 			}
 
-			_openglFunctions->glBindTexture(GL_TEXTURE_2D, _studioModel->TextureHandles[textureIndex]);
+			BindTexture(_studioModel->TextureHandles[textureIndex]);
 		}
 
 		int i;
@@ -671,12 +694,12 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 		{
 			if (i < 0)
 			{
-				_openglFunctions->glBegin(GL_TRIANGLE_FAN);
+				BeginPrimitive(GL_TRIANGLE_FAN);
 				i = -i;
 			}
 			else
 			{
-				_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
+				BeginPrimitive(GL_TRIANGLE_STRIP);
 			}
 
 			uiDrawnPolys += i - 2;
@@ -716,12 +739,12 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 		{
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
 			{
-				_openglFunctions->glDisable(GL_BLEND);
+				DisableCapability(GL_BLEND);
 			}
 
 			if (texture.Flags & STUDIO_NF_MASKED)
 			{
-				_openglFunctions->glDisable(GL_ALPHA_TEST);
+				DisableCapability(GL_ALPHA_TEST);
 			}
 		}
 	}
@@ -745,11 +768,11 @@ unsigned int StudioModelRenderer::DrawShadows(const bool fixZFighting, const boo
 
 		if (fixZFighting)
 		{
-			_openglFunctions->glDepthMask(GL_FALSE);
+			SetDepthMask(GL_FALSE);
 		}
 		else
 		{
-			_openglFunctions->glDepthMask(GL_TRUE);
+			SetDepthMask(GL_TRUE);
 		}
 
 		const float r_blend = _renderInfo->Transparency;
@@ -758,9 +781,9 @@ unsigned int StudioModelRenderer::DrawShadows(const bool fixZFighting, const boo
 
 		const GLboolean texture2DWasEnabled = _openglFunctions->glIsEnabled(GL_TEXTURE_2D);
 
-		_openglFunctions->glDisable(GL_TEXTURE_2D);
-		_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		_openglFunctions->glEnable(GL_BLEND);
+		DisableCapability(GL_TEXTURE_2D);
+		SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		EnableCapability(GL_BLEND);
 
 		if (wireframe)
 		{
@@ -772,21 +795,21 @@ unsigned int StudioModelRenderer::DrawShadows(const bool fixZFighting, const boo
 			_openglFunctions->glColor4f(0.f, 0.f, 0.f, alpha);
 		}
 
-		_openglFunctions->glDepthFunc(GL_LESS);
+		SetDepthFunc(GL_LESS);
 
 		const auto drawnPolys = InternalDrawShadows(floorHeight);
 
-		_openglFunctions->glDepthFunc(GL_LEQUAL);
+		SetDepthFunc(GL_LEQUAL);
 
 		if (texture2DWasEnabled)
 		{
-			_openglFunctions->glEnable(GL_TEXTURE_2D);
+			EnableCapability(GL_TEXTURE_2D);
 		}
 
-		_openglFunctions->glDisable(GL_BLEND);
+		DisableCapability(GL_BLEND);
 		_openglFunctions->glColor4f(1.f, 1.f, 1.f, 1.f);
 
-		_openglFunctions->glDepthMask(static_cast<GLboolean>(oldDepthMask));
+		SetDepthMask(static_cast<GLboolean>(oldDepthMask));
 
 		return drawnPolys;
 	}
@@ -817,11 +840,11 @@ unsigned int StudioModelRenderer::InternalDrawShadows(float floorHeight)
 			if (i < 0)
 			{
 				i = -i;
-				_openglFunctions->glBegin(GL_TRIANGLE_FAN);
+				BeginPrimitive(GL_TRIANGLE_FAN);
 			}
 			else
 			{
-				_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
+				BeginPrimitive(GL_TRIANGLE_STRIP);
 			}
 
 			for (; i > 0; --i, triCmds += 4)
@@ -846,6 +869,60 @@ unsigned int StudioModelRenderer::InternalDrawShadows(float floorHeight)
 	return drawnPolys;
 }
 
+void StudioModelRenderer::BeginPrimitive(GLenum mode)
+{
+	++_statistics.DrawCalls;
+	_openglFunctions->glBegin(mode);
+}
+
+void StudioModelRenderer::EnableCapability(GLenum capability)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glEnable(capability);
+}
+
+void StudioModelRenderer::DisableCapability(GLenum capability)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glDisable(capability);
+}
+
+void StudioModelRenderer::SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glBlendFunc(sourceFactor, destinationFactor);
+}
+
+void StudioModelRenderer::SetDepthMask(GLboolean flag)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glDepthMask(flag);
+}
+
+void StudioModelRenderer::SetDepthFunc(GLenum function)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glDepthFunc(function);
+}
+
+void StudioModelRenderer::SetAlphaFunc(GLenum function, GLclampf reference)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glAlphaFunc(function, reference);
+}
+
+void StudioModelRenderer::SetPolygonMode(GLenum face, GLenum mode)
+{
+	++_statistics.StateChanges;
+	_openglFunctions->glPolygonMode(face, mode);
+}
+
+void StudioModelRenderer::BindTexture(GLuint texture)
+{
+	++_statistics.TextureBinds;
+	_openglFunctions->glBindTexture(GL_TEXTURE_2D, texture);
+}
+
 void StudioModelRenderer::Lighting(glm::vec3& lv, int bone, int flags, const glm::vec3& normal)
 {
 	const float ambient = std::max(0.f, (float)_skyLight.Ambient / 255.0f);
@@ -18,10 +18,13 @@
 #include "formats/studiomodel/StudioSorting.hpp"
 
 #include "graphics/Light.hpp"
+#include "graphics/OpenGL.hpp"
+#include "graphics/RenderStatistics.hpp"
 
 class QOpenGLFunctions_1_1;
 
 class ColorSettings;
+class ThreadPool;
 
 namespace studiomdl
 {
@@ -50,6 +53,11 @@ public:
 	*/
 	unsigned int GetDrawnPolygonsCount() const { return _drawnPolygonsCount; }
 
+	/**
+	*	@return Running totals of the work done by this renderer since it was created.
+	*/
+	const graphics::RenderCounters& GetStatistics() const { return _statistics; }
+
 	/**
 	*	@return The current lambert value. Modifier for pseudo-hemispherical lighting.
 	*/
@@ -92,6 +100,12 @@ public:
 	*/
 	unsigned int DrawModel(ModelRenderInfo& renderInfo, float floorHeight, const renderer::DrawFlags flags);
 
+	/**
+	*	@return The bone transforms of the most recently drawn model, or null if no model has been drawn yet.
+	*	Only valid until the next model is drawn.
+	*/
+	const glm::mat4x4* GetBoneTransforms() const { return _bonetransform; }
+
 	/*
 	*	Tool only operations.
 	*/
@@ -148,6 +162,22 @@ private:
 	void Lighting(glm::vec3& lv, int bone, int flags, const glm::vec3& normal);
 	void Chrome(glm::vec2& chrome, int bone, const glm::vec3& normal);
 
+	double& GetStageTime(graphics::RenderStage stage)
+	{
+		return _statistics.StageTimes[static_cast<std::size_t>(stage)];
+	}
+
+	// OpenGL wrappers that count draw calls and state changes.
+	void BeginPrimitive(GLenum mode);
+	void EnableCapability(GLenum capability);
+	void DisableCapability(GLenum capability);
+	void SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+	void SetDepthMask(GLboolean flag);
+	void SetDepthFunc(GLenum function);
+	void SetAlphaFunc(GLenum function, GLclampf reference);
+	void SetPolygonMode(GLenum face, GLenum mode);
+	void BindTexture(GLuint texture);
+
 private:
 	//TODO: need to validate model on load to ensure it does not exceed this limit
 	static constexpr int MaxVertices = 0xFFFF;
@@ -174,10 +204,15 @@ private:
 	*/
 	unsigned int _drawnPolygonsCount = 0;
 
+	graphics::RenderCounters _statistics;
+
 	glm::vec3		_xformverts[MaxVertices];		// transformed vertices
 	glm::vec3		_xformnorms[MaxVertices];
 	glm::vec3		_lightvalues[MaxVertices];	// light surface normals
 
+	//Small pool used to set up bones of large models in parallel
+	const std::unique_ptr<ThreadPool> _boneThreadPool;
+
 	BoneTransformer _boneTransformer;
 
 	const glm::mat4x4* _bonetransform{};	// bone transformation matrix
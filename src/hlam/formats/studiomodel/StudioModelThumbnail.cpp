@@ -0,0 +1,435 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "formats/studiomodel/BoneTransformer.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelThumbnail.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+/**
+*	@brief The image is rendered at this multiple of the requested size and scaled down to smooth edges.
+*/
+constexpr int SuperSampleFactor = 2;
+
+/**
+*	@brief Rotation around the up axis so the model is seen from the front left instead of straight on.
+*/
+constexpr float ViewYawDegrees = 35.f;
+
+/**
+*	@brief Fraction of the image left empty around the model.
+*/
+constexpr float Margin = 0.05f;
+
+constexpr float AmbientLight = 0.35f;
+
+struct ThumbnailVertex
+{
+	glm::vec3 Position;
+	glm::vec2 TexCoord;
+};
+
+struct ThumbnailTriangle
+{
+	std::array<ThumbnailVertex, 3> Vertices;
+	const StudioTexture* Texture;
+	float Light;
+};
+
+class Rasterizer final
+{
+public:
+	Rasterizer(int width, int height)
+		: _width(width)
+		, _height(height)
+		, _colors(static_cast<std::size_t>(width) * height, glm::vec4{0})
+		, _depth(static_cast<std::size_t>(width) * height, std::numeric_limits<float>::lowest())
+	{
+	}
+
+	int GetWidth() const { return _width; }
+	int GetHeight() const { return _height; }
+
+	const glm::vec4& GetColor(int x, int y) const { return _colors[(y * _width) + x]; }
+
+	/**
+	*	@brief Draws a triangle whose positions are in pixels, with larger depth values closer to the viewer.
+	*/
+	void DrawTriangle(const ThumbnailTriangle& triangle)
+	{
+		const auto& v0 = triangle.Vertices[0];
+		const auto& v1 = triangle.Vertices[1];
+		const auto& v2 = triangle.Vertices[2];
+
+		const float area = EdgeFunction(v0.Position, v1.Position, v2.Position);
+
+		if (std::abs(area) < 1e-6f)
+		{
+			return;
+		}
+
+		const int minX = std::max(0, static_cast<int>(std::floor(std::min({v0.Position.x, v1.Position.x, v2.Position.x}))));
+		const int maxX = std::min(_width - 1, static_cast<int>(std::ceil(std::max({v0.Position.x, v1.Position.x, v2.Position.x}))));
+		const int minY = std::max(0, static_cast<int>(std::floor(std::min({v0.Position.y, v1.Position.y, v2.Position.y}))));
+		const int maxY = std::min(_height - 1, static_cast<int>(std::ceil(std::max({v0.Position.y, v1.Position.y, v2.Position.y}))));
+
+		const auto& texture = *triangle.Texture;
+		const bool additive = (texture.Flags & STUDIO_NF_ADDITIVE) != 0;
+		const bool masked = (texture.Flags & STUDIO_NF_MASKED) != 0;
+
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				const glm::vec3 point{x + 0.5f, y + 0.5f, 0.f};
+
+				const float w0 = EdgeFunction(v1.Position, v2.Position, point) / area;
+				const float w1 = EdgeFunction(v2.Position, v0.Position, point) / area;
+				const float w2 = 1.f - w0 - w1;
+
+				if (w0 < 0 || w1 < 0 || w2 < 0)
+				{
+					continue;
+				}
+
+				const float depth = (w0 * v0.Position.z) + (w1 * v1.Position.z) + (w2 * v2.Position.z);
+
+				const std::size_t index = (static_cast<std::size_t>(y) * _width) + x;
+
+				if (depth < _depth[index])
+				{
+					continue;
+				}
+
+				const glm::vec2 texCoord = (w0 * v0.TexCoord) + (w1 * v1.TexCoord) + (w2 * v2.TexCoord);
+
+				const auto paletteIndex = SampleTexture(texture, texCoord);
+
+				if (masked && paletteIndex == graphics::RGBPalette::AlphaIndex)
+				{
+					continue;
+				}
+
+				const auto& color = texture.Data.Palette[paletteIndex];
+
+				const glm::vec3 rgb = glm::vec3{color.R, color.G, color.B} * (triangle.Light / 255.f);
+
+				if (additive)
+				{
+					// Additive surfaces don't hide what is behind them, so they don't write depth.
+					auto& target = _colors[index];
+					target = glm::vec4{glm::min(glm::vec3{target} + rgb, glm::vec3{1}), std::max(target.a, glm::length(rgb) > 0 ? 1.f : 0.f)};
+				}
+				else
+				{
+					_colors[index] = glm::vec4{rgb, 1};
+					_depth[index] = depth;
+				}
+			}
+		}
+	}
+
+private:
+	static float EdgeFunction(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		return ((c.x - a.x) * (b.y - a.y)) - ((c.y - a.y) * (b.x - a.x));
+	}
+
+	static std::size_t SampleTexture(const StudioTexture& texture, const glm::vec2& texCoord)
+	{
+		const int width = texture.Data.Width;
+		const int height = texture.Data.Height;
+
+		// Texture coordinates are in texels and wrap around like they do in the game.
+		const int s = ((static_cast<int>(std::floor(texCoord.x)) % width) + width) % width;
+		const int t = ((static_cast<int>(std::floor(texCoord.y)) % height) + height) % height;
+
+		return std::to_integer<std::size_t>(texture.Data.Pixels[(t * width) + s]);
+	}
+
+private:
+	const int _width;
+	const int _height;
+
+	std::vector<glm::vec4> _colors;
+	std::vector<float> _depth;
+};
+
+std::uint32_t PackColor(const glm::vec4& color)
+{
+	const auto toByte = [](float value)
+	{
+		return static_cast<std::uint32_t>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+	};
+
+	return (toByte(color.a) << 24) | (toByte(color.r) << 16) | (toByte(color.g) << 8) | toByte(color.b);
+}
+
+/**
+*	@brief Converts the mesh triangle commands of all visible meshes into individual triangles in view space.
+*	View space has x pointing right, y pointing up and z pointing towards the viewer.
+*/
+std::vector<ThumbnailTriangle> BuildTriangles(
+	const EditableStudioModel& studioModel, const std::array<glm::mat4x4, MAXSTUDIOBONES>& boneTransforms)
+{
+	const float yaw = glm::radians(ViewYawDegrees);
+	const float cosYaw = std::cos(yaw);
+	const float sinYaw = std::sin(yaw);
+
+	// Models face along +X with +Z up, so looking at the front means looking down -X.
+	const auto toViewSpace = [&](const glm::vec3& position)
+	{
+		const float x = (position.x * cosYaw) - (position.y * sinYaw);
+		const float y = (position.x * sinYaw) + (position.y * cosYaw);
+
+		return glm::vec3{y, position.z, x};
+	};
+
+	const glm::vec3 lightDirection = glm::normalize(glm::vec3{-0.4f, 0.6f, 1.f});
+
+	std::vector<ThumbnailTriangle> triangles;
+	std::vector<glm::vec3> transformedVertices;
+
+	if (studioModel.SkinFamilies.empty())
+	{
+		return triangles;
+	}
+
+	const auto& skinFamily = studioModel.SkinFamilies[0];
+
+	for (std::size_t bodypart = 0; bodypart < studioModel.Bodyparts.size(); ++bodypart)
+	{
+		if (studioModel.Bodyparts[bodypart]->Models.empty())
+		{
+			continue;
+		}
+
+		const auto model = studioModel.GetModelByBodyPart(0, static_cast<int>(bodypart));
+
+		transformedVertices.resize(model->Vertices.size());
+
+		for (std::size_t i = 0; i < model->Vertices.size(); ++i)
+		{
+			const auto& vertex = model->Vertices[i];
+			const auto& boneTransform = vertex.Bone ? boneTransforms[vertex.Bone->ArrayIndex] : boneTransforms[0];
+			transformedVertices[i] = toViewSpace(boneTransform * glm::vec4{vertex.Vertex, 1});
+		}
+
+		for (const auto& mesh : model->Meshes)
+		{
+			if (mesh.SkinRef < 0 || static_cast<std::size_t>(mesh.SkinRef) >= skinFamily.size())
+			{
+				continue;
+			}
+
+			const int textureIndex = skinFamily[mesh.SkinRef];
+
+			if (textureIndex < 0 || static_cast<std::size_t>(textureIndex) >= studioModel.Textures.size())
+			{
+				continue;
+			}
+
+			const auto texture = studioModel.Textures[textureIndex].get();
+
+			if (texture->Data.Width <= 0 || texture->Data.Height <= 0 || texture->Data.Pixels.empty())
+			{
+				continue;
+			}
+
+			const bool fullbright = (texture->Flags & (STUDIO_NF_FULLBRIGHT | STUDIO_NF_ADDITIVE)) != 0;
+
+			const auto addTriangle = [&](const short* a, const short* b, const short* c)
+			{
+				ThumbnailTriangle triangle;
+
+				triangle.Texture = texture;
+
+				const std::array<const short*, 3> vertexCommands{a, b, c};
+
+				for (std::size_t i = 0; i < vertexCommands.size(); ++i)
+				{
+					triangle.Vertices[i].Position = transformedVertices[vertexCommands[i][0]];
+					triangle.Vertices[i].TexCoord = glm::vec2{vertexCommands[i][2], vertexCommands[i][3]};
+				}
+
+				const glm::vec3 normal = glm::cross(
+					triangle.Vertices[1].Position - triangle.Vertices[0].Position,
+					triangle.Vertices[2].Position - triangle.Vertices[0].Position);
+
+				const float length = glm::length(normal);
+
+				// Triangle winding is not consistent between strips and fans, so light both sides.
+				triangle.Light = fullbright || length <= 0
+					? 1.f
+					: AmbientLight + ((1.f - AmbientLight) * std::abs(glm::dot(normal / length, lightDirection)));
+
+				triangles.push_back(triangle);
+			};
+
+			const short* commands = mesh.Triangles.data();
+			const short* const end = commands + mesh.Triangles.size();
+
+			for (int count; commands < end && (count = *(commands++)) != 0;)
+			{
+				const bool isFan = count < 0;
+				count = std::abs(count);
+
+				if (commands + (count * 4) > end)
+				{
+					break;
+				}
+
+				const auto vertexCommand = [&](int index)
+				{
+					return commands + (index * 4);
+				};
+
+				bool vertexIndicesValid = true;
+
+				for (int i = 0; i < count; ++i)
+				{
+					const int vertexIndex = vertexCommand(i)[0];
+					vertexIndicesValid = vertexIndicesValid
+						&& vertexIndex >= 0 && static_cast<std::size_t>(vertexIndex) < transformedVertices.size();
+				}
+
+				if (vertexIndicesValid)
+				{
+					for (int i = 2; i < count; ++i)
+					{
+						if (isFan)
+						{
+							addTriangle(vertexCommand(0), vertexCommand(i - 1), vertexCommand(i));
+						}
+						else
+						{
+							addTriangle(vertexCommand(i - 2), vertexCommand(i - 1), vertexCommand(i));
+						}
+					}
+				}
+
+				commands += count * 4;
+			}
+		}
+	}
+
+	return triangles;
+}
+}
+
+ThumbnailImage RenderStudioModelThumbnail(const EditableStudioModel& studioModel, int size)
+{
+	ThumbnailImage image;
+
+	if (size <= 0)
+	{
+		return image;
+	}
+
+	image.Width = size;
+	image.Height = size;
+	image.Pixels.resize(static_cast<std::size_t>(size) * size, 0);
+
+	std::array<glm::mat4x4, MAXSTUDIOBONES> boneTransforms;
+	boneTransforms.fill(glm::mat4x4{1});
+
+	if (!studioModel.Sequences.empty())
+	{
+		// Too large for the stack of worker threads on some platforms.
+		const auto boneTransformer = std::make_unique<BoneTransformer>();
+		boneTransforms = boneTransformer->SetUpBones(studioModel, {0, 0, glm::vec3{1}, {}, {}, 0});
+	}
+
+	auto triangles = BuildTriangles(studioModel, boneTransforms);
+
+	if (triangles.empty())
+	{
+		return image;
+	}
+
+	glm::vec3 minimum{std::numeric_limits<float>::max()};
+	glm::vec3 maximum{std::numeric_limits<float>::lowest()};
+
+	for (const auto& triangle : triangles)
+	{
+		for (const auto& vertex : triangle.Vertices)
+		{
+			minimum = glm::min(minimum, vertex.Position);
+			maximum = glm::max(maximum, vertex.Position);
+		}
+	}
+
+	const int renderSize = size * SuperSampleFactor;
+
+	const glm::vec2 extents{maximum.x - minimum.x, maximum.y - minimum.y};
+	const float largestExtent = std::max({extents.x, extents.y, 1e-3f});
+	const float scale = (renderSize * (1.f - (2.f * Margin))) / largestExtent;
+
+	const glm::vec2 center{(minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f};
+
+	Rasterizer rasterizer{renderSize, renderSize};
+
+	// Convert to pixels with y pointing down, keeping the model centered.
+	for (auto& triangle : triangles)
+	{
+		for (auto& vertex : triangle.Vertices)
+		{
+			vertex.Position.x = ((vertex.Position.x - center.x) * scale) + (renderSize * 0.5f);
+			vertex.Position.y = ((center.y - vertex.Position.y) * scale) + (renderSize * 0.5f);
+		}
+	}
+
+	// Draw solid surfaces first so additive surfaces can be depth tested against them.
+	std::stable_partition(triangles.begin(), triangles.end(), [](const auto& triangle)
+		{
+			return (triangle.Texture->Flags & STUDIO_NF_ADDITIVE) == 0;
+		});
+
+	for (const auto& triangle : triangles)
+	{
+		rasterizer.DrawTriangle(triangle);
+	}
+
+	// Average each block of samples, weighting colors by coverage so edges don't darken.
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			glm::vec3 color{0};
+			float alpha = 0;
+
+			for (int sy = 0; sy < SuperSampleFactor; ++sy)
+			{
+				for (int sx = 0; sx < SuperSampleFactor; ++sx)
+				{
+					const auto& sample = rasterizer.GetColor((x * SuperSampleFactor) + sx, (y * SuperSampleFactor) + sy);
+					color += glm::vec3{sample} * sample.a;
+					alpha += sample.a;
+				}
+			}
+
+			if (alpha > 0)
+			{
+				image.Pixels[(y * size) + x] = PackColor(
+					glm::vec4{color / alpha, alpha / (SuperSampleFactor * SuperSampleFactor)});
+			}
+		}
+	}
+
+	return image;
+}
+}
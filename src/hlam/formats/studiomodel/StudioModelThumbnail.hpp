@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace studiomdl
+{
+class EditableStudioModel;
+
+/**
+*	@brief Image with 32 bit pixels stored as 0xAARRGGBB, not premultiplied.
+*/
+struct ThumbnailImage
+{
+	int Width{};
+	int Height{};
+	std::vector<std::uint32_t> Pixels;
+};
+
+/**
+*	@brief Renders a small preview of a model in its first sequence using a software rasterizer.
+*	Does not need a graphics context, so it can be used on any thread.
+*	The model is viewed from the front at an angle and scaled to fit. Pixels not covered by the model are transparent.
+*/
+ThumbnailImage RenderStudioModelThumbnail(const EditableStudioModel& studioModel, int size);
+}
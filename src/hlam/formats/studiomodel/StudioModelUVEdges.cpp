@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelUVEdges.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+std::uint32_t PackCoordinates(short s, short t)
+{
+	return (static_cast<std::uint32_t>(static_cast<std::uint16_t>(s)) << 16) | static_cast<std::uint16_t>(t);
+}
+
+short UnpackS(std::uint32_t coordinates)
+{
+	return static_cast<short>(static_cast<std::uint16_t>(coordinates >> 16));
+}
+
+short UnpackT(std::uint32_t coordinates)
+{
+	return static_cast<short>(static_cast<std::uint16_t>(coordinates & 0xFFFF));
+}
+
+/**
+*	@brief Packs an edge so both directions produce the same key.
+*/
+void AddEdge(std::vector<std::uint64_t>& keys, const short* first, const short* second)
+{
+	std::uint32_t a = PackCoordinates(first[2], first[3]);
+	std::uint32_t b = PackCoordinates(second[2], second[3]);
+
+	if (a == b)
+	{
+		return;
+	}
+
+	if (a > b)
+	{
+		std::swap(a, b);
+	}
+
+	keys.push_back((static_cast<std::uint64_t>(a) << 32) | b);
+}
+}
+
+std::vector<UVEdge> ExtractUVEdges(const std::vector<const StudioMesh*>& meshes)
+{
+	std::vector<std::uint64_t> keys;
+
+	for (const auto mesh : meshes)
+	{
+		keys.reserve(keys.size() + (static_cast<std::size_t>(mesh->NumTriangles) * 3));
+
+		auto triCommands = mesh->Triangles.data();
+
+		for (int i; i = *(triCommands++);)
+		{
+			const bool isFan = i < 0;
+
+			i = std::abs(i);
+
+			// Each vertex is 4 shorts; the texture coordinates are the last 2.
+			for (int vertex = 2; vertex < i; ++vertex)
+			{
+				const short* current = triCommands + (vertex * 4);
+				const short* previous = current - 4;
+				const short* first = isFan ? triCommands : (current - 8);
+
+				if (vertex == 2)
+				{
+					AddEdge(keys, first, previous);
+				}
+
+				AddEdge(keys, previous, current);
+				AddEdge(keys, current, first);
+			}
+
+			triCommands += i * 4;
+		}
+	}
+
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	std::vector<UVEdge> edges;
+	edges.reserve(keys.size());
+
+	for (const auto key : keys)
+	{
+		const auto a = static_cast<std::uint32_t>(key >> 32);
+		const auto b = static_cast<std::uint32_t>(key & 0xFFFFFFFF);
+
+		edges.push_back({UnpackS(a), UnpackT(a), UnpackS(b), UnpackT(b)});
+	}
+
+	return edges;
+}
+}
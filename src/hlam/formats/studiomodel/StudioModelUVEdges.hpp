@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+namespace studiomdl
+{
+struct StudioMesh;
+
+/**
+*	@brief A line between two texture coordinates, in texels.
+*	Laid out as two consecutive 2D vertices so a list of edges can be drawn directly as lines.
+*/
+struct UVEdge
+{
+	short S0{}, T0{};
+	short S1{}, T1{};
+};
+
+/**
+*	@brief Gets the edges of all triangles in @p meshes.
+*	Edges shared by multiple triangles are included only once, and edges of zero length are left out.
+*/
+std::vector<UVEdge> ExtractUVEdges(const std::vector<const StudioMesh*>& meshes);
+}
@@ -5,10 +5,12 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "application/AssetIO.hpp"
 
+#include "formats/studiomodel/AnimationCompression.hpp"
 #include "formats/studiomodel/StudioModelUtils.hpp"
 
 #include "utility/Platform.hpp"
@@ -800,44 +802,187 @@ EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
 
 namespace
 {
-template<typename T>
-T* AllocateBufferArray(std::vector<std::byte>& buffer, std::size_t count)
+/**
+*	@brief Fixed size buffer that studio model data is written to sequentially.
+*	The size is calculated up front so the data is written exactly once and never reallocated.
+*/
+class StudioModelWriteBuffer final
 {
-	const auto position = buffer.size();
-	buffer.resize(position + sizeof(T) * count);
+public:
+	explicit StudioModelWriteBuffer(std::size_t capacity)
+		: _data(std::make_unique<std::byte[]>(capacity))
+		, _capacity(capacity)
+	{
+	}
+
+	std::byte* GetData() const { return _data.get(); }
+
+	std::size_t GetSize() const { return _size; }
 
-	return reinterpret_cast<T*>(buffer.data() + position);
+	std::size_t GetCapacity() const { return _capacity; }
+
+	/**
+	*	@brief Reserves the next @p sizeInBytes bytes. The returned memory is zero initialized.
+	*/
+	std::byte* Allocate(std::size_t sizeInBytes)
+	{
+		if (sizeInBytes > _capacity - _size)
+		{
+			throw std::logic_error("Studio model size calculation does not match data written");
+		}
+
+		const auto position = _size;
+		_size += sizeInBytes;
+
+		return _data.get() + position;
+	}
+
+	std::unique_ptr<std::byte[]> Release()
+	{
+		return std::move(_data);
+	}
+
+private:
+	std::unique_ptr<std::byte[]> _data;
+	const std::size_t _capacity;
+	std::size_t _size{};
+};
+
+template<typename T>
+T* AllocateBufferArray(StudioModelWriteBuffer& buffer, std::size_t count)
+{
+	return reinterpret_cast<T*>(buffer.Allocate(sizeof(T) * count));
 }
 
-static void WriteRawBytes(std::vector<std::byte>& buffer, const std::byte* data, std::size_t sizeInBytes)
+static void WriteRawBytes(StudioModelWriteBuffer& buffer, const std::byte* data, std::size_t sizeInBytes)
 {
-	const auto position = buffer.size();
-	buffer.resize(position + sizeInBytes);
-	std::memcpy(buffer.data() + position, data, sizeInBytes);
+	std::memcpy(buffer.Allocate(sizeInBytes), data, sizeInBytes);
 }
 
 template<typename T>
-static void WriteBytes(std::vector<std::byte>& buffer, const T& data)
+static void WriteBytes(StudioModelWriteBuffer& buffer, const T& data)
 {
 	WriteRawBytes(buffer, reinterpret_cast<const std::byte*>(&data), sizeof(data));
 }
 
-static void AlignBuffer(std::vector<std::byte>& buffer)
+constexpr std::size_t AlignSize(std::size_t size)
 {
-	const std::size_t remainder = buffer.size() % 4;
+	return (size + 3) & ~static_cast<std::size_t>(3);
+}
+
+static void AlignBuffer(StudioModelWriteBuffer& buffer)
+{
+	//Align start of next data to a 4 byte boundary. Memory is already zeroed so the padding only needs to be skipped
+	buffer.Allocate(AlignSize(buffer.GetSize()) - buffer.GetSize());
+}
 
-	if (remainder != 0)
+/**
+*	@brief Calculates the exact size of the data written by ConvertFromEditable.
+*	Must follow the same layout, including alignment, as the Convert*FromEditable functions.
+*	@param compressedAnimations If not null, the animation data that will be written instead of the model's own data.
+*/
+std::size_t CalculateStudioModelSize(const EditableStudioModel& studioModel,
+	const std::vector<CompressedSequenceAnimations>* compressedAnimations)
+{
+	std::size_t size = sizeof(studiohdr_t);
+
+	//Bones
+	size += studioModel.Bones.size() * sizeof(mstudiobone_t);
+	size = AlignSize(size + (studioModel.BoneControllers.size() * sizeof(mstudiobonecontroller_t)));
+
+	size = AlignSize(size + (studioModel.Attachments.size() * sizeof(mstudioattachment_t)));
+	size = AlignSize(size + (studioModel.Hitboxes.size() * sizeof(mstudiobbox_t)));
+
+	//Animations
+	for (std::size_t i = 0; i < studioModel.Sequences.size(); ++i)
 	{
-		//Align start of next data to a 4 byte boundary
-		const std::size_t bytesToAdd = 4 - remainder;
+		const auto& sequence = *studioModel.Sequences[i];
+
+		size = AlignSize(size + (sequence.AnimationBlends.size() * studioModel.Bones.size() * sizeof(mstudioanim_t)));
+
+		if (compressedAnimations)
+		{
+			for (const auto& values : (*compressedAnimations)[i].Streams)
+			{
+				size += values.size() * sizeof(mstudioanimvalue_t);
+			}
+		}
+		else
+		{
+			for (const auto& blend : sequence.AnimationBlends)
+			{
+				for (std::size_t bone = 0; bone < studioModel.Bones.size(); ++bone)
+				{
+					for (const auto& values : blend[bone].Data)
+					{
+						size += values.size() * sizeof(mstudioanimvalue_t);
+					}
+				}
+			}
+		}
 
-		const std::byte pad[3]{};
+		size = AlignSize(size);
+	}
+
+	//Sequences
+	size += studioModel.Sequences.size() * sizeof(mstudioseqdesc_t);
 
-		WriteRawBytes(buffer, pad, bytesToAdd);
+	for (const auto& sequence : studioModel.Sequences)
+	{
+		size = AlignSize(size + (sequence->SortedEvents.size() * sizeof(mstudioevent_t)));
+		size = AlignSize(size + (sequence->Pivots.size() * sizeof(mstudiopivot_t)));
 	}
+
+	size = AlignSize(size + (studioModel.SequenceGroups.size() * sizeof(mstudioseqgroup_t)));
+	size = AlignSize(size + (studioModel.Transitions.size() * studioModel.Transitions.size()));
+
+	//Bodyparts
+	size += studioModel.Bodyparts.size() * sizeof(mstudiobodyparts_t);
+
+	for (const auto& bodypart : studioModel.Bodyparts)
+	{
+		size += bodypart->Models.size() * sizeof(mstudiomodel_t);
+	}
+
+	for (const auto& bodypart : studioModel.Bodyparts)
+	{
+		for (const auto& model : bodypart->Models)
+		{
+			size = AlignSize(size + model.Vertices.size());
+			size = AlignSize(size + model.Normals.size());
+			size = AlignSize(size + (model.Vertices.size() * sizeof(glm::vec3)));
+			size = AlignSize(size + (model.Normals.size() * sizeof(glm::vec3)));
+
+			size += model.Meshes.size() * sizeof(mstudiomesh_t);
+
+			for (const auto& mesh : model.Meshes)
+			{
+				size = AlignSize(size + (mesh.Triangles.size() * sizeof(short)));
+			}
+		}
+	}
+
+	size = AlignSize(size);
+
+	//Textures
+	size = AlignSize(size + (studioModel.Textures.size() * sizeof(mstudiotexture_t)));
+
+	for (const auto& skinFamily : studioModel.SkinFamilies)
+	{
+		size += skinFamily.size() * sizeof(short);
+	}
+
+	size = AlignSize(size);
+
+	for (const auto& texture : studioModel.Textures)
+	{
+		size += texture->Data.Pixels.size() + sizeof(texture->Data.Palette);
+	}
+
+	return AlignSize(size);
 }
 
-void ConvertBonesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertBonesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	assert(MAXSTUDIOCONTROLLERS >= studioModel.BoneControllers.size());
 
@@ -845,7 +990,7 @@ void ConvertBonesFromEditable(const EditableStudioModel& studioModel, studiohdr_
 
 	{
 		header.numbones = studioModel.Bones.size();
-		header.boneindex = buffer.size();
+		header.boneindex = buffer.GetSize();
 
 		auto bones = AllocateBufferArray<mstudiobone_t>(buffer, studioModel.Bones.size());
 
@@ -880,7 +1025,7 @@ void ConvertBonesFromEditable(const EditableStudioModel& studioModel, studiohdr_
 
 	{
 		header.numbonecontrollers = studioModel.BoneControllers.size();
-		header.bonecontrollerindex = buffer.size();
+		header.bonecontrollerindex = buffer.GetSize();
 
 		auto boneControllers = AllocateBufferArray<mstudiobonecontroller_t>(buffer, studioModel.BoneControllers.size());
 
@@ -900,10 +1045,10 @@ void ConvertBonesFromEditable(const EditableStudioModel& studioModel, studiohdr_
 	}
 }
 
-void ConvertAttachmentsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertAttachmentsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numattachments = studioModel.Attachments.size();
-	header.attachmentindex = buffer.size();
+	header.attachmentindex = buffer.GetSize();
 
 	auto attachments = AllocateBufferArray<mstudioattachment_t>(buffer, studioModel.Attachments.size());
 
@@ -926,10 +1071,10 @@ void ConvertAttachmentsFromEditable(const EditableStudioModel& studioModel, stud
 	AlignBuffer(buffer);
 }
 
-void ConvertHitboxesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertHitboxesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numhitboxes = studioModel.Hitboxes.size();
-	header.hitboxindex = buffer.size();
+	header.hitboxindex = buffer.GetSize();
 
 	auto hitboxes = AllocateBufferArray<mstudiobbox_t>(buffer, studioModel.Hitboxes.size());
 
@@ -947,7 +1092,8 @@ void ConvertHitboxesFromEditable(const EditableStudioModel& studioModel, studioh
 	AlignBuffer(buffer);
 }
 
-std::vector<std::size_t> ConvertAnimationsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+std::vector<std::size_t> ConvertAnimationsFromEditable(const EditableStudioModel& studioModel,
+	const std::vector<CompressedSequenceAnimations>* compressedAnimations, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	std::vector<std::size_t> sequenceAnimationIndices;
 
@@ -961,34 +1107,63 @@ std::vector<std::size_t> ConvertAnimationsFromEditable(const EditableStudioModel
 
 		animations.resize(source.AnimationBlends.size() * studioModel.Bones.size());
 
-		sequenceAnimationIndices.push_back(buffer.size());
+		sequenceAnimationIndices.push_back(buffer.GetSize());
 		
 		//Allocate the space for the offsets array, but don't write to it yet
 		AllocateBufferArray<mstudioanim_t>(buffer, animations.size());
 
 		AlignBuffer(buffer);
 
-		for (std::size_t blend = 0; blend < source.AnimationBlends.size(); ++blend)
+		if (compressedAnimations)
 		{
-			for (std::size_t bone = 0; bone < studioModel.Bones.size(); ++bone)
+			const auto& compressed = (*compressedAnimations)[i];
+
+			std::vector<std::size_t> streamOffsets;
+			streamOffsets.reserve(compressed.Streams.size());
+
+			for (const auto& stream : compressed.Streams)
 			{
-				auto& destOffsets = animations[(blend * studioModel.Bones.size()) + bone];
+				streamOffsets.push_back(buffer.GetSize() - sequenceAnimationIndices.back());
+				WriteRawBytes(buffer, reinterpret_cast<const std::byte*>(stream.data()), stream.size() * sizeof(mstudioanimvalue_t));
+			}
 
+			for (std::size_t anim = 0; anim < animations.size(); ++anim)
+			{
 				for (int axis = 0; axis < STUDIO_NUM_COORDINATE_AXES; ++axis)
 				{
-					const auto& sourceOffsets = source.AnimationBlends[blend][bone].Data[axis];
+					const int streamIndex = compressed.StreamIndices[(anim * STUDIO_NUM_COORDINATE_AXES) + axis];
 
-					if (sourceOffsets.size() == 0)
-					{
-						destOffsets.offset[axis] = 0;
-					}
-					else
+					//Shared streams are always written after all of the sequence's offsets, so these are never negative
+					animations[anim].offset[axis] = streamIndex != -1
+						? streamOffsets[streamIndex] - (anim * sizeof(mstudioanim_t))
+						: 0;
+				}
+			}
+		}
+		else
+		{
+			for (std::size_t blend = 0; blend < source.AnimationBlends.size(); ++blend)
+			{
+				for (std::size_t bone = 0; bone < studioModel.Bones.size(); ++bone)
+				{
+					auto& destOffsets = animations[(blend * studioModel.Bones.size()) + bone];
+
+					for (int axis = 0; axis < STUDIO_NUM_COORDINATE_AXES; ++axis)
 					{
-						//Offsets are relative to the current animation, not relative to start of the buffer
-						destOffsets.offset[axis] = (buffer.size() - sequenceAnimationIndices.back())
-							- (((blend * studioModel.Bones.size()) + bone) * sizeof(mstudioanim_t));
+						const auto& sourceOffsets = source.AnimationBlends[blend][bone].Data[axis];
+
+						if (sourceOffsets.size() == 0)
+						{
+							destOffsets.offset[axis] = 0;
+						}
+						else
+						{
+							//Offsets are relative to the current animation, not relative to start of the buffer
+							destOffsets.offset[axis] = (buffer.GetSize() - sequenceAnimationIndices.back())
+								- (((blend * studioModel.Bones.size()) + bone) * sizeof(mstudioanim_t));
 
-						WriteRawBytes(buffer, reinterpret_cast<const std::byte*>(sourceOffsets.data()), sourceOffsets.size() * sizeof(mstudioanimvalue_t));
+							WriteRawBytes(buffer, reinterpret_cast<const std::byte*>(sourceOffsets.data()), sourceOffsets.size() * sizeof(mstudioanimvalue_t));
+						}
 					}
 				}
 			}
@@ -997,17 +1172,17 @@ std::vector<std::size_t> ConvertAnimationsFromEditable(const EditableStudioModel
 		AlignBuffer(buffer);
 
 		//Copy the finished animations array
-		std::memcpy(buffer.data() + sequenceAnimationIndices.back(), animations.data(), animations.size() * sizeof(mstudioanim_t));
+		std::memcpy(buffer.GetData() + sequenceAnimationIndices.back(), animations.data(), animations.size() * sizeof(mstudioanim_t));
 	}
 
 	return sequenceAnimationIndices;
 }
 
 void ConvertSequencesFromEditable(const EditableStudioModel& studioModel, const std::vector<std::size_t>& sequenceAnimationIndices,
-	studiohdr_t& header, std::vector<std::byte>& buffer)
+	studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numseq = studioModel.Sequences.size();
-	header.seqindex = buffer.size();
+	header.seqindex = buffer.GetSize();
 
 	std::vector<mstudioseqdesc_t> sequences;
 
@@ -1062,7 +1237,7 @@ void ConvertSequencesFromEditable(const EditableStudioModel& studioModel, const
 		dest.nextseq = source.NextSequence;
 
 		{
-			dest.eventindex = buffer.size();
+			dest.eventindex = buffer.GetSize();
 			dest.numevents = source.SortedEvents.size();
 
 			auto events = AllocateBufferArray<mstudioevent_t>(buffer, source.SortedEvents.size());
@@ -1082,7 +1257,7 @@ void ConvertSequencesFromEditable(const EditableStudioModel& studioModel, const
 		}
 
 		{
-			dest.pivotindex = buffer.size();
+			dest.pivotindex = buffer.GetSize();
 			dest.numpivots = source.Pivots.size();
 
 			auto pivots = AllocateBufferArray<mstudiopivot_t>(buffer, source.Pivots.size());
@@ -1104,13 +1279,13 @@ void ConvertSequencesFromEditable(const EditableStudioModel& studioModel, const
 	}
 
 	//Copy the finished sequences array
-	std::memcpy(buffer.data() + header.seqindex, sequences.data(), sequences.size() * sizeof(mstudioseqdesc_t));
+	std::memcpy(buffer.GetData() + header.seqindex, sequences.data(), sequences.size() * sizeof(mstudioseqdesc_t));
 }
 
-void ConvertSequenceGroupsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertSequenceGroupsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numseqgroups = studioModel.SequenceGroups.size();
-	header.seqgroupindex = buffer.size();
+	header.seqgroupindex = buffer.GetSize();
 
 	auto groups = AllocateBufferArray<mstudioseqgroup_t>(buffer, studioModel.SequenceGroups.size());
 
@@ -1129,10 +1304,10 @@ void ConvertSequenceGroupsFromEditable(const EditableStudioModel& studioModel, s
 	AlignBuffer(buffer);
 }
 
-void ConvertTransitionsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertTransitionsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numtransitions = studioModel.Transitions.size();
-	header.transitionindex = buffer.size();
+	header.transitionindex = buffer.GetSize();
 
 	auto transitions = AllocateBufferArray<std::byte>(buffer, studioModel.Transitions.size() * studioModel.Transitions.size());
 
@@ -1146,10 +1321,10 @@ void ConvertTransitionsFromEditable(const EditableStudioModel& studioModel, stud
 	AlignBuffer(buffer);
 }
 
-void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numbodyparts = studioModel.Bodyparts.size();
-	header.bodypartindex = buffer.size();
+	header.bodypartindex = buffer.GetSize();
 
 	//Allocate the space for the sequences array, but don't write to it yet
 	AllocateBufferArray<mstudiobodyparts_t>(buffer, studioModel.Bodyparts.size());
@@ -1158,7 +1333,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 
 	bodyparts.reserve(header.numbodyparts);
 
-	std::size_t modelsOffset = buffer.size();
+	std::size_t modelsOffset = buffer.GetSize();
 
 	//Allocate the entire models array upfront to match the compiler
 	{
@@ -1200,7 +1375,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 
 			{
 				destModel.numverts = sourceModel.Vertices.size();
-				destModel.vertinfoindex = buffer.size();
+				destModel.vertinfoindex = buffer.GetSize();
 
 				auto vertexInfo = AllocateBufferArray<std::uint8_t>(buffer, destModel.numverts);
 
@@ -1214,7 +1389,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 
 			{
 				destModel.numnorms = sourceModel.Normals.size();
-				destModel.norminfoindex = buffer.size();
+				destModel.norminfoindex = buffer.GetSize();
 
 				auto normalInfo = AllocateBufferArray<std::uint8_t>(buffer, destModel.numnorms);
 
@@ -1227,7 +1402,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 			}
 
 			{
-				destModel.vertindex = buffer.size();
+				destModel.vertindex = buffer.GetSize();
 
 				auto vertices = AllocateBufferArray<glm::vec3>(buffer, destModel.numverts);
 
@@ -1240,7 +1415,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 			}
 
 			{
-				destModel.normindex = buffer.size();
+				destModel.normindex = buffer.GetSize();
 
 				auto normals = AllocateBufferArray<glm::vec3>(buffer, destModel.numnorms);
 
@@ -1254,7 +1429,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 
 			{
 				destModel.nummesh = sourceModel.Meshes.size();
-				destModel.meshindex = buffer.size();
+				destModel.meshindex = buffer.GetSize();
 
 				AllocateBufferArray<mstudiomesh_t>(buffer, destModel.nummesh);
 
@@ -1273,7 +1448,7 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 					destMesh.numnorms = sourceMesh.NumNorms;
 					destMesh.normindex = 0;
 
-					destMesh.triindex = buffer.size();
+					destMesh.triindex = buffer.GetSize();
 
 					auto trianglesCmdBuffer = AllocateBufferArray<short>(buffer, sourceMesh.Triangles.size());
 
@@ -1284,13 +1459,13 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 					meshes.push_back(destMesh);
 				}
 
-				std::memcpy(buffer.data() + destModel.meshindex, meshes.data(), meshes.size() * sizeof(mstudiomesh_t));
+				std::memcpy(buffer.GetData() + destModel.meshindex, meshes.data(), meshes.size() * sizeof(mstudiomesh_t));
 			}
 
 			models.push_back(destModel);
 		}
 
-		std::memcpy(buffer.data() + bodypart.modelindex, models.data(), models.size() * sizeof(mstudiomodel_t));
+		std::memcpy(buffer.GetData() + bodypart.modelindex, models.data(), models.size() * sizeof(mstudiomodel_t));
 
 		bodyparts.push_back(bodypart);
 	}
@@ -1298,13 +1473,13 @@ void ConvertBodypartsFromEditable(const EditableStudioModel& studioModel, studio
 	AlignBuffer(buffer);
 
 	//Copy the finished bodyparts array
-	std::memcpy(buffer.data() + header.bodypartindex, bodyparts.data(), bodyparts.size() * sizeof(mstudiobodyparts_t));
+	std::memcpy(buffer.GetData() + header.bodypartindex, bodyparts.data(), bodyparts.size() * sizeof(mstudiobodyparts_t));
 }
 
-void ConvertTexturesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, std::vector<std::byte>& buffer)
+void ConvertTexturesFromEditable(const EditableStudioModel& studioModel, studiohdr_t& header, StudioModelWriteBuffer& buffer)
 {
 	header.numtextures = studioModel.Textures.size();
-	header.textureindex = buffer.size();
+	header.textureindex = buffer.GetSize();
 
 	//Initialized below
 	AllocateBufferArray<mstudiotexture_t>(buffer, studioModel.Textures.size());
@@ -1312,7 +1487,7 @@ void ConvertTexturesFromEditable(const EditableStudioModel& studioModel, studioh
 
 	header.numskinfamilies = studioModel.SkinFamilies.size();
 	header.numskinref = !studioModel.SkinFamilies.empty() ? studioModel.SkinFamilies[0].size() : 0;
-	header.skinindex = buffer.size();
+	header.skinindex = buffer.GetSize();
 
 	for (std::size_t i = 0; i < studioModel.SkinFamilies.size(); ++i)
 	{
@@ -1328,20 +1503,20 @@ void ConvertTexturesFromEditable(const EditableStudioModel& studioModel, studioh
 
 	AlignBuffer(buffer);
 
-	header.texturedataindex = buffer.size();
+	header.texturedataindex = buffer.GetSize();
 
 	for (int i = 0; i < header.numtextures; ++i)
 	{
 		const auto& source = *studioModel.Textures[i];
 
 		{
-			auto& dest = *(reinterpret_cast<mstudiotexture_t*>(buffer.data() + header.textureindex) + i);
+			auto& dest = *(reinterpret_cast<mstudiotexture_t*>(buffer.GetData() + header.textureindex) + i);
 
 			UTIL_CopyString(dest.name, source.Name.c_str());
 			dest.flags = source.Flags;
 			dest.width = source.Data.Width;
 			dest.height = source.Data.Height;
-			dest.index = buffer.size();
+			dest.index = buffer.GetSize();
 		}
 
 		auto textureData = AllocateBufferArray<std::byte>(buffer, source.Data.Pixels.size() + sizeof(source.Data.Palette));
@@ -1354,22 +1529,25 @@ void ConvertTexturesFromEditable(const EditableStudioModel& studioModel, studioh
 }
 }
 
-/**
-*	@brief The initial size of the buffer used for conversion. Matches the compiler, helps to avoid constant reallocations.
-*/
-constexpr std::size_t StudioModelBufferSize = 16 * 1024 * 1024;
-
-StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel)
+StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel,
+	const ConvertFromEditableOptions& options)
 {
 	//Use a local header until all data is written, then write the header to the start of the buffer
-	//This avoids having to reacquire the header pointer every time the buffer is reallocated
 	studiohdr_t header{};
 
 	std::memset(&header, 0, sizeof(header));
 
-	std::vector<std::byte> buffer;
+	std::vector<CompressedSequenceAnimations> compressedAnimations;
 
-	buffer.reserve(StudioModelBufferSize);
+	if (options.CompressAnimations)
+	{
+		compressedAnimations = CompressAnimations(studioModel, options.Pool);
+	}
+
+	const auto compressedAnimationsPointer = options.CompressAnimations ? &compressedAnimations : nullptr;
+
+	//The size is known up front so the data can be written directly into the memory the model takes ownership of
+	StudioModelWriteBuffer buffer{CalculateStudioModelSize(studioModel, compressedAnimationsPointer)};
 
 	//Write dummy header
 	WriteBytes(buffer, header);
@@ -1392,7 +1570,7 @@ StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const Edi
 	ConvertHitboxesFromEditable(studioModel, header, buffer);
 
 	{
-		const auto animationIndices = ConvertAnimationsFromEditable(studioModel, header, buffer);
+		const auto animationIndices = ConvertAnimationsFromEditable(studioModel, compressedAnimationsPointer, header, buffer);
 		ConvertSequencesFromEditable(studioModel, animationIndices, header, buffer);
 	}
 
@@ -1401,19 +1579,21 @@ StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const Edi
 	ConvertBodypartsFromEditable(studioModel, header, buffer);
 	ConvertTexturesFromEditable(studioModel, header, buffer);
 
-	header.length = buffer.size();
+	if (buffer.GetSize() != buffer.GetCapacity())
+	{
+		throw std::logic_error("Studio model size calculation does not match data written");
+	}
 
-	//Copy completed header into buffer
-	std::memcpy(buffer.data(), &header, sizeof(header));
+	const std::size_t size = buffer.GetSize();
 
-	//Create standalone copy for transfer
-	auto studioHeader = std::make_unique<std::byte[]>(buffer.size());
+	header.length = size;
 
-	std::memcpy(studioHeader.get(), buffer.data(), buffer.size());
+	//Copy completed header into buffer
+	std::memcpy(buffer.GetData(), &header, sizeof(header));
 
 	return StudioModel{StudioPtr<studiohdr_t>
 	{
-		reinterpret_cast<studiohdr_t*>(studioHeader.release()), buffer.size()},
+		reinterpret_cast<studiohdr_t*>(buffer.Release().release()), size},
 		{},
 		{},
 		false
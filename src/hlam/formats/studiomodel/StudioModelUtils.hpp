@@ -5,12 +5,29 @@
 #include "formats/studiomodel/EditableStudioModel.hpp"
 #include "formats/studiomodel/StudioModel.hpp"
 
+class ThreadPool;
+
 namespace studiomdl
 {
 class StudioModel;
 
+struct ConvertFromEditableOptions
+{
+	/**
+	*	@brief Re-encode animation data as compactly as possible instead of writing it as it was loaded.
+	*	@see CompressAnimations
+	*/
+	bool CompressAnimations = false;
+
+	/**
+	*	@brief Optional pool used to compress animations in parallel.
+	*/
+	ThreadPool* Pool = nullptr;
+};
+
 EditableStudioModel ConvertToEditable(const StudioModel& studioModel);
-StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel);
+StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel,
+	const ConvertFromEditableOptions& options = {});
 
 /**
 *	@brief Detects whether the given model is a Xash model.
@@ -0,0 +1,562 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "graphics/ColorQuantizer.hpp"
+
+#include "utility/ThreadPool.hpp"
+
+namespace graphics
+{
+namespace
+{
+/**
+*	@brief Colors are grouped by their 5 most significant bits per channel when building the palette.
+*/
+constexpr int HistogramBits = 5;
+constexpr std::size_t HistogramSize = std::size_t{1} << (HistogramBits * 3);
+
+/**
+*	@brief Images with fewer pixels than this are processed on the calling thread.
+*/
+constexpr std::size_t ParallelPixelThreshold = 256 * 256;
+
+constexpr std::size_t RowsPerTask = 32;
+
+constexpr std::uint32_t AlphaThreshold = 128;
+
+constexpr std::uint32_t GetAlpha(std::uint32_t pixel) { return pixel >> 24; }
+constexpr int GetRed(std::uint32_t pixel) { return (pixel >> 16) & 0xFF; }
+constexpr int GetGreen(std::uint32_t pixel) { return (pixel >> 8) & 0xFF; }
+constexpr int GetBlue(std::uint32_t pixel) { return pixel & 0xFF; }
+
+constexpr std::size_t GetHistogramIndex(int r, int g, int b)
+{
+	constexpr int shift = 8 - HistogramBits;
+	return (static_cast<std::size_t>(r >> shift) << (HistogramBits * 2))
+		| (static_cast<std::size_t>(g >> shift) << HistogramBits)
+		| static_cast<std::size_t>(b >> shift);
+}
+
+struct HistogramEntry
+{
+	std::uint64_t Count{};
+	std::array<std::uint64_t, 3> Sums{};
+};
+
+using Histogram = std::vector<HistogramEntry>;
+
+/**
+*	@brief A set of histogram entries that will be represented by a single palette color.
+*/
+struct ColorBox
+{
+	std::vector<std::uint32_t> Entries;
+	std::uint64_t Count{};
+	std::array<int, 3> Minimum{};
+	std::array<int, 3> Maximum{};
+
+	int GetLongestAxis() const
+	{
+		int axis = 0;
+
+		for (int i = 1; i < 3; ++i)
+		{
+			if ((Maximum[i] - Minimum[i]) > (Maximum[axis] - Minimum[axis]))
+			{
+				axis = i;
+			}
+		}
+
+		return axis;
+	}
+
+	int GetRange() const
+	{
+		const int axis = GetLongestAxis();
+		return Maximum[axis] - Minimum[axis];
+	}
+};
+
+std::array<int, 3> GetHistogramCoordinates(std::uint32_t index)
+{
+	constexpr std::uint32_t mask = (1 << HistogramBits) - 1;
+	return {static_cast<int>((index >> (HistogramBits * 2)) & mask), static_cast<int>((index >> HistogramBits) & mask), static_cast<int>(index & mask)};
+}
+
+void UpdateBounds(ColorBox& box, const Histogram& histogram)
+{
+	box.Minimum.fill(std::numeric_limits<int>::max());
+	box.Maximum.fill(std::numeric_limits<int>::min());
+	box.Count = 0;
+
+	for (const auto entry : box.Entries)
+	{
+		const auto coordinates = GetHistogramCoordinates(entry);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			box.Minimum[i] = std::min(box.Minimum[i], coordinates[i]);
+			box.Maximum[i] = std::max(box.Maximum[i], coordinates[i]);
+		}
+
+		box.Count += histogram[entry].Count;
+	}
+}
+
+/**
+*	@brief Runs @p function for each range of rows, in parallel if the image is large enough and a pool is available.
+*/
+template<typename Function>
+void ForEachRowRange(int width, int height, ThreadPool* pool, Function&& function)
+{
+	const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+
+	if (!pool || pixelCount < ParallelPixelThreshold)
+	{
+		function(0, height);
+		return;
+	}
+
+	const std::size_t taskCount = (static_cast<std::size_t>(height) + RowsPerTask - 1) / RowsPerTask;
+
+	pool->ParallelFor(taskCount, [&](std::size_t task)
+		{
+			const int begin = static_cast<int>(task * RowsPerTask);
+			function(begin, std::min(height, begin + static_cast<int>(RowsPerTask)));
+		});
+}
+
+/**
+*	@brief Finds the nearest palette color for any color. Palette colors are stored per channel
+*	so the distance computation over all entries vectorizes.
+*/
+class NearestColorSearch final
+{
+public:
+	NearestColorSearch(const RGBPalette& palette, std::size_t colorCount)
+		: _colorCount(colorCount)
+	{
+		for (std::size_t i = 0; i < colorCount; ++i)
+		{
+			_red[i] = palette[i].R;
+			_green[i] = palette[i].G;
+			_blue[i] = palette[i].B;
+		}
+	}
+
+	std::uint8_t Find(int r, int g, int b) const
+	{
+		std::array<std::int32_t, RGBPalette::EntriesCount> distances;
+
+		for (std::size_t i = 0; i < _colorCount; ++i)
+		{
+			const std::int32_t dr = _red[i] - r;
+			const std::int32_t dg = _green[i] - g;
+			const std::int32_t db = _blue[i] - b;
+
+			// Weighted to approximate perceived brightness differences.
+			distances[i] = (dr * dr * 3) + (dg * dg * 4) + (db * db * 2);
+		}
+
+		return static_cast<std::uint8_t>(std::min_element(distances.begin(), distances.begin() + _colorCount) - distances.begin());
+	}
+
+private:
+	const std::size_t _colorCount;
+
+	std::array<std::int32_t, RGBPalette::EntriesCount> _red{};
+	std::array<std::int32_t, RGBPalette::EntriesCount> _green{};
+	std::array<std::int32_t, RGBPalette::EntriesCount> _blue{};
+};
+
+/**
+*	@brief Uses the image's own colors if there are few enough of them.
+*	@return Whether the image was converted
+*/
+bool TryUseExactColors(int width, int height, const std::uint32_t* pixels, bool masked, std::size_t maximumColors,
+	std::byte* indices, RGBPalette& palette)
+{
+	const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+
+	std::unordered_map<std::uint32_t, std::uint8_t> colors;
+
+	for (std::size_t i = 0; i < pixelCount; ++i)
+	{
+		const std::uint32_t pixel = pixels[i];
+
+		if (masked && GetAlpha(pixel) < AlphaThreshold)
+		{
+			indices[i] = std::byte(RGBPalette::AlphaIndex);
+			continue;
+		}
+
+		const std::uint32_t rgb = pixel & 0xFFFFFF;
+
+		auto it = colors.find(rgb);
+
+		if (it == colors.end())
+		{
+			if (colors.size() >= maximumColors)
+			{
+				return false;
+			}
+
+			const auto index = static_cast<std::uint8_t>(colors.size());
+
+			palette[index] = RGB24{static_cast<std::uint8_t>(GetRed(rgb)), static_cast<std::uint8_t>(GetGreen(rgb)),
+				static_cast<std::uint8_t>(GetBlue(rgb))};
+
+			it = colors.emplace(rgb, index).first;
+		}
+
+		indices[i] = std::byte(it->second);
+	}
+
+	return true;
+}
+
+Histogram BuildHistogram(int width, int height, const std::uint32_t* pixels, bool masked, ThreadPool* pool)
+{
+	const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+
+	// Histograms are large, so rows are split into one range per thread instead of many small tasks,
+	// each of which would need its own histogram. The calling thread also does work.
+	std::size_t rangeCount = 1;
+
+	if (pool && pixelCount >= ParallelPixelThreshold)
+	{
+		rangeCount = std::clamp<std::size_t>(pool->GetThreadCount() + 1, 1, static_cast<std::size_t>(height));
+	}
+
+	std::vector<Histogram> partialHistograms(rangeCount, Histogram(HistogramSize));
+
+	const auto buildRange = [&](std::size_t range)
+		{
+			auto& histogram = partialHistograms[range];
+
+			const int beginRow = static_cast<int>((static_cast<std::size_t>(height) * range) / rangeCount);
+			const int endRow = static_cast<int>((static_cast<std::size_t>(height) * (range + 1)) / rangeCount);
+
+			for (int y = beginRow; y < endRow; ++y)
+			{
+				const std::uint32_t* row = pixels + (static_cast<std::size_t>(y) * width);
+
+				for (int x = 0; x < width; ++x)
+				{
+					const std::uint32_t pixel = row[x];
+
+					if (masked && GetAlpha(pixel) < AlphaThreshold)
+					{
+						continue;
+					}
+
+					const int r = GetRed(pixel);
+					const int g = GetGreen(pixel);
+					const int b = GetBlue(pixel);
+
+					auto& entry = histogram[GetHistogramIndex(r, g, b)];
+
+					++entry.Count;
+					entry.Sums[0] += r;
+					entry.Sums[1] += g;
+					entry.Sums[2] += b;
+				}
+			}
+		};
+
+	if (rangeCount > 1)
+	{
+		pool->ParallelFor(rangeCount, buildRange);
+	}
+	else
+	{
+		buildRange(0);
+	}
+
+	Histogram result = std::move(partialHistograms.front());
+
+	for (std::size_t i = 1; i < partialHistograms.size(); ++i)
+	{
+		const auto& histogram = partialHistograms[i];
+
+		for (std::size_t entry = 0; entry < HistogramSize; ++entry)
+		{
+			result[entry].Count += histogram[entry].Count;
+
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				result[entry].Sums[channel] += histogram[entry].Sums[channel];
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+*	@brief Chooses up to @p maximumColors palette colors using median cut.
+*	@return Number of colors written to the palette
+*/
+std::size_t ChoosePaletteColors(const Histogram& histogram, std::size_t maximumColors, RGBPalette& palette)
+{
+	std::vector<ColorBox> boxes;
+
+	{
+		ColorBox box;
+
+		for (std::uint32_t i = 0; i < HistogramSize; ++i)
+		{
+			if (histogram[i].Count > 0)
+			{
+				box.Entries.push_back(i);
+			}
+		}
+
+		if (box.Entries.empty())
+		{
+			return 0;
+		}
+
+		UpdateBounds(box, histogram);
+		boxes.push_back(std::move(box));
+	}
+
+	while (boxes.size() < maximumColors)
+	{
+		// Split the box that covers the widest range of colors, weighted by how many pixels use it.
+		auto it = std::max_element(boxes.begin(), boxes.end(), [](const auto& lhs, const auto& rhs)
+			{
+				return (lhs.Entries.size() > 1 ? lhs.Count * lhs.GetRange() : 0)
+					< (rhs.Entries.size() > 1 ? rhs.Count * rhs.GetRange() : 0);
+			});
+
+		if (it->Entries.size() <= 1)
+		{
+			break;
+		}
+
+		const int axis = it->GetLongestAxis();
+
+		std::sort(it->Entries.begin(), it->Entries.end(), [&](auto lhs, auto rhs)
+			{
+				return GetHistogramCoordinates(lhs)[axis] < GetHistogramCoordinates(rhs)[axis];
+			});
+
+		// Split at the median pixel so both halves cover about the same number of pixels.
+		std::uint64_t count = 0;
+		std::size_t split = 1;
+
+		for (; split < it->Entries.size() - 1; ++split)
+		{
+			count += histogram[it->Entries[split - 1]].Count;
+
+			if (count * 2 >= it->Count)
+			{
+				break;
+			}
+		}
+
+		ColorBox upper;
+		upper.Entries.assign(it->Entries.begin() + split, it->Entries.end());
+		it->Entries.resize(split);
+
+		UpdateBounds(*it, histogram);
+		UpdateBounds(upper, histogram);
+
+		boxes.push_back(std::move(upper));
+	}
+
+	for (std::size_t i = 0; i < boxes.size(); ++i)
+	{
+		std::array<std::uint64_t, 3> sums{};
+
+		for (const auto entry : boxes[i].Entries)
+		{
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				sums[channel] += histogram[entry].Sums[channel];
+			}
+		}
+
+		const auto count = std::max<std::uint64_t>(boxes[i].Count, 1);
+
+		palette[i] = RGB24{static_cast<std::uint8_t>((sums[0] + (count / 2)) / count),
+			static_cast<std::uint8_t>((sums[1] + (count / 2)) / count),
+			static_cast<std::uint8_t>((sums[2] + (count / 2)) / count)};
+	}
+
+	return boxes.size();
+}
+
+void MapPixels(int width, int height, const std::uint32_t* pixels, const ColorQuantizerOptions& options,
+	const std::vector<std::uint8_t>& lookup, std::byte* indices)
+{
+	ForEachRowRange(width, height, options.Pool, [&](int beginRow, int endRow)
+		{
+			for (int y = beginRow; y < endRow; ++y)
+			{
+				const std::size_t rowStart = static_cast<std::size_t>(y) * width;
+
+				for (int x = 0; x < width; ++x)
+				{
+					const std::uint32_t pixel = pixels[rowStart + x];
+
+					if (options.Masked && GetAlpha(pixel) < AlphaThreshold)
+					{
+						indices[rowStart + x] = std::byte(RGBPalette::AlphaIndex);
+					}
+					else
+					{
+						indices[rowStart + x] = std::byte(lookup[GetHistogramIndex(GetRed(pixel), GetGreen(pixel), GetBlue(pixel))]);
+					}
+				}
+			}
+		});
+}
+
+void MapPixelsDithered(int width, int height, const std::uint32_t* pixels, const ColorQuantizerOptions& options,
+	const RGBPalette& palette, const std::vector<std::uint8_t>& lookup, std::byte* indices)
+{
+	// Error for the current and next row, with a pixel of padding on each side.
+	std::vector<std::array<int, 3>> currentErrors(static_cast<std::size_t>(width) + 2);
+	std::vector<std::array<int, 3>> nextErrors(static_cast<std::size_t>(width) + 2);
+
+	for (int y = 0; y < height; ++y)
+	{
+		std::fill(nextErrors.begin(), nextErrors.end(), std::array<int, 3>{});
+
+		const std::size_t rowStart = static_cast<std::size_t>(y) * width;
+
+		for (int x = 0; x < width; ++x)
+		{
+			const std::uint32_t pixel = pixels[rowStart + x];
+
+			if (options.Masked && GetAlpha(pixel) < AlphaThreshold)
+			{
+				indices[rowStart + x] = std::byte(RGBPalette::AlphaIndex);
+				continue;
+			}
+
+			const auto& error = currentErrors[x + 1];
+
+			// Errors are stored multiplied by 16 to keep the fractions of the diffusion weights.
+			const int r = std::clamp(GetRed(pixel) + (error[0] / 16), 0, 255);
+			const int g = std::clamp(GetGreen(pixel) + (error[1] / 16), 0, 255);
+			const int b = std::clamp(GetBlue(pixel) + (error[2] / 16), 0, 255);
+
+			const std::uint8_t index = lookup[GetHistogramIndex(r, g, b)];
+
+			indices[rowStart + x] = std::byte(index);
+
+			const auto& color = palette[index];
+			const std::array<int, 3> difference{r - color.R, g - color.G, b - color.B};
+
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				currentErrors[x + 2][channel] += difference[channel] * 7;
+				nextErrors[x][channel] += difference[channel] * 3;
+				nextErrors[x + 1][channel] += difference[channel] * 5;
+				nextErrors[x + 2][channel] += difference[channel];
+			}
+		}
+
+		std::swap(currentErrors, nextErrors);
+	}
+}
+}
+
+void QuantizeImage(int width, int height, const std::uint32_t* pixels, const ColorQuantizerOptions& options,
+	std::byte* indices, RGBPalette& palette)
+{
+	assert(width >= 0 && height >= 0);
+
+	palette = {};
+
+	const std::size_t maximumColors = options.Masked ? RGBPalette::AlphaIndex : RGBPalette::EntriesCount;
+
+	if (options.Masked)
+	{
+		palette.GetAlpha() = RGB24{0, 0, 255};
+	}
+
+	if (width == 0 || height == 0)
+	{
+		return;
+	}
+
+	if (TryUseExactColors(width, height, pixels, options.Masked, maximumColors, indices, palette))
+	{
+		return;
+	}
+
+	const Histogram histogram = BuildHistogram(width, height, pixels, options.Masked, options.Pool);
+
+	const std::size_t colorCount = ChoosePaletteColors(histogram, maximumColors, palette);
+
+	if (colorCount == 0)
+	{
+		// Only possible if all pixels are transparent, which the exact color path already handles.
+		return;
+	}
+
+	// Map every histogram cell to its nearest palette color once instead of searching for every pixel.
+	// Dithering can produce colors that are not in the image, so it needs the whole table.
+	std::vector<std::uint8_t> lookup(HistogramSize);
+
+	{
+		const NearestColorSearch search{palette, colorCount};
+
+		constexpr int shift = 8 - HistogramBits;
+		constexpr int halfCell = 1 << (shift - 1);
+
+		const auto mapCell = [&](std::size_t cell)
+		{
+			const auto coordinates = GetHistogramCoordinates(static_cast<std::uint32_t>(cell));
+			lookup[cell] = search.Find((coordinates[0] << shift) + halfCell, (coordinates[1] << shift) + halfCell,
+				(coordinates[2] << shift) + halfCell);
+		};
+
+		constexpr std::size_t CellsPerTask = 1024;
+
+		const auto mapCells = [&](std::size_t task)
+		{
+			const std::size_t end = std::min(HistogramSize, (task + 1) * CellsPerTask);
+
+			for (std::size_t cell = task * CellsPerTask; cell < end; ++cell)
+			{
+				if (options.Dither || histogram[cell].Count > 0)
+				{
+					mapCell(cell);
+				}
+			}
+		};
+
+		const std::size_t taskCount = HistogramSize / CellsPerTask;
+
+		if (options.Pool)
+		{
+			options.Pool->ParallelFor(taskCount, mapCells);
+		}
+		else
+		{
+			for (std::size_t task = 0; task < taskCount; ++task)
+			{
+				mapCells(task);
+			}
+		}
+	}
+
+	if (options.Dither)
+	{
+		MapPixelsDithered(width, height, pixels, options, palette, lookup, indices);
+	}
+	else
+	{
+		MapPixels(width, height, pixels, options, lookup, indices);
+	}
+}
+}
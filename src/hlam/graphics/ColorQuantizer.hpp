@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "graphics/Palette.hpp"
+
+class ThreadPool;
+
+namespace graphics
+{
+struct ColorQuantizerOptions
+{
+	/**
+	*	@brief Reserve palette index RGBPalette::AlphaIndex for transparent pixels, as used by masked textures.
+	*	Pixels with alpha below 128 are mapped to that index, which is set to blue.
+	*/
+	bool Masked = false;
+
+	/**
+	*	@brief Spread the error introduced by reducing colors to neighboring pixels using Floyd-Steinberg dithering.
+	*	Dithering processes pixels in order, so only the palette search uses multiple threads.
+	*/
+	bool Dither = false;
+
+	/**
+	*	@brief Optional pool used to build histograms and map pixels in parallel.
+	*/
+	ThreadPool* Pool = nullptr;
+};
+
+/**
+*	@brief Reduces a 32 bit image to an 8 bit indexed image with a palette of at most 256 colors.
+*	If the image has no more colors than fit in the palette they are used as-is, otherwise the palette is chosen using median cut.
+*	@param pixels <tt>width * height</tt> pixels in 0xAARRGGBB format.
+*	@param indices Output buffer. Must hold <tt>width * height</tt> bytes.
+*	@param palette Output palette. Unused entries are set to black.
+*/
+void QuantizeImage(int width, int height, const std::uint32_t* pixels, const ColorQuantizerOptions& options,
+	std::byte* indices, RGBPalette& palette);
+}
@@ -0,0 +1,45 @@
+#include <glm/geometric.hpp>
+
+#include "graphics/Frustum.hpp"
+
+namespace graphics
+{
+Frustum::Frustum(const glm::mat4x4& viewProjection)
+{
+	// glm matrices are column major, so each row is spread across the columns.
+	const auto getRow = [&](int row)
+	{
+		return glm::vec4{viewProjection[0][row], viewProjection[1][row], viewProjection[2][row], viewProjection[3][row]};
+	};
+
+	const glm::vec4 x = getRow(0);
+	const glm::vec4 y = getRow(1);
+	const glm::vec4 z = getRow(2);
+	const glm::vec4 w = getRow(3);
+
+	_planes = {w + x, w - x, w + y, w - y, w + z, w - z};
+
+	for (auto& plane : _planes)
+	{
+		const float length = glm::length(glm::vec3{plane});
+
+		if (length > 0)
+		{
+			plane /= length;
+		}
+	}
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+{
+	for (const auto& plane : _planes)
+	{
+		if (glm::dot(glm::vec3{plane}, center) + plane.w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+}
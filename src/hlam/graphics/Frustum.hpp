@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace graphics
+{
+/**
+*	@brief The volume visible to a camera, as 6 planes that face inwards.
+*/
+class Frustum
+{
+public:
+	Frustum() = default;
+
+	/**
+	*	@brief Extracts the planes from a combined projection and view matrix.
+	*/
+	explicit Frustum(const glm::mat4x4& viewProjection);
+
+	/**
+	*	@brief Whether any part of a sphere may be visible.
+	*	Spheres near a corner of the frustum can be reported as visible even if they are not.
+	*/
+	bool IntersectsSphere(const glm::vec3& center, float radius) const;
+
+private:
+	std::array<glm::vec4, 6> _planes{};
+};
+}
@@ -1,8 +1,4 @@
 #include <algorithm>
-#include <cassert>
-#include <charconv>
-#include <cmath>
-#include <cstring>
 
 #include <QOpenGLFunctions_1_1>
 
@@ -17,48 +13,8 @@
 #include "graphics/GraphicsUtils.hpp"
 #include "graphics/Palette.hpp"
 
-#include "utility/Platform.hpp"
-
 namespace graphics
 {
-void Convert8to24Bit(const int iWidth, const int iHeight, const std::byte* const pData, const RGBPalette& palette, std::byte* const pOutData)
-{
-	assert(pData);
-	assert(pOutData);
-
-	std::byte* pOut = pOutData;
-
-	for (int y = 0; y < iHeight; ++y)
-	{
-		for (int x = 0; x < iWidth; ++x, pOut += 3)
-		{
-			pOut[0] = std::byte{palette[std::to_integer<int>(pData[x + y * iWidth])].R};
-			pOut[1] = std::byte{palette[std::to_integer<int>(pData[x + y * iWidth])].G};
-			pOut[2] = std::byte{palette[std::to_integer<int>(pData[x + y * iWidth])].B};
-		}
-	}
-}
-
-void FlipImageVertically(const int iWidth, const int iHeight, std::byte* const pData)
-{
-	assert(iWidth > 0);
-	assert(iHeight > 0);
-	assert(pData);
-
-	const int iHalfHeight = iHeight / 2;
-
-	for (int y = iHalfHeight; y < iHeight; ++y)
-	{
-		for (int x = 0; x < iWidth; ++x)
-		{
-			for (int i = 0; i < 3; ++i)
-			{
-				std::swap(pData[(x + y * iWidth) * 3 + i], pData[(x + (iHeight - y - 1) * iWidth) * 3 + i]);
-			}
-		}
-	}
-}
-
 void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, GLuint backgroundTexture)
 {
 	if (backgroundTexture == GL_INVALID_TEXTURE_ID)
@@ -167,131 +123,6 @@ void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions,
 	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 }
 
-const std::string_view DmBaseName{"DM_Base.bmp"};
-const std::string_view RemapName{"Remap"};
-
-const std::size_t SimpleRemapLength = 18;
-const std::size_t FullRemapLength = 22;
-
-const std::size_t LowOffset = 7;
-const std::size_t MidOffset = 11;
-const std::size_t HighOffset = 15;
-const std::size_t ValueLength = 3;
-
-bool TryGetRemapColors(std::string_view fileName, int& low, int& mid, int& high)
-{
-	if (fileName.length() == DmBaseName.length() &&
-		!strncasecmp(fileName.data(), DmBaseName.data(), DmBaseName.length()))
-	{
-		low = 160;
-		mid = 191;
-		high = 223;
-
-		return true;
-	}
-	else if ((fileName.length() == SimpleRemapLength || fileName.length() == FullRemapLength) &&
-		!strncasecmp(fileName.data(), RemapName.data(), RemapName.length()))
-	{
-		//from_chars does not set the out value unless parsing succeeds, unlike atoi which the engine uses
-		low = mid = high = 0;
-
-		if (fileName.length() == SimpleRemapLength)
-		{
-			const auto index = fileName[RemapName.length()];
-
-			if (index != 'c' && index != 'C')
-			{
-				return false;
-			}
-		}
-		else
-		{
-			std::from_chars(fileName.data() + HighOffset, fileName.data() + HighOffset + ValueLength, high);
-		}
-
-		std::from_chars(fileName.data() + LowOffset, fileName.data() + LowOffset + ValueLength, low);
-		std::from_chars(fileName.data() + MidOffset, fileName.data() + MidOffset + ValueLength, mid);
-
-		//Clamp to valid range
-		low = std::clamp(low, 0, 255);
-		// Allow mid to be -1 if low is 0.
-		// In this case the top color won't be applied at all and bottom will affect the first color as well.
-		mid = std::clamp(mid, low == 0 ? -1 : 0, 255);
-		high = std::clamp(high, 0, 255);
-
-		return true;
-	}
-
-	return false;
-}
-
-void PaletteHueReplace(RGBPalette& palette, int newHue, int start, int end)
-{
-	const auto hue = (float)(newHue * (360.0 / 255));
-
-	for (int i = start; i <= end; ++i)
-	{
-		float r = palette[i].R;
-		float g = palette[i].G;
-		float b = palette[i].B;
-
-		const auto maxcol = std::max({r, g, b}) / 255.0f;
-		auto mincol = std::min({r, g, b}) / 255.0f;
-
-		const auto val = maxcol;
-		const auto sat = (maxcol - mincol) / maxcol;
-
-		mincol = val * (1.0f - sat);
-
-		if (hue <= 120)
-		{
-			b = mincol;
-			if (hue < 60)
-			{
-				r = val;
-				g = mincol + hue * (val - mincol) / (120 - hue);
-			}
-			else
-			{
-				g = val;
-				r = mincol + (120 - hue) * (val - mincol) / hue;
-			}
-		}
-		else if (hue <= 240)
-		{
-			r = mincol;
-			if (hue < 180)
-			{
-				g = val;
-				b = mincol + (hue - 120) * (val - mincol) / (240 - hue);
-			}
-			else
-			{
-				b = val;
-				g = mincol + (240 - hue) * (val - mincol) / (hue - 120);
-			}
-		}
-		else
-		{
-			g = mincol;
-			if (hue < 300)
-			{
-				b = val;
-				r = mincol + (hue - 240) * (val - mincol) / (360 - hue);
-			}
-			else
-			{
-				r = val;
-				b = mincol + (360 - hue) * (val - mincol) / (hue - 240);
-			}
-		}
-
-		palette[i].R = static_cast<std::uint8_t>(r * 255);
-		palette[i].G = static_cast<std::uint8_t>(g * 255);
-		palette[i].B = static_cast<std::uint8_t>(b * 255);
-	}
-}
-
 void SetupRenderMode(QOpenGLFunctions_1_1* openglFunctions, RenderMode renderMode, const bool bBackfaceCulling)
 {
 	switch (renderMode)
@@ -4,13 +4,13 @@
 #include <array>
 #include <cstddef>
 #include <optional>
-#include <string_view>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
 #include "graphics/GraphicsConstants.hpp"
+#include "graphics/ImageUtils.hpp"
 #include "graphics/OpenGL.hpp"
 #include "graphics/Palette.hpp"
 
@@ -23,19 +23,6 @@ class StudioModelRenderer;
 
 namespace graphics
 {
-/**
-*	Converts an 8 bit image to a 24 bit RGB image.
-*/
-void Convert8to24Bit(const int iWidth, const int iHeight, const std::byte* const pData, const RGBPalette& palette, std::byte* const pOutData);
-
-/**
-*	Flips an image vertically. This allows conversion between OpenGL and image formats. The image is flipped in place.
-*	@param iWidth Image width, in pixels.
-*	@param iHeight Image height, in pixels.
-*	@param pData Pixel data, in RGB 24 bit.
-*/
-void FlipImageVertically(const int iWidth, const int iHeight, std::byte* const pData);
-
 /**
 *	Draws a background texture, fitted to the viewport.
 *	@param backgroundTexture OpenGL texture id that represents the background texture
@@ -67,13 +54,6 @@ void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3,
 void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions,
 	const std::array<glm::vec3, 8>& points, const glm::vec4& faceColor, const glm::vec4& borderColor);
 
-/**
-*	@brief Tests if the given filename is a remap name, and returns the remap ranges if so
-*/
-bool TryGetRemapColors(std::string_view fileName, int& low, int& mid, int& high);
-
-void PaletteHueReplace(RGBPalette& palette, int newHue, int start, int end);
-
 /*
 *	Sets up OpenGL for the specified render mode.
 *	@param renderMode Render mode to set up. Must be valid.
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "graphics/Palette.hpp"
+
+/**
+*	@file
+*
+*	Image conversion functions that don't depend on a graphics API.
+*/
+
+namespace graphics
+{
+/**
+*	Converts an 8 bit image to a 24 bit RGB image.
+*/
+void Convert8to24Bit(const int iWidth, const int iHeight, const std::byte* const pData, const RGBPalette& palette, std::byte* const pOutData);
+
+/**
+*	@brief Converts an 8 bit image to a 32 bit RGBA image.
+*	@param masked If true, pixels using the last palette color are made fully transparent.
+*	@param rgbaPixels Output buffer. Must hold <tt>width * height * 4</tt> bytes.
+*/
+void ConvertIndexed8ToRGBA8888(int width, int height, const std::byte* pixels, const RGBPalette& palette, bool masked, std::byte* rgbaPixels);
+
+/**
+*	Flips an image vertically. This allows conversion between OpenGL and image formats. The image is flipped in place.
+*	@param iWidth Image width, in pixels.
+*	@param iHeight Image height, in pixels.
+*	@param pData Pixel data, in RGB 24 bit.
+*/
+void FlipImageVertically(const int iWidth, const int iHeight, std::byte* const pData);
+
+/**
+*	@brief Tests if the given filename is a remap name, and returns the remap ranges if so
+*/
+bool TryGetRemapColors(std::string_view fileName, int& low, int& mid, int& high);
+
+void PaletteHueReplace(RGBPalette& palette, int newHue, int start, int end);
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+
+#include "graphics/RenderStatistics.hpp"
+
+namespace graphics
+{
+const char* RenderStageToString(RenderStage stage)
+{
+	switch (stage)
+	{
+	case RenderStage::BoneSetup: return "Bone Setup";
+	case RenderStage::Skinning: return "Skinning";
+	case RenderStage::Lighting: return "Lighting";
+	case RenderStage::DrawSubmission: return "Draw Submission";
+
+	default: return "Invalid";
+	}
+}
+
+std::size_t GetRenderPassIndex(RenderPass::RenderPass renderPass)
+{
+	switch (renderPass)
+	{
+	case RenderPass::Background: return 0;
+	case RenderPass::Standard: return 1;
+	case RenderPass::Ground: return 2;
+	case RenderPass::Overlay3D: return 3;
+	case RenderPass::Overlay2D: return 4;
+
+	default: return RenderPassCount;
+	}
+}
+
+const char* RenderPassIndexToString(std::size_t index)
+{
+	switch (index)
+	{
+	case 0: return "Background";
+	case 1: return "Standard";
+	case 2: return "Ground";
+	case 3: return "Overlay 3D";
+	case 4: return "Overlay 2D";
+
+	default: return "Invalid";
+	}
+}
+
+RenderCounters operator-(const RenderCounters& lhs, const RenderCounters& rhs)
+{
+	RenderCounters result;
+
+	for (std::size_t i = 0; i < RenderStageCount; ++i)
+	{
+		result.StageTimes[i] = lhs.StageTimes[i] - rhs.StageTimes[i];
+	}
+
+	result.DrawCalls = lhs.DrawCalls - rhs.DrawCalls;
+	result.StateChanges = lhs.StateChanges - rhs.StateChanges;
+	result.TextureBinds = lhs.TextureBinds - rhs.TextureBinds;
+
+	return result;
+}
+
+void RenderStatisticsHistory::AddFrame(const RenderFrameStatistics& frame)
+{
+	if (_frames.size() >= MaximumFrameCount)
+	{
+		_frames.pop_front();
+	}
+
+	_frames.push_back(frame);
+	++_totalFrameCount;
+}
+
+void RenderStatisticsHistory::Clear()
+{
+	_frames.clear();
+	_totalFrameCount = 0;
+}
+
+RenderStatisticsHistory::Histogram RenderStatisticsHistory::GetHistogram() const
+{
+	Histogram histogram{};
+
+	for (const auto& frame : _frames)
+	{
+		const auto bucket = static_cast<std::size_t>(std::max(0.0, frame.CPUTime / HistogramBucketSize));
+		++histogram[std::min(bucket, HistogramBucketCount - 1)];
+	}
+
+	return histogram;
+}
+
+void RenderStatisticsHistory::WriteCSV(std::ostream& stream) const
+{
+	stream << "Frame,CPU Time (ms),GPU Time (ms)";
+
+	for (std::size_t i = 0; i < RenderPassCount; ++i)
+	{
+		stream << ',' << RenderPassIndexToString(i) << " Pass (ms)";
+	}
+
+	for (std::size_t i = 0; i < RenderStageCount; ++i)
+	{
+		stream << ',' << RenderStageToString(static_cast<RenderStage>(i)) << " (ms)";
+	}
+
+	stream << ",Draw Calls,State Changes,Texture Binds,Polygons,Culled Entities\n";
+
+	// Number frames so they match the total count, even if older frames were discarded.
+	std::uint64_t frameNumber = _totalFrameCount - _frames.size();
+
+	for (const auto& frame : _frames)
+	{
+		stream << frameNumber++ << ',' << frame.CPUTime << ',';
+
+		if (frame.GPUTime)
+		{
+			stream << *frame.GPUTime;
+		}
+
+		for (const auto passTime : frame.PassTimes)
+		{
+			stream << ',' << passTime;
+		}
+
+		for (const auto stageTime : frame.Counters.StageTimes)
+		{
+			stream << ',' << stageTime;
+		}
+
+		stream << ',' << frame.Counters.DrawCalls
+			<< ',' << frame.Counters.StateChanges
+			<< ',' << frame.Counters.TextureBinds
+			<< ',' << frame.Polygons
+			<< ',' << frame.CulledEntities
+			<< '\n';
+	}
+}
+}
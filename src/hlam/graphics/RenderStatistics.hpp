@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ostream>
+
+#include "graphics/GraphicsConstants.hpp"
+
+namespace graphics
+{
+/**
+*	@brief CPU work done by the studio model renderer, timed separately.
+*/
+enum class RenderStage
+{
+	BoneSetup = 0,
+	Skinning,
+	Lighting,
+	DrawSubmission,
+
+	Count
+};
+
+constexpr std::size_t RenderStageCount = static_cast<std::size_t>(RenderStage::Count);
+
+const char* RenderStageToString(RenderStage stage);
+
+/**
+*	@brief Number of render passes in RenderPass::RenderPass.
+*/
+constexpr std::size_t RenderPassCount = 5;
+
+/**
+*	@brief Gets the index of a single render pass, in the order in which passes are drawn.
+*/
+std::size_t GetRenderPassIndex(RenderPass::RenderPass renderPass);
+
+const char* RenderPassIndexToString(std::size_t index);
+
+/**
+*	@brief Running totals kept by the renderer. Subtract two snapshots to get the work done in between.
+*/
+struct RenderCounters
+{
+	/**
+	*	@brief Time spent in each RenderStage, in milliseconds.
+	*/
+	std::array<double, RenderStageCount> StageTimes{};
+
+	std::uint64_t DrawCalls{};
+	std::uint64_t StateChanges{};
+	std::uint64_t TextureBinds{};
+};
+
+RenderCounters operator-(const RenderCounters& lhs, const RenderCounters& rhs);
+
+/**
+*	@brief Statistics for a single drawn frame. Times are in milliseconds.
+*/
+struct RenderFrameStatistics
+{
+	double CPUTime{};
+
+	/**
+	*	@brief Most recent GPU time available when this frame was drawn.
+	*	GPU results arrive a frame or two late, so this usually belongs to an earlier frame.
+	*	Not set if timer queries are not supported.
+	*/
+	std::optional<double> GPUTime;
+
+	std::array<double, RenderPassCount> PassTimes{};
+
+	RenderCounters Counters;
+
+	unsigned int Polygons{};
+
+	/**
+	*	@brief Number of entities that were not drawn because they were outside the camera's view.
+	*/
+	unsigned int CulledEntities{};
+};
+
+/**
+*	@brief Adds the elapsed time in milliseconds to a value when it goes out of scope.
+*/
+class ScopedRenderTimer final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit ScopedRenderTimer(double& target)
+		: _target(target)
+		, _start(Clock::now())
+	{
+	}
+
+	~ScopedRenderTimer()
+	{
+		_target += std::chrono::duration<double, std::milli>{Clock::now() - _start}.count();
+	}
+
+	ScopedRenderTimer(const ScopedRenderTimer&) = delete;
+	ScopedRenderTimer& operator=(const ScopedRenderTimer&) = delete;
+
+private:
+	double& _target;
+	const Clock::time_point _start;
+};
+
+/**
+*	@brief Keeps statistics for the most recently drawn frames.
+*/
+class RenderStatisticsHistory final
+{
+public:
+	static constexpr std::size_t MaximumFrameCount = 600;
+
+	/**
+	*	@brief Frame times are grouped into buckets of this many milliseconds.
+	*	The last bucket also contains all frames that took longer.
+	*/
+	static constexpr double HistogramBucketSize = 1.0;
+	static constexpr std::size_t HistogramBucketCount = 32;
+
+	using Histogram = std::array<std::size_t, HistogramBucketCount>;
+
+	std::size_t GetFrameCount() const { return _frames.size(); }
+
+	/**
+	*	@brief Gets a frame. Index 0 is the oldest frame.
+	*/
+	const RenderFrameStatistics& GetFrame(std::size_t index) const { return _frames[index]; }
+
+	/**
+	*	@brief Total number of frames added since the last call to Clear, including frames that have been discarded.
+	*/
+	std::uint64_t GetTotalFrameCount() const { return _totalFrameCount; }
+
+	void AddFrame(const RenderFrameStatistics& frame);
+
+	void Clear();
+
+	/**
+	*	@brief Gets a histogram of CPU frame times for the frames in the history.
+	*/
+	Histogram GetHistogram() const;
+
+	/**
+	*	@brief Writes all frames in the history as comma separated values, with a header row.
+	*/
+	void WriteCSV(std::ostream& stream) const;
+
+private:
+	std::deque<RenderFrameStatistics> _frames;
+	std::uint64_t _totalFrameCount{};
+};
+}
@@ -11,6 +11,7 @@
 
 #include "formats/studiomodel/StudioModelRenderer.hpp"
 
+#include "graphics/Frustum.hpp"
 #include "graphics/OpenGL.hpp"
 #include "graphics/Scene.hpp"
 #include "graphics/SceneContext.hpp"
@@ -80,6 +81,10 @@ void Scene::Tick()
 
 void Scene::Draw(SceneContext& sc, std::optional<glm::vec4> backgroundColor)
 {
+	_frameStatistics = {};
+
+	ScopedRenderTimer frameTimer{_frameStatistics.CPUTime};
+
 	if (!backgroundColor)
 	{
 		backgroundColor = _entityContext->AppSettings->GetColorSettings()->GetColor(studiomodel::BackgroundColor);
@@ -102,8 +107,11 @@ void Scene::Draw(SceneContext& sc, std::optional<glm::vec4> backgroundColor)
 	_entityContext->StudioModelRenderer->SetSkyLight(SkyLight);
 
 	const unsigned int uiOldPolys = _entityContext->StudioModelRenderer->GetDrawnPolygonsCount();
+	const RenderCounters oldCounters = _entityContext->StudioModelRenderer->GetStatistics();
+
+	UpdateRenderables();
 
-	DrawRenderables(sc, RenderPass::Background);
+	DrawRenderables(sc, RenderPass::Background, nullptr);
 
 	sc.OpenGLFunctions->glMatrixMode(GL_PROJECTION);
 	sc.OpenGLFunctions->glLoadMatrixf(glm::value_ptr(camera->GetProjectionMatrix()));
@@ -111,9 +119,11 @@ void Scene::Draw(SceneContext& sc, std::optional<glm::vec4> backgroundColor)
 	sc.OpenGLFunctions->glMatrixMode(GL_MODELVIEW);
 	sc.OpenGLFunctions->glLoadMatrixf(glm::value_ptr(camera->GetViewMatrix()));
 
-	DrawRenderables(sc, RenderPass::Standard);
-	DrawRenderables(sc, RenderPass::Ground);
-	DrawRenderables(sc, RenderPass::Overlay3D);
+	const Frustum frustum{camera->GetProjectionMatrix() * camera->GetViewMatrix()};
+
+	DrawRenderables(sc, RenderPass::Standard, &frustum);
+	DrawRenderables(sc, RenderPass::Ground, &frustum);
+	DrawRenderables(sc, RenderPass::Overlay3D, &frustum);
 
 	sc.OpenGLFunctions->glMatrixMode(GL_PROJECTION);
 	sc.OpenGLFunctions->glLoadIdentity();
@@ -123,27 +133,65 @@ void Scene::Draw(SceneContext& sc, std::optional<glm::vec4> backgroundColor)
 	sc.OpenGLFunctions->glMatrixMode(GL_MODELVIEW);
 	sc.OpenGLFunctions->glLoadIdentity();
 
-	DrawRenderables(sc, RenderPass::Overlay2D);
+	DrawRenderables(sc, RenderPass::Overlay2D, nullptr);
 
 	_drawnPolygonsCount = _entityContext->StudioModelRenderer->GetDrawnPolygonsCount() - uiOldPolys;
+
+	_frameStatistics.Counters = _entityContext->StudioModelRenderer->GetStatistics() - oldCounters;
+	_frameStatistics.Polygons = _drawnPolygonsCount;
 }
 
-void Scene::CollectRenderables(RenderPass::RenderPass renderPass, std::vector<BaseEntity*>& renderablesToRender)
+void Scene::UpdateRenderables()
 {
-	renderablesToRender.clear();
+	if (_renderablesVersion == _entityList->GetVersion())
+	{
+		return;
+	}
+
+	_renderablesVersion = _entityList->GetVersion();
+
+	for (auto& renderables : _renderables)
+	{
+		renderables.clear();
+	}
 
 	for (auto& entity : *_entityList)
 	{
-		if (entity->GetRenderPasses() & renderPass)
+		const auto renderPasses = entity->GetRenderPasses();
+
+		for (std::size_t i = 0; i < RenderPassCount; ++i)
 		{
-			renderablesToRender.emplace_back(entity.get());
+			const auto renderPass = static_cast<RenderPass::RenderPass>(1 << i);
+
+			if (renderPasses & renderPass)
+			{
+				_renderables[GetRenderPassIndex(renderPass)].push_back(entity.get());
+			}
 		}
 	}
 }
 
-void Scene::DrawRenderables(SceneContext& sc, RenderPass::RenderPass renderPass)
+void Scene::DrawRenderables(SceneContext& sc, RenderPass::RenderPass renderPass, const Frustum* frustum)
 {
-	CollectRenderables(renderPass, _renderablesToRender);
+	const auto passIndex = GetRenderPassIndex(renderPass);
+
+	ScopedRenderTimer passTimer{_frameStatistics.PassTimes[passIndex]};
+
+	_renderablesToRender.clear();
+
+	for (const auto renderable : _renderables[passIndex])
+	{
+		glm::vec3 center;
+		float radius;
+
+		if (frustum && renderable->GetRenderBounds(center, radius) && !frustum->IntersectsSphere(center, radius))
+		{
+			++_frameStatistics.CulledEntities;
+			continue;
+		}
+
+		_renderablesToRender.push_back(renderable);
+	}
 
 	const glm::vec3& cameraOrigin = _currentCamera->GetCamera()->GetOrigin();
 
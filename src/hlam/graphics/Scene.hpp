@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -10,6 +12,7 @@
 #include "graphics/Camera.hpp"
 #include "graphics/GraphicsConstants.hpp"
 #include "graphics/Light.hpp"
+#include "graphics/RenderStatistics.hpp"
 
 class BaseEntity;
 class EntityList;
@@ -17,6 +20,7 @@ class EntityContext;
 
 namespace graphics
 {
+class Frustum;
 class SceneContext;
 class TextureLoader;
 
@@ -50,6 +54,10 @@ public:
 		_currentCamera->GetCamera()->SetWindowSize(_windowWidth, _windowHeight);
 	}
 
+	unsigned int GetWindowWidth() const { return _windowWidth; }
+
+	unsigned int GetWindowHeight() const { return _windowHeight; }
+
 	void UpdateWindowSize(unsigned int width, unsigned int height)
 	{
 		//Avoid constantly updating cameras
@@ -65,6 +73,11 @@ public:
 
 	unsigned int GetDrawnPolygonsCount() const { return _drawnPolygonsCount; }
 
+	/**
+	*	@brief Gets the statistics for the last call to Draw. The GPU time is not set.
+	*/
+	const RenderFrameStatistics& GetFrameStatistics() const { return _frameStatistics; }
+
 	void CreateDeviceObjects(SceneContext& sc);
 
 	void DestroyDeviceObjects(SceneContext& sc);
@@ -74,9 +87,15 @@ public:
 	void Draw(SceneContext& sc, std::optional<glm::vec4> backgroundColor = std::nullopt);
 
 private:
-	void CollectRenderables(RenderPass::RenderPass renderPass, std::vector<BaseEntity*>& renderablesToRender);
+	/**
+	*	@brief Rebuilds the list of entities drawn in each pass if entities were added or removed.
+	*/
+	void UpdateRenderables();
 
-	void DrawRenderables(SceneContext& sc, RenderPass::RenderPass renderPass);
+	/**
+	*	@param frustum If not null, entities with bounds outside of it are not drawn.
+	*/
+	void DrawRenderables(SceneContext& sc, RenderPass::RenderPass renderPass, const Frustum* frustum);
 
 public:
 	Light SkyLight;
@@ -96,6 +115,14 @@ private:
 
 	unsigned int _drawnPolygonsCount = 0;
 
+	RenderFrameStatistics _frameStatistics;
+
+	/**
+	*	@brief Entities drawn in each pass, in entity list order.
+	*/
+	std::array<std::vector<BaseEntity*>, RenderPassCount> _renderables;
+	std::optional<std::uint64_t> _renderablesVersion;
+
 	std::vector<BaseEntity*> _renderablesToRender;
 };
 }
@@ -5,6 +5,7 @@
 
 #include <QOpenGLFunctions_1_1>
 
+#include "graphics/ImageUtils.hpp"
 #include "graphics/Palette.hpp"
 #include "graphics/TextureLoader.hpp"
 
@@ -177,23 +178,7 @@ void TextureLoader::UploadIndexed8(GLuint texture, int width, int height, const
 
 	rgbaPixels.resize(width * height * 4);
 
-	for (int i = 0; i < (width * height); ++i)
-	{
-		rgbaPixels[(i * 4) + 0] = std::byte{localPalette[std::to_integer<int>(pixels[i])].R};
-		rgbaPixels[(i * 4) + 1] = std::byte{localPalette[std::to_integer<int>(pixels[i])].G};
-		rgbaPixels[(i * 4) + 2] = std::byte{localPalette[std::to_integer<int>(pixels[i])].B};
-
-		//For masked textures the last color in the table is the transparent color
-		//Pixels with that color have their alpha value set to 0 to appear transparent
-		if (masked && pixels[i] == std::byte{RGBPalette::AlphaIndex})
-		{
-			rgbaPixels[(i * 4) + 3] = std::byte{0x00};
-		}
-		else
-		{
-			rgbaPixels[(i * 4) + 3] = std::byte{0xFF};
-		}
-	}
+	ConvertIndexed8ToRGBA8888(width, height, pixels, localPalette, masked, rgbaPixels.data());
 
 	UploadRGBA8888(texture, width, height, rgbaPixels.data(), generateMipmaps, masked);
 }
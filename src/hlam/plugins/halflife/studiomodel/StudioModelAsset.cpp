@@ -1,18 +1,29 @@
 #include <algorithm>
+#include <chrono>
+#include <exception>
+#include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include <QApplication>
 #include <QDir>
 #include <QDockWidget>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFileSystemWatcher>
 #include <QOpenGLFramebufferObject>
 #include <QImage>
 #include <QMenu>
 #include <QMessageBox>
+#include <QMetaObject>
 #include <QSignalBlocker>
+#include <QTimer>
 #include <QWidget>
 
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
 #include "application/AssetIO.hpp"
 
 #include "entity/AxesEntity.hpp"
@@ -30,6 +41,9 @@
 
 #include "filesystem/IFileSystem.hpp"
 
+#include "formats/studiomodel/MeshOptimization.hpp"
+#include "formats/studiomodel/StudioModelBounds.hpp"
+#include "formats/studiomodel/StudioModelDiff.hpp"
 #include "formats/studiomodel/StudioModelIO.hpp"
 #include "formats/studiomodel/StudioModelUtils.hpp"
 
@@ -52,14 +66,27 @@
 #include "soundsystem/SoundSystem.hpp"
 
 #include "application/AssetManager.hpp"
+#include "application/UndoDataStore.hpp"
 #include "ui/MainWindow.hpp"
 #include "ui/SceneWidget.hpp"
 
 #include "ui/camera_operators/CameraOperators.hpp"
 #include "ui/camera_operators/TextureCameraOperator.hpp"
 
+#include "utility/ThreadPool.hpp"
+
 namespace studiomodel
 {
+/**
+*	@brief How long to wait after a model file changes before reloading it.
+*	Compilers write several files in quick succession, so this avoids reloading partially written models.
+*/
+constexpr int FileChangeReloadDelayMilliseconds = 250;
+constexpr qint64 BytesPerMebibyte = 1024 * 1024;
+constexpr std::size_t MaximumBoundsThreads = 16;
+constexpr std::size_t MaximumAnimationCompressionThreads = 16;
+constexpr std::size_t MaximumMeshOptimizationThreads = 16;
+
 static std::tuple<glm::vec3, glm::vec3, float, float> GetCenteredValues(
 	const HLMVStudioModelEntity& entity, Axis axis, bool positive)
 {
@@ -118,12 +145,25 @@ StudioModelAsset::StudioModelAsset(QString&& fileName,
 		_soundSystem.get(),
 		_application->GetApplicationSettings(),
 		_provider->GetStudioModelSettings()))
+	, _undoDataStore(std::make_shared<UndoDataStore>())
+	, _picker(std::make_unique<studiomdl::StudioModelPicker>())
 	, _settingsVersion(settingsVersion)
+	, _fileWatcher(new QFileSystemWatcher(this))
+	, _reloadTimer(new QTimer(this))
 {
 	CreateMainScene();
 	CreateTextureScene();
 
+	_reloadTimer->setSingleShot(true);
+	_reloadTimer->setInterval(FileChangeReloadDelayMilliseconds);
+
+	UpdateFileWatcher();
+
 	connect(this, &StudioModelAsset::FileNameChanged, this, &StudioModelAsset::UpdateFileSystem);
+	connect(this, &StudioModelAsset::FileNameChanged, this, &StudioModelAsset::UpdateFileWatcher);
+	connect(_fileWatcher, &QFileSystemWatcher::fileChanged, this, &StudioModelAsset::OnFileChanged);
+	connect(_reloadTimer, &QTimer::timeout, this, &StudioModelAsset::ReloadChangedFile);
+	connect(_modelData, &StudioModelData::MeshDataChanged, this, &StudioModelAsset::OnMeshDataChanged);
 
 	connect(_application->GetApplicationSettings(), &ApplicationSettings::ResizeTexturesToPowerOf2Changed,
 		this, &StudioModelAsset::OnResizeTexturesToPowerOf2Changed);
@@ -150,6 +190,9 @@ StudioModelAsset::StudioModelAsset(QString&& fileName,
 
 StudioModelAsset::~StudioModelAsset()
 {
+	// Make sure the file is completely written before the asset goes away.
+	WaitForPendingSave();
+
 	{
 		graphics::SceneContext sc{_application->GetOpenGLFunctions(), _application->GetTextureLoader()};
 
@@ -173,6 +216,9 @@ QWidget* StudioModelAsset::GetEditWidget()
 
 void StudioModelAsset::Save()
 {
+	// Saves are written in order so an older save can never overwrite a newer one.
+	WaitForPendingSave();
+
 	if (_editableStudioModel->IsXashModel)
 	{
 		const auto action = QMessageBox::question(_application->GetMainWindow(),
@@ -194,50 +240,142 @@ Continue?)", QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
 	_editableStudioModel->HasExternalTextureFile = false;
 
 	const auto filePath = std::filesystem::u8path(GetFileName().toStdString());
-	auto result = studiomdl::ConvertFromEditable(filePath, *_editableStudioModel);
 
-	studiomdl::SaveStudioModel(filePath, result);
+	studiomdl::ConvertFromEditableOptions options;
 
-	auto undoStack = GetUndoStack();
+	std::optional<ThreadPool> threadPool;
+
+	if (_provider->GetStudioModelSettings()->ShouldCompressAnimationsOnSave())
+	{
+		threadPool.emplace(ThreadPool::GetDefaultThreadCount(1, MaximumAnimationCompressionThreads));
+
+		options.CompressAnimations = true;
+		options.Pool = &*threadPool;
+	}
+
+	// Converting creates a snapshot of the model that the worker thread can write while the model is being edited.
+	std::unique_ptr<const studiomdl::StudioModel> result{
+		new studiomdl::StudioModel(studiomdl::ConvertFromEditable(filePath, *_editableStudioModel, options))};
+
+	threadPool.reset();
 
-	undoStack->setClean();
+	_pendingSaveUndoIndex = GetUndoStack()->index();
+
+	const int saveId = ++_lastSaveId;
+
+	_pendingSave = std::async(std::launch::async, [this, filePath, result = std::move(result), saveId]
+		{
+			// Always notify, even if an exception is thrown, so errors are reported too.
+			const auto notify = [this, saveId]
+			{
+				QMetaObject::invokeMethod(this, [this, saveId] { OnSaveFinished(saveId); }, Qt::QueuedConnection);
+			};
+
+			try
+			{
+				studiomdl::SaveStudioModel(filePath, *result);
+			}
+			catch (...)
+			{
+				notify();
+				throw;
+			}
+
+			notify();
+		});
 }
 
-std::unique_ptr<studiomdl::EditableStudioModel> TryReloadModel(const QString& fileName, IFileSystem& fileSystem)
+void StudioModelAsset::WaitForPendingSave()
 {
+	if (_pendingSave.valid())
+	{
+		OnSaveFinished(_lastSaveId);
+	}
+}
+
+void StudioModelAsset::OnSaveFinished(int saveId)
+{
+	// Already handled by WaitForPendingSave.
+	if (saveId != _lastSaveId || !_pendingSave.valid())
+	{
+		return;
+	}
+
 	try
 	{
-		const std::string filePathString = fileName.toStdString();
-		const auto filePath = std::filesystem::u8path(filePathString);
+		_pendingSave.get();
 
-		auto file = fileSystem.TryOpenAbsolute(filePathString, true, true);
+		auto undoStack = GetUndoStack();
 
-		if (!file)
+		if (undoStack->index() == _pendingSaveUndoIndex)
 		{
-			throw AssetException("Could not open asset: file no longer exists or is currently opened by another program");
+			undoStack->setClean();
 		}
 
-		auto studioModel = studiomdl::LoadStudioModel(filePath, file.get(), fileSystem);
+		// The files were replaced so they have to be watched again.
+		UpdateFileWatcher();
+
+		// The file watcher will see this change, but there's no need to reload what was just saved.
+		_savedFileStates.clear();
+
+		for (const auto& fileName : _fileWatcher->files())
+		{
+			const QFileInfo fileInfo{fileName};
+			_savedFileStates.insert(fileName, SavedFileState{fileInfo.size(), fileInfo.lastModified()});
+		}
 
-		return std::make_unique<studiomdl::EditableStudioModel>(studiomdl::ConvertToEditable(*studioModel));
+		_application->GetLogger()->trace("Saved asset \"{}\"", GetFileName());
 	}
 	catch (const AssetException& e)
 	{
-		QMessageBox::critical(nullptr, "Error",
-			QString{ "An error occurred while reloading the model \"%1\":\n%2" }.arg(fileName).arg(e.what()));
-		return {};
+		_application->GetLogger()->error("Error saving asset:\n{}", e.what());
+	}
+	catch (const std::exception& e)
+	{
+		_application->GetLogger()->error("Unexpected error saving asset:\n{}", e.what());
 	}
 }
 
+std::unique_ptr<studiomdl::EditableStudioModel> ReloadModel(const QString& fileName, IFileSystem& fileSystem)
+{
+	const std::string filePathString = fileName.toStdString();
+	const auto filePath = std::filesystem::u8path(filePathString);
+
+	auto file = fileSystem.TryOpenAbsolute(filePathString, true, true);
+
+	if (!file)
+	{
+		throw AssetException("Could not open asset: file no longer exists or is currently opened by another program");
+	}
+
+	auto studioModel = studiomdl::LoadStudioModel(filePath, file.get(), fileSystem);
+
+	return std::make_unique<studiomdl::EditableStudioModel>(studiomdl::ConvertToEditable(*studioModel));
+}
+
 bool StudioModelAsset::TryRefresh()
 {
-	auto newModel = TryReloadModel(GetFileName(), *_fileSystem);
+	// Reload the file as it will be once the save in progress is done.
+	WaitForPendingSave();
 
-	if (!newModel)
+	try
+	{
+		ReplaceModel(ReloadModel(GetFileName(), *_fileSystem));
+	}
+	catch (const AssetException& e)
 	{
+		QMessageBox::critical(nullptr, "Error",
+			QString{ "An error occurred while reloading the model \"%1\":\n%2" }.arg(GetFileName()).arg(e.what()));
 		return false;
 	}
 
+	return true;
+}
+
+void StudioModelAsset::ReplaceModel(std::unique_ptr<studiomdl::EditableStudioModel>&& newModel)
+{
+	const auto changes = studiomdl::CompareStudioModels(*_editableStudioModel, *newModel);
+
 	auto snapshot = std::make_unique<StateSnapshot>();
 
 	SaveEntityToSnapshot(snapshot.get());
@@ -252,24 +390,27 @@ bool StudioModelAsset::TryRefresh()
 	auto context = _application->GetGraphicsContext();
 	context->Begin();
 
-	//Clean up old model resources
-	//TODO: needs to be handled better
-	_modelEntity->DestroyDeviceObjects(sc);
-
-	_editableStudioModel = std::move(newModel);
+	// Keep the old model alive until its textures have been taken over by the new model.
+	auto oldModel = std::exchange(_editableStudioModel, std::move(newModel));
 
 	auto oldModelData = _modelData;
 
 	_modelData = new StudioModelData(_editableStudioModel.get(), this);
 
+	connect(_modelData, &StudioModelData::MeshDataChanged, this, &StudioModelAsset::OnMeshDataChanged);
+
 	GetUndoStack()->clear();
 
+	// The picker caches data that refers to the old model.
+	_picker = std::make_unique<studiomdl::StudioModelPicker>();
+
 	_modelEntity->SetEditableModel(GetEditableStudioModel());
 	_modelEntity->Spawn();
 
 	LoadEntityFromSnapshot(snapshot.get());
 
-	_modelEntity->CreateDeviceObjects(sc);
+	// Only upload textures that have changed.
+	_editableStudioModel->CreateTexturesFrom(*sc.TexLoader, *oldModel, changes.TextureSources);
 
 	context->End();
 
@@ -277,10 +418,112 @@ bool StudioModelAsset::TryRefresh()
 
 	// Delete the old data now that any remaining references have been cleared.
 	delete oldModelData;
+	oldModel.reset();
 
 	emit LoadSnapshot(snapshot.get());
 
-	return true;
+	_application->GetLogger()->info("Reloaded \"{}\": {} of {} textures and {} of {} sequences changed",
+		GetFileName(),
+		changes.GetChangedTextureCount(), _editableStudioModel->Textures.size(),
+		changes.ChangedSequences.size(), _editableStudioModel->Sequences.size());
+}
+
+void StudioModelAsset::UpdateFileWatcher()
+{
+	if (const auto files = _fileWatcher->files(); !files.isEmpty())
+	{
+		_fileWatcher->removePaths(files);
+	}
+
+	const QFileInfo fileInfo{GetFileName()};
+
+	QStringList fileNames{fileInfo.absoluteFilePath()};
+
+	// Textures may be stored in a separate file.
+	if (const QFileInfo textureFileInfo{fileInfo.absolutePath() + '/' + fileInfo.completeBaseName() + "T." + fileInfo.suffix()};
+		textureFileInfo.exists())
+	{
+		fileNames.append(textureFileInfo.absoluteFilePath());
+	}
+
+	_fileWatcher->addPaths(fileNames);
+}
+
+void StudioModelAsset::OnFileChanged(const QString& fileName)
+{
+	// Compilers replace files by deleting and recreating them, which removes them from the watcher.
+	if (QFileInfo::exists(fileName) && !_fileWatcher->files().contains(fileName))
+	{
+		_fileWatcher->addPath(fileName);
+	}
+
+	_changedFileNames.insert(fileName);
+
+	// Wait until the compiler has finished writing all files.
+	_reloadTimer->start();
+}
+
+void StudioModelAsset::ReloadChangedFile()
+{
+	// Ignore changes made by our own saves.
+	if (_pendingSave.valid())
+	{
+		return;
+	}
+
+	if (!QFileInfo::exists(GetFileName()))
+	{
+		return;
+	}
+
+	// Only files that no longer match what we saved were changed by someone else.
+	const bool changedExternally = std::any_of(_changedFileNames.begin(), _changedFileNames.end(),
+		[this](const QString& fileName)
+		{
+			const auto it = _savedFileStates.find(fileName);
+
+			if (it == _savedFileStates.end())
+			{
+				return true;
+			}
+
+			const QFileInfo fileInfo{fileName};
+
+			return !fileInfo.exists() || fileInfo.size() != it->Size || fileInfo.lastModified() != it->LastModified;
+		});
+
+	if (!changedExternally)
+	{
+		_changedFileNames.clear();
+		return;
+	}
+
+	if (_application->GetAssets()->GetCurrent() != this)
+	{
+		// Only the active asset can update the UI, so wait until this asset is activated again.
+		_reloadWhenActivated = true;
+		return;
+	}
+
+	_reloadWhenActivated = false;
+	_changedFileNames.clear();
+
+	if (!GetUndoStack()->isClean())
+	{
+		_application->GetLogger()->warn(
+			"\"{}\" was changed on disk but has unsaved changes; use Refresh to reload it", GetFileName());
+		return;
+	}
+
+	try
+	{
+		ReplaceModel(ReloadModel(GetFileName(), *_fileSystem));
+	}
+	catch (const AssetException& e)
+	{
+		// The file may still be incomplete; it will be reloaded again when the next change comes in.
+		_application->GetLogger()->warn("Could not reload changed model \"{}\":\n{}", GetFileName(), e.what());
+	}
 }
 
 bool StudioModelAsset::CanTakeScreenshot() const
@@ -417,6 +660,7 @@ void StudioModelAsset::OnActivated()
 	connect(_application, &AssetManager::FullscreenModeChanged, this, &StudioModelAsset::OnSceneWidgetRecreated);
 	connect(editWidget, &StudioModelEditWidget::SceneIndexChanged, this, &StudioModelAsset::OnSceneIndexChanged);
 	connect(editWidget, &StudioModelEditWidget::PoseChanged, this, &StudioModelAsset::SetPose);
+	connect(this, &StudioModelAsset::ObjectPicked, editWidget, &StudioModelEditWidget::ShowPickedObject);
 
 	OnSceneWidgetRecreated();
 
@@ -460,6 +704,11 @@ void StudioModelAsset::OnActivated()
 	}
 
 	OnCameraChanged(nullptr, _provider->GetCameraOperators()->GetCurrent());
+
+	if (_reloadWhenActivated)
+	{
+		_reloadTimer->start();
+	}
 }
 
 void StudioModelAsset::OnDeactivated()
@@ -477,6 +726,7 @@ void StudioModelAsset::OnDeactivated()
 
 	editWidget->disconnect(this);
 	sceneWidget->disconnect(this);
+	disconnect(this, &StudioModelAsset::ObjectPicked, editWidget, &StudioModelEditWidget::ShowPickedObject);
 
 	disconnect(_application, &AssetManager::SceneWidgetRecreated,
 		this, &StudioModelAsset::OnSceneWidgetRecreated);
@@ -510,6 +760,9 @@ void StudioModelAsset::CreateTextureScene()
 	// The order that entities are added matters for now since there's no sorting done.
 	_textureEntity = _textureScene->GetEntityList()->Create<TextureEntity>();
 
+	// Show the first texture until the Textures panel selects one. The panel is only created once it is shown.
+	_textureEntity->SetTextureIndex(0, -1);
+
 	_textureCameraOperator = std::make_unique<TextureCameraOperator>(_textureEntity);
 
 	_textureScene->SetCurrentCamera(_textureCameraOperator.get());
@@ -668,9 +921,102 @@ bool StudioModelAsset::HandleMouseInput(QMouseEvent* event)
 		return true;
 	}
 
+	// Left clicks pick objects, but only if the mouse wasn't dragged to move the camera.
+	// The event is not consumed so the camera still receives it.
+	if (event->button() == Qt::MouseButton::LeftButton)
+	{
+		if (event->type() == QEvent::Type::MouseButtonPress)
+		{
+			if (event->modifiers() == Qt::KeyboardModifier::NoModifier)
+			{
+				_pickPressPosition = event->pos();
+			}
+			else
+			{
+				_pickPressPosition.reset();
+			}
+		}
+		else if (event->type() == QEvent::Type::MouseButtonRelease && _pickPressPosition)
+		{
+			if ((event->pos() - *_pickPressPosition).manhattanLength() < QApplication::startDragDistance())
+			{
+				PickObject(event->pos());
+			}
+
+			_pickPressPosition.reset();
+		}
+	}
+
 	return false;
 }
 
+void StudioModelAsset::PickObject(const QPoint& position)
+{
+	// Bones and attachments are drawn as small points, so clicks within this many pixels of them hit.
+	constexpr float PointPickRadius = 6;
+
+	auto camera = _scene->GetCurrentCamera()->GetCamera();
+
+	const float width = static_cast<float>(_scene->GetWindowWidth());
+	const float height = static_cast<float>(_scene->GetWindowHeight());
+
+	if (width <= 0 || height <= 0)
+	{
+		return;
+	}
+
+	const glm::vec4 viewport{0, 0, width, height};
+
+	// Widget coordinates start at the top, window coordinates at the bottom.
+	const float x = position.x() + 0.5f;
+	const float y = height - (position.y() + 0.5f);
+
+	const auto unproject = [&](float windowX, float depth)
+	{
+		return glm::unProject(glm::vec3{windowX, y, depth}, camera->GetViewMatrix(), camera->GetProjectionMatrix(), viewport);
+	};
+
+	const glm::vec3 nearPoint = unproject(x, 0);
+	const glm::vec3 farPoint = unproject(x, 1);
+
+	const float length = glm::length(farPoint - nearPoint);
+
+	if (length <= 0)
+	{
+		return;
+	}
+
+	studiomdl::PickRay ray;
+	ray.Origin = nearPoint;
+	ray.Direction = (farPoint - nearPoint) / length;
+
+	// Works for both perspective and orthographic projections.
+	ray.PointRadius = glm::length(unproject(x + PointPickRadius, 0) - nearPoint);
+	ray.PointRadiusPerUnit = (glm::length(unproject(x + PointPickRadius, 1) - farPoint) - ray.PointRadius) / length;
+
+	studiomdl::PickFlags flags = studiomdl::PickFlag::Meshes;
+
+	if (ShowHitboxes || DrawSingleHitboxIndex != -1)
+	{
+		flags |= studiomdl::PickFlag::Hitboxes;
+	}
+
+	if (ShowBones || DrawSingleBoneIndex != -1)
+	{
+		flags |= studiomdl::PickFlag::Bones;
+	}
+
+	if (ShowAttachments || DrawSingleAttachmentIndex != -1)
+	{
+		flags |= studiomdl::PickFlag::Attachments;
+	}
+
+	if (const auto result = _picker->Pick(_modelEntity->GetRenderInfo(), ray, flags); result.Type != studiomdl::PickType::None)
+	{
+		emit ObjectPicked(result);
+	}
+}
+
 void StudioModelAsset::Tick()
 {
 	//TODO: update asset-local world time
@@ -678,6 +1024,12 @@ void StudioModelAsset::Tick()
 	{
 		scene->Tick();
 	}
+
+	// Entities only animate while the sequence is playing; otherwise the scene only changes in response to input.
+	if (PlaySequence)
+	{
+		_application->RequestRedraw();
+	}
 }
 
 void StudioModelAsset::OnSceneWidgetRecreated()
@@ -722,6 +1074,12 @@ void StudioModelAsset::OnTextureFiltersChanged()
 	context->End();
 }
 
+void StudioModelAsset::OnMeshDataChanged()
+{
+	// The picker caches the triangles of the old commands.
+	_picker = std::make_unique<studiomdl::StudioModelPicker>();
+}
+
 void StudioModelAsset::OnSceneIndexChanged(int index)
 {
 	SetCurrentScene(index != -1 ? GetScenes()[index] : nullptr);
@@ -770,8 +1128,89 @@ void StudioModelAsset::OnCenterView(Axis axis, bool positive)
 	}
 }
 
+void StudioModelAsset::AddUndoCommand(QUndoCommand* command)
+{
+	const auto settings = _provider->GetStudioModelSettings();
+
+	_undoDataStore->SetMemoryBudget(settings->GetUndoMemoryBudget() * BytesPerMebibyte);
+	_undoDataStore->SetHistoryLimit(settings->GetUndoHistoryLimit() * BytesPerMebibyte);
+
+	auto undoStack = GetUndoStack();
+
+	undoStack->push(command);
+
+	// Discard the oldest changes first. The most recent change can always be undone.
+	// Commands that were discarded before are discarded again, which does nothing, so this counts all of them.
+	int discarded = 0;
+
+	while (discarded < (undoStack->index() - 1) && _undoDataStore->IsOverHistoryLimit())
+	{
+		DiscardUndoCommand(const_cast<QUndoCommand*>(undoStack->command(discarded)));
+		++discarded;
+	}
+
+	// Discarded commands no longer change the model, so the state saved before them can't be reached again.
+	if (discarded > 0 && undoStack->cleanIndex() != -1 && undoStack->cleanIndex() < discarded)
+	{
+		undoStack->resetClean();
+	}
+}
+
 void StudioModelAsset::OnFlipNormals()
 {
 	AddUndoCommand(new FlipNormalsCommand(this));
 }
+
+void StudioModelAsset::OnRecalculateBounds()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	std::optional<studiomdl::StudioModelBounds> bounds;
+
+	{
+		ThreadPool threadPool{ThreadPool::GetDefaultThreadCount(1, MaximumBoundsThreads)};
+		bounds = studiomdl::CalculateBounds(*_editableStudioModel, &threadPool);
+	}
+
+	if (!bounds)
+	{
+		_application->GetLogger()->warn("Cannot recalculate bounding boxes of \"{}\": the model has no vertices or sequences",
+			GetFileName());
+		return;
+	}
+
+	_application->GetLogger()->info("Recalculated bounding boxes of \"{}\" for {} sequences in {:.0f} ms",
+		GetFileName(), bounds->Sequences.size(),
+		std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count());
+
+	AddUndoCommand(new RecalculateBoundsCommand(this, studiomdl::GetBounds(*_editableStudioModel), std::move(*bounds)));
+}
+
+void StudioModelAsset::OnOptimizeMeshes()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	studiomdl::MeshOptimizationResult result;
+
+	{
+		ThreadPool threadPool{ThreadPool::GetDefaultThreadCount(1, MaximumMeshOptimizationThreads)};
+		result = studiomdl::OptimizeMeshes(*_editableStudioModel, &threadPool);
+	}
+
+	const auto logger = _application->GetLogger();
+
+	logger->info("Optimized {} meshes of \"{}\" in {:.0f} ms: {} strips and {} fans ({:.2f} triangles each) "
+		"became {} strips and {} fans ({:.2f} triangles each)",
+		result.OptimizedMeshCount, GetFileName(),
+		std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count(),
+		result.Before.Strips, result.Before.Fans, result.Before.GetAverageLength(),
+		result.After.Strips, result.After.Fans, result.After.GetAverageLength());
+
+	if (result.OptimizedMeshCount == 0)
+	{
+		return;
+	}
+
+	AddUndoCommand(new OptimizeMeshesCommand(this, studiomdl::GetTriangleCommands(*_editableStudioModel), result.Commands));
+}
 }
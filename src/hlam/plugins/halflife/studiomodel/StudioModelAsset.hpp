@@ -1,8 +1,14 @@
 #pragma once
 
+#include <future>
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include <QDateTime>
+#include <QMap>
+#include <QPoint>
+#include <QSet>
 #include <QVector>
 
 #include <glm/vec2.hpp>
@@ -10,6 +16,7 @@
 #include "application/Assets.hpp"
 
 #include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelPicker.hpp"
 
 #include "graphics/GraphicsConstants.hpp"
 
@@ -30,9 +37,12 @@ class HLMVStudioModelEntity;
 class IFileSystem;
 class ISoundSystem;
 class PlayerHitboxEntity;
+class QFileSystemWatcher;
+class QTimer;
 class SceneCameraOperator;
 class TextureCameraOperator;
 class TextureEntity;
+class UndoDataStore;
 
 namespace graphics
 {
@@ -78,6 +88,8 @@ public:
 
 	void Save() override;
 
+	void WaitForPendingSave() override;
+
 	bool TryRefresh() override;
 
 	bool CanTakeScreenshot() const override;
@@ -106,10 +118,13 @@ public:
 
 	graphics::Scene* GetScene() { return _scene.get(); }
 
-	void AddUndoCommand(QUndoCommand* command)
-	{
-		GetUndoStack()->push(command);
-	}
+	UndoDataStore* GetUndoDataStore() const { return _undoDataStore.get(); }
+
+	/**
+	*	@brief Pushes a command onto the undo stack.
+	*	If the stored undo data exceeds the history limit the oldest changes are discarded.
+	*/
+	void AddUndoCommand(QUndoCommand* command);
 
 	HLMVStudioModelEntity* GetEntity() { return _modelEntity.get(); }
 
@@ -141,6 +156,11 @@ public:
 
 	void UpdateFileSystem();
 
+	/**
+	*	@brief Watches the model's files so the model is reloaded automatically when it is recompiled.
+	*/
+	void UpdateFileWatcher();
+
 	bool CameraIsFirstPerson() const;
 
 	void OnActivated();
@@ -150,6 +170,16 @@ public:
 
 	void OnFlipNormals();
 
+	/**
+	*	@brief Replaces the model and sequence bounding boxes with bounds computed from the animated vertices.
+	*/
+	void OnRecalculateBounds();
+
+	/**
+	*	@brief Rebuilds the triangle commands of all meshes into fewer, longer strips and fans.
+	*/
+	void OnOptimizeMeshes();
+
 private:
 	void CreateMainScene();
 	void CreateTextureScene();
@@ -157,8 +187,32 @@ private:
 	void SaveEntityToSnapshot(StateSnapshot* snapshot);
 	void LoadEntityFromSnapshot(StateSnapshot* snapshot);
 
+	/**
+	*	@brief Reports the result of a save and marks the asset as clean if it succeeded.
+	*	Waits for the save to finish if it's still in progress.
+	*/
+	void OnSaveFinished(int saveId);
+
 	bool HandleMouseInput(QMouseEvent* event);
 
+	/**
+	*	@brief Finds the object under the given position in the scene widget and emits ObjectPicked if there is one.
+	*/
+	void PickObject(const QPoint& position);
+
+	/**
+	*	@brief Replaces the model with a newly loaded version of it.
+	*	Textures that have not changed are taken over from the current model instead of being uploaded again.
+	*/
+	void ReplaceModel(std::unique_ptr<studiomdl::EditableStudioModel>&& newModel);
+
+	void OnFileChanged(const QString& fileName);
+
+	/**
+	*	@brief Reloads the model after it has changed on disk, unless it has unsaved changes.
+	*/
+	void ReloadChangedFile();
+
 signals:
 	void SaveSnapshot(StateSnapshot* snapshot);
 
@@ -166,6 +220,11 @@ signals:
 
 	void PoseChanged(Pose pose);
 
+	/**
+	*	@brief Emitted when the user clicks on a mesh, hitbox, bone or attachment in the viewport.
+	*/
+	void ObjectPicked(const studiomdl::PickResult& result);
+
 public slots:
 	void SetPose(Pose pose)
 	{
@@ -180,6 +239,8 @@ private slots:
 
 	void OnTextureFiltersChanged();
 
+	void OnMeshDataChanged();
+
 	void OnSceneIndexChanged(int index);
 
 	void OnSceneWidgetMouseEvent(QMouseEvent* event);
@@ -219,6 +280,11 @@ private:
 	const std::unique_ptr<ISoundSystem> _soundSystem;
 	const std::unique_ptr<EntityContext> _entityContext;
 
+	/**
+	*	@brief Shared with the undo commands' data handles, which may outlive the asset.
+	*/
+	const std::shared_ptr<UndoDataStore> _undoDataStore;
+
 	unsigned int _settingsVersion{0};
 
 	std::vector<graphics::Scene*> _scenes;
@@ -251,9 +317,50 @@ private:
 
 	StateSnapshot _snapshot;
 
+	/**
+	*	@brief Save running on a worker thread. The model data is converted before the save starts,
+	*	so the asset can be edited and animated while the file is being written.
+	*/
+	std::future<void> _pendingSave;
+
+	/**
+	*	@brief Undo stack index at the time the pending save was started.
+	*	The asset is only marked as clean if no changes were made while saving.
+	*/
+	int _pendingSaveUndoIndex{-1};
+	int _lastSaveId{0};
+
+	QFileSystemWatcher* const _fileWatcher;
+	QTimer* const _reloadTimer;
+
+	/**
+	*	@brief Size and modification time of a watched file right after it was last saved.
+	*/
+	struct SavedFileState
+	{
+		qint64 Size{};
+		QDateTime LastModified;
+	};
+
+	QMap<QString, SavedFileState> _savedFileStates;
+
+	/**
+	*	@brief Watched files that changed since the last time changes were handled.
+	*/
+	QSet<QString> _changedFileNames;
+
+	bool _reloadWhenActivated{false};
+
 	//TODO: this is temporarily put here, but needs to be put somewhere else eventually
 	Pose _pose = Pose::Sequences;
 
 	glm::vec2 _lightVectorCoordinates{0};
+
+	std::unique_ptr<studiomdl::StudioModelPicker> _picker;
+
+	/**
+	*	@brief Where the left mouse button was pressed. A click only picks if the mouse was not dragged to move the camera.
+	*/
+	std::optional<QPoint> _pickPressPosition;
 };
 }
@@ -324,6 +324,8 @@ void StudioModelAssetProvider::PopulateAssetMenu(QMenu* menu)
 	menu->addSeparator();
 
 	menu->addAction("Flip Normals", this, [this]() { GetCurrentAsset()->OnFlipNormals(); });
+	menu->addAction("Recalculate Bounding Boxes", this, [this]() { GetCurrentAsset()->OnRecalculateBounds(); });
+	menu->addAction("Optimize Mesh Strips", this, [this]() { GetCurrentAsset()->OnOptimizeMeshes(); });
 
 	menu->addSeparator();
 
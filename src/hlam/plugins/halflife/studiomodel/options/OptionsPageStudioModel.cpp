@@ -98,6 +98,14 @@ OptionsPageStudioModelWidget::OptionsPageStudioModelWidget(
 	_ui.GroundLengthSpinner->setValue(_studioModelSettings->GetGroundLength());
 
 	_ui.XashOpenMode->setCurrentIndex(static_cast<int>(_studioModelSettings->GetXashOpenMode()));
+	_ui.DitherImportedTextures->setChecked(_studioModelSettings->ShouldDitherImportedTextures());
+	_ui.CompressAnimationsOnSave->setChecked(_studioModelSettings->ShouldCompressAnimationsOnSave());
+
+	_ui.UndoMemoryBudget->setRange(_studioModelSettings->MinimumUndoMemoryBudget, _studioModelSettings->MaximumUndoMemoryBudget);
+	_ui.UndoHistoryLimit->setRange(_studioModelSettings->MinimumUndoHistoryLimit, _studioModelSettings->MaximumUndoHistoryLimit);
+
+	_ui.UndoMemoryBudget->setValue(_studioModelSettings->GetUndoMemoryBudget());
+	_ui.UndoHistoryLimit->setValue(_studioModelSettings->GetUndoHistoryLimit());
 
 	connect(_ui.GroundLengthSlider, &QSlider::valueChanged, _ui.GroundLengthSpinner, &QSpinBox::setValue);
 	connect(_ui.GroundLengthSpinner, qOverload<int>(&QSpinBox::valueChanged), _ui.GroundLengthSlider, &QSlider::setValue);
@@ -189,6 +197,10 @@ void OptionsPageStudioModelWidget::ApplyChanges()
 		_ui.ActivateTextureViewWhenTexturesPanelOpened->isChecked());
 	_studioModelSettings->SetGroundLength(_ui.GroundLengthSlider->value());
 	_studioModelSettings->SetXashOpenMode(static_cast<XashOpenMode>(_ui.XashOpenMode->currentIndex()));
+	_studioModelSettings->SetDitherImportedTextures(_ui.DitherImportedTextures->isChecked());
+	_studioModelSettings->SetCompressAnimationsOnSave(_ui.CompressAnimationsOnSave->isChecked());
+	_studioModelSettings->SetUndoMemoryBudget(_ui.UndoMemoryBudget->value());
+	_studioModelSettings->SetUndoHistoryLimit(_ui.UndoHistoryLimit->value());
 
 	QSet<int> soundEventIds;
 
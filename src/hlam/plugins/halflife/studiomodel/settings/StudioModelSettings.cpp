@@ -20,6 +20,13 @@ void StudioModelSettings::LoadSettings()
 		_xashOpenMode = XashOpenMode::Ask;
 	}
 
+	_ditherImportedTextures = _settings->value("DitherImportedTextures", DefaultDitherImportedTextures).toBool();
+	_compressAnimationsOnSave = _settings->value("CompressAnimationsOnSave", DefaultCompressAnimationsOnSave).toBool();
+	_undoMemoryBudget = std::clamp(_settings->value(
+		"UndoMemoryBudget", DefaultUndoMemoryBudget).toInt(), MinimumUndoMemoryBudget, MaximumUndoMemoryBudget);
+	_undoHistoryLimit = std::clamp(_settings->value(
+		"UndoHistoryLimit", DefaultUndoHistoryLimit).toInt(), MinimumUndoHistoryLimit, MaximumUndoHistoryLimit);
+
 	_soundEventIds.clear();
 	const int soundEventIdsCount = _settings->beginReadArray("SoundEventIds");
 	for (int i = 0; i < soundEventIdsCount; ++i)
@@ -44,6 +51,10 @@ void StudioModelSettings::SaveSettings()
 	_settings->setValue("ActivateTextureViewWhenTexturesPanelOpened", _activateTextureViewWhenTexturesPanelOpened);
 	_settings->setValue("GroundLength", _groundLength);
 	_settings->setValue("XashOpenMode", static_cast<int>(_xashOpenMode));
+	_settings->setValue("DitherImportedTextures", _ditherImportedTextures);
+	_settings->setValue("CompressAnimationsOnSave", _compressAnimationsOnSave);
+	_settings->setValue("UndoMemoryBudget", _undoMemoryBudget);
+	_settings->setValue("UndoHistoryLimit", _undoHistoryLimit);
 
 	_settings->beginWriteArray("SoundEventIds", _soundEventIds.size());
 	for (int i = 0; auto id : _soundEventIds)
@@ -17,11 +17,21 @@ class StudioModelSettings final : public BaseSettings
 public:
 	static constexpr bool DefaultAutodetectViewmodels{true};
 	static constexpr bool DefaultActivateTextureViewWhenTexturesPanelOpened{true};
+	static constexpr bool DefaultDitherImportedTextures{false};
+	static constexpr bool DefaultCompressAnimationsOnSave{false};
 
 	static constexpr int MinimumGroundLength = 0;
 	static constexpr int MaximumGroundLength = 2048;
 	static constexpr int DefaultGroundLength = 100;
 
+	static constexpr int MinimumUndoMemoryBudget = 0;
+	static constexpr int MaximumUndoMemoryBudget = 4096;
+	static constexpr int DefaultUndoMemoryBudget = 64;
+
+	static constexpr int MinimumUndoHistoryLimit = 0;
+	static constexpr int MaximumUndoHistoryLimit = 65536;
+	static constexpr int DefaultUndoHistoryLimit = 512;
+
 	using BaseSettings::BaseSettings;
 
 	void LoadSettings() override;
@@ -70,6 +80,47 @@ public:
 		_xashOpenMode = mode;
 	}
 
+	/**
+	*	@brief Whether to use dithering when images with more than 256 colors are imported as textures.
+	*/
+	bool ShouldDitherImportedTextures() const { return _ditherImportedTextures; }
+
+	void SetDitherImportedTextures(bool value)
+	{
+		_ditherImportedTextures = value;
+	}
+
+	/**
+	*	@brief Whether to re-encode animation data as compactly as possible when saving models.
+	*/
+	bool ShouldCompressAnimationsOnSave() const { return _compressAnimationsOnSave; }
+
+	void SetCompressAnimationsOnSave(bool value)
+	{
+		_compressAnimationsOnSave = value;
+	}
+
+	/**
+	*	@brief Amount of compressed undo data per model to keep in memory before it is moved to a temporary file, in MiB.
+	*/
+	int GetUndoMemoryBudget() const { return _undoMemoryBudget; }
+
+	void SetUndoMemoryBudget(int value)
+	{
+		_undoMemoryBudget = value;
+	}
+
+	/**
+	*	@brief Amount of compressed undo data per model to keep before the oldest changes are discarded, in MiB.
+	*	0 means there is no limit.
+	*/
+	int GetUndoHistoryLimit() const { return _undoHistoryLimit; }
+
+	void SetUndoHistoryLimit(int value)
+	{
+		_undoHistoryLimit = value;
+	}
+
 	float GetCameraFOV(const QString& name, float defaultValue) const;
 	void SetCameraFOV(const QString& name, float value);
 
@@ -88,5 +139,11 @@ private:
 
 	XashOpenMode _xashOpenMode = XashOpenMode::Ask;
 
+	bool _ditherImportedTextures{DefaultDitherImportedTextures};
+	bool _compressAnimationsOnSave{DefaultCompressAnimationsOnSave};
+
+	int _undoMemoryBudget{DefaultUndoMemoryBudget};
+	int _undoHistoryLimit{DefaultUndoHistoryLimit};
+
 	QSet<int> _soundEventIds;
 };
@@ -48,6 +48,11 @@ signals:
 
 	void SubModelNameChanged(int bodyPartIndex, int modelIndex);
 
+	/**
+	*	@brief The triangle commands of one or more meshes changed.
+	*/
+	void MeshDataChanged();
+
 	void HitboxDataChanged(int index);
 
 	void EventChanged(int sequenceIndex, int eventIndex);
@@ -57,6 +62,11 @@ signals:
 	void TextureNameChanged(int index);
 	void TextureFlagsChanged(int index);
 
+	/**
+	*	@brief The pixels, palette or dimensions of a texture changed, along with the texture coordinates of meshes that use it.
+	*/
+	void TextureDataChanged(int index);
+
 	void SkyLightChanged();
 };
 }
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <utility>
 
 #include <QAction>
 #include <QDockWidget>
@@ -11,6 +12,7 @@
 
 #include "ui/DockableWidget.hpp"
 #include "ui/DragNDropEventFilter.hpp"
+#include "ui/LazyDockableWidget.hpp"
 #include "application/AssetManager.hpp"
 #include "ui/SceneWidget.hpp"
 
@@ -28,8 +30,10 @@
 #include "plugins/halflife/studiomodel/ui/dockpanels/LightingPanel.hpp"
 #include "plugins/halflife/studiomodel/ui/dockpanels/ModelDataPanel.hpp"
 #include "plugins/halflife/studiomodel/ui/dockpanels/ModelDisplayPanel.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/RenderStatisticsPanel.hpp"
 #include "plugins/halflife/studiomodel/ui/dockpanels/ScenePanel.hpp"
 #include "plugins/halflife/studiomodel/ui/dockpanels/SequencesPanel.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 #include "plugins/halflife/studiomodel/ui/dockpanels/TexturesPanel.hpp"
 
 #include "plugins/halflife/studiomodel/ui/dockpanels/TransformPanel.hpp"
@@ -66,11 +70,12 @@ StudioModelEditWidget::StudioModelEditWidget(AssetManager* application, StudioMo
 
 	_ui.Window->setDocumentMode(true);
 
-	auto addDockPanel = [&](DockableWidget* widget, const QString& label, Qt::DockWidgetArea area = Qt::DockWidgetArea::BottomDockWidgetArea)
+	// Panels are created the first time they are shown so hidden panels don't slow down startup.
+	auto addDockPanel = [&](LazyDockableWidget::Factory factory, const QString& label, Qt::DockWidgetArea area = Qt::DockWidgetArea::BottomDockWidgetArea)
 	{
 		auto dock = new QDockWidget(label, _ui.Window);
 
-		dock->setWidget(widget);
+		dock->setWidget(new LazyDockableWidget(std::move(factory)));
 		dock->setObjectName(label);
 
 		connect(dock, &QDockWidget::dockLocationChanged, this, &StudioModelEditWidget::OnDockLocationChanged);
@@ -83,21 +88,20 @@ StudioModelEditWidget::StudioModelEditWidget(AssetManager* application, StudioMo
 		return dock;
 	};
 
-	_camerasPanel = new CamerasPanel(_provider->GetCameraOperators());
-
-	addDockPanel(_camerasPanel, "Cameras");
-	addDockPanel(new ScenePanel(_provider), "Scene");
-	auto modelDisplayDock = addDockPanel(new ModelDisplayPanel(_provider), "Model Display");
-	addDockPanel(new LightingPanel(_provider), "Lighting");
-	addDockPanel(new SequencesPanel(_provider), "Sequences");
-	addDockPanel(new BodyPartsPanel(_provider), "Body Parts");
-	addDockPanel(new TexturesPanel(_provider), "Textures");
-	addDockPanel(new ModelDataPanel(_provider), "Model Data");
-	addDockPanel(new BonesPanel(_provider), "Bones");
-	addDockPanel(new BoneControllersPanel(_provider), "Bone Controllers");
-	addDockPanel(new AttachmentsPanel(_provider), "Attachments");
-	addDockPanel(new HitboxesPanel(_provider), "Hitboxes");
-	auto transformDock = addDockPanel(new TransformPanel(_provider), "Transformation");
+	addDockPanel([this] { return new CamerasPanel(_provider->GetCameraOperators()); }, "Cameras");
+	addDockPanel([this] { return new ScenePanel(_provider); }, "Scene");
+	auto modelDisplayDock = addDockPanel([this] { return new ModelDisplayPanel(_provider); }, "Model Display");
+	addDockPanel([this] { return new LightingPanel(_provider); }, "Lighting");
+	addDockPanel([this] { return new SequencesPanel(_provider); }, "Sequences");
+	addDockPanel([this] { return new BodyPartsPanel(_provider); }, "Body Parts");
+	_pickDockWidgets.insert(studiomdl::PickType::Mesh, addDockPanel([this] { return new TexturesPanel(_provider); }, "Textures"));
+	addDockPanel([this] { return new ModelDataPanel(_provider); }, "Model Data");
+	_pickDockWidgets.insert(studiomdl::PickType::Bone, addDockPanel([this] { return new BonesPanel(_provider); }, "Bones"));
+	addDockPanel([this] { return new BoneControllersPanel(_provider); }, "Bone Controllers");
+	_pickDockWidgets.insert(studiomdl::PickType::Attachment, addDockPanel([this] { return new AttachmentsPanel(_provider); }, "Attachments"));
+	_pickDockWidgets.insert(studiomdl::PickType::Hitbox, addDockPanel([this] { return new HitboxesPanel(_provider); }, "Hitboxes"));
+	addDockPanel([this] { return new RenderStatisticsPanel(_application); }, "Render Statistics");
+	auto transformDock = addDockPanel([this] { return new TransformPanel(_provider); }, "Transformation");
 
 	//Tabify all dock widgets except floating ones
 	{
@@ -256,6 +260,27 @@ void StudioModelEditWidget::SetSceneIndex(int index)
 	_view->SetSceneIndex(index);
 }
 
+void StudioModelEditWidget::ShowPickedObject(const studiomdl::PickResult& result)
+{
+	const auto dock = _pickDockWidgets.value(result.Type);
+
+	if (!dock)
+	{
+		return;
+	}
+
+	// Hidden panels may not exist yet or still show the dummy asset,
+	// so the panel applies the pick once it is visible and shows the current asset.
+	if (_dockWidgetsVisible)
+	{
+		dock->show();
+		dock->raise();
+	}
+
+	const auto widget = static_cast<LazyDockableWidget*>(dock->widget());
+	static_cast<StudioModelDockPanel*>(widget->GetOrCreateWidget())->SelectPickedObject(result);
+}
+
 void StudioModelEditWidget::OnDockLocationChanged(Qt::DockWidgetArea area)
 {
 	auto dock = static_cast<QDockWidget*>(sender());
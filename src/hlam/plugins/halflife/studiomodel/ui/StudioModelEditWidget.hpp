@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <QMap>
 #include <QVector>
 #include <QWidget>
 
@@ -8,7 +9,6 @@
 
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
 
-class CamerasPanel;
 class QDockWidget;
 
 namespace graphics
@@ -72,6 +72,11 @@ public slots:
 
 	void SetSceneIndex(int index);
 
+	/**
+	*	@brief Brings the panel that edits the picked object to the front and selects the object in it.
+	*/
+	void ShowPickedObject(const studiomdl::PickResult& result);
+
 private slots:
 	void OnDockLocationChanged(Qt::DockWidgetArea area);
 
@@ -89,12 +94,11 @@ private:
 
 	//Stored separately to maintain list order
 	QVector<QDockWidget*> _dockWidgets;
+	QMap<studiomdl::PickType, QDockWidget*> _pickDockWidgets;
 	QByteArray _initialState;
 
 	bool _dockWidgetsVisible = true;
 	QByteArray _savedDockWidgetsState;
 	QByteArray _savedDockWidgetsGeometry;
-
-	CamerasPanel* _camerasPanel{};
 };
 }
@@ -1,13 +1,17 @@
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
+#include <QLineF>
 #include <QPainter>
+#include <QVector>
 
 #include "entity/HLMVStudioModelEntity.hpp"
 #include "plugins/halflife/studiomodel/ui/StudioModelTextureUtilities.hpp"
 
 std::optional<std::tuple<studiomdl::StudioTextureData, bool, bool>> ConvertImageToTexture(
-	QImage image, std::optional<QSize> requiredSize)
+	QImage image, std::optional<QSize> requiredSize, const graphics::ColorQuantizerOptions& quantizerOptions)
 {
 	bool upscaleToMultipleOf4 = false;
 	
@@ -36,59 +40,60 @@ std::optional<std::tuple<studiomdl::StudioTextureData, bool, bool>> ConvertImage
 		image = image.scaled(requiredSize->width(), requiredSize->height());
 	}
 
-	const QImage::Format inputFormat = image.format();
+	const bool convertToIndexed8 = image.format() != QImage::Format::Format_Indexed8;
 
-	const bool convertToIndexed8 = inputFormat != QImage::Format::Format_Indexed8;
+	std::vector<std::byte> pixels;
+	pixels.resize(static_cast<std::size_t>(image.width()) * image.height());
+
+	graphics::RGBPalette convertedPalette;
 
 	if (convertToIndexed8)
 	{
-		image.convertTo(QImage::Format::Format_Indexed8);
-	}
+		image.convertTo(QImage::Format::Format_ARGB32);
 
-	const QVector<QRgb> palette = image.colorTable();
+		if (image.isNull())
+		{
+			return {};
+		}
 
-	if (palette.isEmpty())
-	{
-		return {};
+		// 32 bit scanlines are never padded so the image can be quantized as a single block.
+		graphics::QuantizeImage(image.width(), image.height(), reinterpret_cast<const std::uint32_t*>(image.constBits()),
+			quantizerOptions, pixels.data(), convertedPalette);
 	}
-
-	//Convert to 8 bit palette based image
-	std::vector<std::byte> pixels;
-
-	pixels.resize(image.width() * image.height());
-
+	else
 	{
-		std::byte* dest = pixels.data();
+		const QVector<QRgb> palette = image.colorTable();
+
+		if (palette.isEmpty())
+		{
+			return {};
+		}
 
+		//Scanlines are padded to 32 bits so copy them one at a time
 		for (int y = 0; y < image.height(); ++y)
 		{
-			for (int x = 0; x < image.width(); ++x, ++dest)
-			{
-				*dest = std::byte(image.pixelIndex(x, y));
-			}
+			std::memcpy(pixels.data() + (static_cast<std::size_t>(y) * image.width()), image.constScanLine(y), image.width());
 		}
-	}
 
-	graphics::RGBPalette convertedPalette;
+		int paletteIndex;
 
-	int paletteIndex;
+		for (paletteIndex = 0; paletteIndex < palette.size(); ++paletteIndex)
+		{
+			const auto rgb = palette[paletteIndex];
 
-	for (paletteIndex = 0; paletteIndex < palette.size(); ++paletteIndex)
-	{
-		const auto rgb = palette[paletteIndex];
+			convertedPalette[paletteIndex] =
+			{
+				static_cast<std::uint8_t>(qRed(rgb)),
+				static_cast<std::uint8_t>(qGreen(rgb)),
+				static_cast<std::uint8_t>(qBlue(rgb))
+			};
+		}
 
-		convertedPalette[paletteIndex] =
+		//Fill remaining entries with black
+		for (; paletteIndex < convertedPalette.EntriesCount; ++paletteIndex)
 		{
-			static_cast<std::uint8_t>(qRed(rgb)),
-			static_cast<std::uint8_t>(qGreen(rgb)),
-			static_cast<std::uint8_t>(qBlue(rgb))
-		};
-	}
-
-	//Fill remaining entries with black
-	for (; paletteIndex < convertedPalette.EntriesCount; ++paletteIndex)
-	{
-		convertedPalette[paletteIndex] = {0, 0, 0};
+			convertedPalette[paletteIndex] = {0, 0, 0};
+		}
 	}
 
 	return std::tuple
@@ -120,28 +125,17 @@ QImage ConvertTextureToRGBImage(
 
 QImage ConvertTextureToIndexed8Image(const studiomdl::StudioTextureData& texture)
 {
-	//Ensure data is 32 bit aligned
-	const int alignedWidth = (texture.Width + 3) & (~3);
+	QImage textureImage{texture.Width, texture.Height, QImage::Format::Format_Indexed8};
 
-	std::unique_ptr<uchar[]> alignedPixels = std::make_unique<uchar[]>(alignedWidth * texture.Height);
-
-	for (int h = 0; h < texture.Height; ++h)
+	//Scanlines are padded to 32 bits so copy them one at a time
+	for (int y = 0; y < texture.Height; ++y)
 	{
-		for (int w = 0; w < texture.Width; ++w)
-		{
-			alignedPixels[(alignedWidth * h) + w] = std::to_integer<uchar>(texture.Pixels[(texture.Width * h) + w]);
-		}
+		std::memcpy(textureImage.scanLine(y), texture.Pixels.data() + (static_cast<std::size_t>(y) * texture.Width), texture.Width);
 	}
 
-	QImage textureImage{alignedPixels.release(), texture.Width, texture.Height, QImage::Format::Format_Indexed8, [](auto pixels)
-		{
-			delete[] reinterpret_cast<uchar*>(pixels);
-		}
-	};
-
 	QVector<QRgb> palette;
 
-	palette.reserve(texture.Palette.GetSizeInBytes());
+	palette.reserve(texture.Palette.EntriesCount);
 
 	for (const auto& rgb : texture.Palette)
 	{
@@ -154,10 +148,9 @@ QImage ConvertTextureToIndexed8Image(const studiomdl::StudioTextureData& texture
 }
 
 QImage CreateUVMapImage(
-	const studiomdl::EditableStudioModel& model, int textureIndex, int meshIndex, bool antiAliasLines, float textureScale, qreal lineWidth)
+	const studiomdl::StudioTextureData& texture, const std::vector<studiomdl::UVEdge>& edges,
+	bool antiAliasLines, float textureScale, qreal lineWidth)
 {
-	const auto& texture = model.Textures[textureIndex]->Data;
-
 	//RGBA format because only the UV lines need to be drawn, with no background
 	QImage image{static_cast<int>(std::ceil(texture.Width * textureScale)), static_cast<int>(std::ceil(texture.Height * textureScale)),
 		QImage::Format::Format_RGBA8888};
@@ -165,71 +158,22 @@ QImage CreateUVMapImage(
 	//Set as transparent
 	image.fill(Qt::transparent);
 
-	QPainter painter{&image};
-
-	painter.setPen(QPen{Qt::white, lineWidth});
-	painter.setRenderHint(QPainter::RenderHint::Antialiasing, antiAliasLines);
+	QVector<QLineF> lines;
+	lines.reserve(static_cast<int>(edges.size()));
 
-	auto fixCoords = [=](int x, int y)
+	for (const auto& edge : edges)
 	{
-		return QPointF(x * textureScale, y * textureScale);
-	};
-
-	auto meshes = model.ComputeMeshList(textureIndex);
-
-	if (meshIndex != -1)
-	{
-		auto singleMesh = meshes[meshIndex];
-		meshes.clear();
-		meshes.emplace_back(singleMesh);
+		lines.append(QLineF{
+			edge.S0 * textureScale, edge.T0 * textureScale,
+			edge.S1 * textureScale, edge.T1 * textureScale});
 	}
 
-	for (const auto mesh : meshes)
-	{
-		auto ptricmds = mesh->Triangles.data();
-
-		for (int i; i = *(ptricmds++);)
-		{
-			if (i < 0)
-			{
-				i = -i;
-
-				const auto firstVertex{fixCoords(ptricmds[2], ptricmds[3])};
-
-				ptricmds += 4;
-				--i;
-
-				for (; i > 0; --i, ptricmds += 4)
-				{
-					painter.drawLine(firstVertex, fixCoords(ptricmds[2], ptricmds[3]));
-
-					if (i > 1)
-					{
-						painter.drawLine(fixCoords(ptricmds[2], ptricmds[3]), fixCoords(ptricmds[6], ptricmds[7]));
-					}
-				}
-			}
-			else
-			{
-				auto firstVertex{fixCoords(ptricmds[2], ptricmds[3])};
-				auto secondVertex{fixCoords(ptricmds[6], ptricmds[7])};
-
-				painter.drawLine(firstVertex, secondVertex);
-
-				ptricmds += 8;
-				i -= 2;
+	QPainter painter{&image};
 
-				for (; i > 0; --i, ptricmds += 4)
-				{
-					painter.drawLine(secondVertex, fixCoords(ptricmds[2], ptricmds[3]));
-					painter.drawLine(fixCoords(ptricmds[2], ptricmds[3]), firstVertex);
+	painter.setPen(QPen{Qt::white, lineWidth});
+	painter.setRenderHint(QPainter::RenderHint::Antialiasing, antiAliasLines);
 
-					firstVertex = secondVertex;
-					secondVertex = fixCoords(ptricmds[2], ptricmds[3]);
-				}
-			}
-		}
-	}
+	painter.drawLines(lines);
 
 	return image;
 }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <vector>
 
 #include <QColor>
 #include <QImage>
@@ -12,14 +13,19 @@
 #include <QString>
 
 #include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelUVEdges.hpp"
+
+#include "graphics/ColorQuantizer.hpp"
 #include "graphics/Palette.hpp"
 
 /**
 *	@brief Converts an image to an indexed 8 bit image compatible with GoldSource
+*	Images that are not already indexed are reduced to 256 colors using @p quantizerOptions.
+*	Safe to call from any thread.
 *	@return If conversion succeeded, the converted texture and whether the image was converted from another format to index 8 bit
 */
 std::optional<std::tuple<studiomdl::StudioTextureData, bool, bool>> ConvertImageToTexture(
-	QImage image, std::optional<QSize> requiredSize);
+	QImage image, std::optional<QSize> requiredSize, const graphics::ColorQuantizerOptions& quantizerOptions);
 
 QImage ConvertTextureToRGBImage(
 	const studiomdl::StudioTextureData& texture, const std::byte* textureData,
@@ -27,8 +33,11 @@ QImage ConvertTextureToRGBImage(
 
 QImage ConvertTextureToIndexed8Image(const studiomdl::StudioTextureData& texture);
 
+/**
+*	@brief Draws UV map edges, as returned by studiomdl::ExtractUVEdges, on a transparent image of the texture's size times @p textureScale.
+*/
 QImage CreateUVMapImage(
-	const studiomdl::EditableStudioModel& model, int textureIndex, int meshIndex,
+	const studiomdl::StudioTextureData& texture, const std::vector<studiomdl::UVEdge>& edges,
 	bool antiAliasLines, float textureScale, qreal lineWidth);
 
 void DrawUVImage(const QColor& backgroundColor, bool showUVMap, bool overlayOnTexture,
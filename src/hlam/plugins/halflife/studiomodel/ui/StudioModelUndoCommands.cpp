@@ -1,8 +1,12 @@
 #include <cmath>
+#include <cstdint>
 
 #include <QAbstractItemModel>
 
+#include "application/AssetManager.hpp"
+
 #include "entity/HLMVStudioModelEntity.hpp"
+#include "formats/studiomodel/MeshOptimization.hpp"
 #include "graphics/IGraphicsContext.hpp"
 #include "graphics/Scene.hpp"
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
@@ -11,6 +15,124 @@
 
 namespace studiomodel
 {
+namespace
+{
+template<typename T>
+void WriteOptionalVector(UndoDataWriter& writer, const std::optional<std::vector<T>>& values)
+{
+	writer.Write(values.has_value());
+
+	if (values)
+	{
+		writer.WriteVector(*values);
+	}
+}
+
+template<typename T>
+std::optional<std::vector<T>> ReadOptionalVector(UndoDataReader& reader)
+{
+	if (!reader.Read<bool>())
+	{
+		return {};
+	}
+
+	return reader.ReadVector<T>();
+}
+
+QByteArray SerializeScaleData(const studiomdl::ScaleData& data)
+{
+	UndoDataWriter writer;
+
+	WriteOptionalVector(writer, data.Meshes);
+	WriteOptionalVector(writer, data.Hitboxes);
+	WriteOptionalVector(writer, data.SequenceBBoxes);
+	WriteOptionalVector(writer, data.Bones);
+
+	writer.Write(data.EyePosition.has_value());
+
+	if (data.EyePosition)
+	{
+		writer.Write(*data.EyePosition);
+	}
+
+	WriteOptionalVector(writer, data.Attachments);
+
+	return writer.GetData();
+}
+
+std::optional<studiomdl::ScaleData> DeserializeScaleData(QByteArray&& serialized)
+{
+	UndoDataReader reader{std::move(serialized)};
+
+	studiomdl::ScaleData data;
+
+	data.Meshes = ReadOptionalVector<glm::vec3>(reader);
+	data.Hitboxes = ReadOptionalVector<std::pair<glm::vec3, glm::vec3>>(reader);
+	data.SequenceBBoxes = ReadOptionalVector<std::pair<glm::vec3, glm::vec3>>(reader);
+	data.Bones = ReadOptionalVector<studiomdl::ScaleBonesBoneData>(reader);
+
+	if (reader.Read<bool>())
+	{
+		data.EyePosition = reader.Read<glm::vec3>();
+	}
+
+	data.Attachments = ReadOptionalVector<glm::vec3>(reader);
+
+	if (!reader.IsValid())
+	{
+		return {};
+	}
+
+	return data;
+}
+
+QByteArray SerializeTriangleCommands(const std::vector<std::vector<short>>& commands)
+{
+	UndoDataWriter writer;
+
+	writer.Write(static_cast<std::uint64_t>(commands.size()));
+
+	for (const auto& mesh : commands)
+	{
+		writer.WriteVector(mesh);
+	}
+
+	return writer.GetData();
+}
+
+QByteArray SerializeTexture(const ImportTextureData& texture)
+{
+	UndoDataWriter writer;
+
+	writer.Write(texture.Data.Width);
+	writer.Write(texture.Data.Height);
+	writer.WriteVector(texture.Data.Pixels);
+	writer.Write(texture.Data.Palette);
+	writer.WriteVector(texture.ScaledSTCoordinates.Coordinates);
+
+	return writer.GetData();
+}
+}
+
+void DiscardUndoCommand(QUndoCommand* command)
+{
+	if (auto modelCommand = dynamic_cast<BaseModelUndoCommand*>(command); modelCommand)
+	{
+		modelCommand->Discard();
+	}
+
+	for (int i = 0; i < command->childCount(); ++i)
+	{
+		DiscardUndoCommand(const_cast<QUndoCommand*>(command->child(i)));
+	}
+}
+
+void BaseModelUndoCommand::ReportInvalidData()
+{
+	_asset->GetApplication()->GetLogger()->error(
+		"Could not undo or redo \"{}\": the stored data could not be read", text().toStdString());
+}
+
 void BaseModelUndoCommand::EmitDataChanged(QAbstractItemModel* model, int index)
 {
 	const auto modelIndex = model->index(index, 0);
@@ -112,39 +234,86 @@ void ChangeModelFlagsCommand::Apply(const int& oldValue, const int& newValue)
 	emit _asset->GetModelData()->ModelFlagsChanged();
 }
 
-void ChangeModelOriginCommand::undo()
+void ChangeModelOriginCommand::Undo()
 {
 	ApplyMoveData(*_asset->GetEditableStudioModel(), _data, std::nullopt);
 	emit _asset->GetModelData()->ModelOriginChanged();
 }
 
-void ChangeModelOriginCommand::redo()
+void ChangeModelOriginCommand::Redo()
 {
 	ApplyMoveData(*_asset->GetEditableStudioModel(), _data, _offset);
 	emit _asset->GetModelData()->ModelOriginChanged();
 }
 
-void ChangeModelScaleCommand::undo()
+ChangeModelScaleCommand::ChangeModelScaleCommand(StudioModelAsset* asset, const studiomdl::ScaleData& data, float scale)
+	: BaseModelUndoCommand(asset, ModelChangeId::ChangeModelScale)
+	, _data(asset->GetUndoDataStore()->Store(SerializeScaleData(data)))
+	, _scale(scale)
 {
-	ApplyScaleData(*_asset->GetEditableStudioModel(), _data, std::nullopt);
-	emit _asset->GetModelData()->ModelScaleChanged();
+	setText("Scale model");
 }
 
-void ChangeModelScaleCommand::redo()
+void ChangeModelScaleCommand::Undo()
 {
-	ApplyScaleData(*_asset->GetEditableStudioModel(), _data, _scale);
+	Apply(std::nullopt);
+}
+
+void ChangeModelScaleCommand::Redo()
+{
+	Apply(_scale);
+}
+
+void ChangeModelScaleCommand::Apply(std::optional<float> scale)
+{
+	const auto data = DeserializeScaleData(_data.Load());
+
+	if (!data)
+	{
+		ReportInvalidData();
+		return;
+	}
+
+	ApplyScaleData(*_asset->GetEditableStudioModel(), *data, scale);
 	emit _asset->GetModelData()->ModelScaleChanged();
 }
 
-void ChangeModelRotationCommand::undo()
+ChangeModelRotationCommand::ChangeModelRotationCommand(
+	StudioModelAsset* asset, const std::vector<studiomdl::RotateBoneData>& data, const glm::vec3& angles)
+	: BaseModelUndoCommand(asset, ModelChangeId::ChangeModelRotation)
+	, _angles(angles)
 {
-	ApplyRotateData(*_asset->GetEditableStudioModel(), _data, std::nullopt);
-	emit _asset->GetModelData()->ModelRotationChanged();
+	setText("Rotate model");
+
+	UndoDataWriter writer;
+	writer.WriteVector(data);
+
+	_data = asset->GetUndoDataStore()->Store(writer.GetData());
+}
+
+void ChangeModelRotationCommand::Undo()
+{
+	Apply(std::nullopt);
+}
+
+void ChangeModelRotationCommand::Redo()
+{
+	Apply(_angles);
 }
 
-void ChangeModelRotationCommand::redo()
+void ChangeModelRotationCommand::Apply(std::optional<glm::vec3> angles)
 {
-	ApplyRotateData(*_asset->GetEditableStudioModel(), _data, _angles);
+	UndoDataReader reader{_data.Load()};
+
+	const auto data = reader.ReadVector<studiomdl::RotateBoneData>();
+
+	if (!reader.IsValid())
+	{
+		ReportInvalidData();
+		return;
+	}
+
+	ApplyRotateData(*_asset->GetEditableStudioModel(), data, angles);
 	emit _asset->GetModelData()->ModelRotationChanged();
 }
 
@@ -181,18 +350,61 @@ void ChangeTextureFlagsCommand::Apply(int index, const int& oldValue, const int&
 	emit _asset->GetModelData()->TextureFlagsChanged(index);
 }
 
-void ImportTextureCommand::Apply(int index, const ImportTextureData& oldValue, const ImportTextureData& newValue)
+ImportTextureCommand::ImportTextureCommand(
+	StudioModelAsset* asset, int textureIndex, const ImportTextureData& oldTexture, const ImportTextureData& newTexture)
+	: BaseModelUndoCommand(asset, ModelChangeId::ImportTexture)
+	, _index(textureIndex)
+	, _oldTexture(asset->GetUndoDataStore()->Store(SerializeTexture(oldTexture)))
+	, _newTexture(asset->GetUndoDataStore()->Store(SerializeTexture(newTexture)))
+{
+	setText("Import texture");
+}
+
+void ImportTextureCommand::Undo()
 {
+	Apply(_oldTexture);
+}
+
+void ImportTextureCommand::Redo()
+{
+	Apply(_newTexture);
+}
+
+void ImportTextureCommand::Apply(const UndoData& texture)
+{
+	UndoDataReader reader{texture.Load()};
+
+	const int width = reader.Read<int>();
+	const int height = reader.Read<int>();
+	auto pixels = reader.ReadVector<std::byte>();
+	const auto palette = reader.Read<graphics::RGBPalette>();
+
+	const studiomdl::ScaleSTCoordinatesData coordinates{
+		reader.ReadVector<studiomdl::ScaleSTCoordinatesData::STCoordinate>()};
+
+	if (!reader.IsValid())
+	{
+		ReportInvalidData();
+		return;
+	}
+
 	auto model = _asset->GetEditableStudioModel();
-	model->Textures[index]->Data = newValue.Data;
+	auto& data = model->Textures[_index]->Data;
+
+	data.Width = width;
+	data.Height = height;
+	data.Pixels = std::move(pixels);
+	data.Palette = palette;
 
 	auto graphicsContext = _asset->GetGraphicsContext();
 
 	graphicsContext->Begin();
-	model->UpdateTexture(*_asset->GetTextureLoader(), index);
+	model->UpdateTexture(*_asset->GetTextureLoader(), _index);
 	graphicsContext->End();
 
-	studiomdl::ApplyScaledSTCoordinatesData(*model, index, newValue.ScaledSTCoordinates);
+	studiomdl::ApplyScaledSTCoordinatesData(*model, _index, coordinates);
+
+	emit _asset->GetModelData()->TextureDataChanged(_index);
 }
 
 void ChangeSequencePropsCommand::Apply(int index, const SequenceProps& oldValue, const SequenceProps& newValue)
@@ -283,60 +495,77 @@ void ChangeModelNameCommand::Apply(int index, const QString& oldValue, const QSt
 	emit _asset->GetModelData()->SubModelNameChanged(index, _modelIndex);
 }
 
-FlipNormalsCommand::FlipNormalsCommand(StudioModelAsset* asset)
-	: BaseModelUndoCommand(asset, ModelChangeId::FlipNormals)
+void FlipNormalsCommand::Undo()
 {
-	setText("Flip normals");
+	FlipNormals();
+}
 
-	auto model = asset->GetEditableStudioModel();
+void FlipNormalsCommand::Redo()
+{
+	FlipNormals();
+}
+
+void FlipNormalsCommand::FlipNormals()
+{
+	auto model = _asset->GetEditableStudioModel();
 
 	for (auto& bodypart : model->Bodyparts)
 	{
 		for (auto& model : bodypart->Models)
 		{
-			_normals.reserve(_normals.size() + model.Normals.size());
-
 			for (auto& normal : model.Normals)
 			{
-				_normals.push_back(normal.Vertex);
+				normal.Vertex = -normal.Vertex;
 			}
 		}
 	}
 }
 
-void FlipNormalsCommand::undo()
+void RecalculateBoundsCommand::Apply(const studiomdl::StudioModelBounds& oldValue, const studiomdl::StudioModelBounds& newValue)
 {
-	auto model = _asset->GetEditableStudioModel();
+	ApplyBounds(*_asset->GetEditableStudioModel(), newValue);
+	emit _asset->GetModelData()->ModelBBoxChanged();
+}
 
-	std::size_t normalIndex = 0;
+OptimizeMeshesCommand::OptimizeMeshesCommand(StudioModelAsset* asset,
+	const std::vector<std::vector<short>>& oldCommands, const std::vector<std::vector<short>>& newCommands)
+	: BaseModelUndoCommand(asset, ModelChangeId::OptimizeMeshes)
+	, _oldCommands(asset->GetUndoDataStore()->Store(SerializeTriangleCommands(oldCommands)))
+	, _newCommands(asset->GetUndoDataStore()->Store(SerializeTriangleCommands(newCommands)))
+{
+	setText("Optimize mesh strips");
+}
 
-	for (auto& bodypart : model->Bodyparts)
-	{
-		for (auto& model : bodypart->Models)
-		{
-			for (auto& normal : model.Normals)
-			{
-				normal.Vertex = _normals[normalIndex++];
-			}
-		}
-	}
+void OptimizeMeshesCommand::Undo()
+{
+	Apply(_oldCommands);
 }
 
-void FlipNormalsCommand::redo()
+void OptimizeMeshesCommand::Redo()
 {
-	auto model = _asset->GetEditableStudioModel();
+	Apply(_newCommands);
+}
 
-	std::size_t normalIndex = 0;
+void OptimizeMeshesCommand::Apply(const UndoData& commands)
+{
+	UndoDataReader reader{commands.Load()};
 
-	for (auto& bodypart : model->Bodyparts)
+	const auto meshCount = reader.Read<std::uint64_t>();
+
+	std::vector<std::vector<short>> meshes;
+
+	for (std::uint64_t i = 0; i < meshCount && reader.IsValid(); ++i)
 	{
-		for (auto& model : bodypart->Models)
-		{
-			for (auto& normal : model.Normals)
-			{
-				normal.Vertex = -_normals[normalIndex++];
-			}
-		}
+		meshes.push_back(reader.ReadVector<short>());
 	}
+
+	if (!reader.IsValid())
+	{
+		ReportInvalidData();
+		return;
+	}
+
+	studiomdl::ApplyTriangleCommands(*_asset->GetEditableStudioModel(), meshes);
+	emit _asset->GetModelData()->MeshDataChanged();
 }
 }
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <QString>
@@ -11,6 +12,9 @@
 
 #include <glm/vec3.hpp>
 
+#include "application/UndoDataStore.hpp"
+
+#include "formats/studiomodel/StudioModelBounds.hpp"
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 #include "graphics/Palette.hpp"
 
@@ -55,6 +59,10 @@ enum class ModelChangeId
 	ChangeModelName,
 
 	FlipNormals,
+
+	RecalculateBounds,
+
+	OptimizeMeshes,
 };
 
 enum class AddRemoveType
@@ -79,14 +87,66 @@ protected:
 public:
 	int id() const override final { return static_cast<int>(_id); }
 
+	void undo() override final
+	{
+		// Discarded commands no longer have the data needed to change the model.
+		if (!_discarded)
+		{
+			Undo();
+		}
+	}
+
+	void redo() override final
+	{
+		if (!_discarded)
+		{
+			Redo();
+		}
+	}
+
+	bool IsDiscarded() const { return _discarded; }
+
+	/**
+	*	@brief Releases data stored in the asset's UndoDataStore.
+	*	The command stays on the undo stack but no longer changes the model when undone or redone.
+	*/
+	void Discard()
+	{
+		if (!_discarded)
+		{
+			_discarded = true;
+			DiscardData();
+		}
+	}
+
 protected:
+	virtual void Undo() = 0;
+	virtual void Redo() = 0;
+
+	virtual void DiscardData() {}
+
+	/**
+	*	@brief Logs that data loaded from the asset's UndoDataStore was missing or corrupt.
+	*	The model is left unchanged in that case.
+	*/
+	void ReportInvalidData();
+
 	void EmitDataChanged(QAbstractItemModel* model, int index);
 
 protected:
 	StudioModelAsset* const _asset;
 	const ModelChangeId _id;
+
+private:
+	bool _discarded{false};
 };
 
+/**
+*	@brief Discards a command and its children.
+*	Commands must be discarded oldest first so every command that can still be undone has all earlier changes available.
+*/
+void DiscardUndoCommand(QUndoCommand* command);
+
 template<typename T>
 class ModelUndoCommand : public BaseModelUndoCommand
 {
@@ -126,12 +186,12 @@ public:
 		return true;
 	}
 
-	void undo() override
+	void Undo() override
 	{
 		Apply(_newValue, _oldValue);
 	}
 
-	void redo() override
+	void Redo() override
 	{
 		Apply(_oldValue, _newValue);
 	}
@@ -196,12 +256,12 @@ public:
 		return true;
 	}
 
-	void undo() override
+	void Undo() override
 	{
 		Apply(_index, _newValue, _oldValue);
 	}
 
-	void redo() override
+	void Redo() override
 	{
 		Apply(_index, _oldValue, _newValue);
 	}
@@ -239,12 +299,12 @@ protected:
 	}
 
 public:
-	void undo() override
+	void Undo() override
 	{
 		Apply(false);
 	}
 
-	void redo() override
+	void Redo() override
 	{
 		Apply(true);
 	}
@@ -484,8 +544,8 @@ public:
 		setText("Change model origin");
 	}
 
-	void undo() override;
-	void redo() override;
+	void Undo() override;
+	void Redo() override;
 
 private:
 	const std::vector<studiomdl::MoveBoneData> _data;
@@ -495,19 +555,21 @@ private:
 class ChangeModelScaleCommand : public BaseModelUndoCommand
 {
 public:
-	ChangeModelScaleCommand(StudioModelAsset* asset, studiomdl::ScaleData&& data, float scale)
-		: BaseModelUndoCommand(asset, ModelChangeId::ChangeModelScale)
-		, _data(std::move(data))
-		, _scale(scale)
+	ChangeModelScaleCommand(StudioModelAsset* asset, const studiomdl::ScaleData& data, float scale);
+
+	void Undo() override;
+	void Redo() override;
+
+	void DiscardData() override
 	{
-		setText("Scale model");
+		_data.Discard();
 	}
 
-	void undo() override;
-	void redo() override;
+private:
+	void Apply(std::optional<float> scale);
 
 private:
-	const studiomdl::ScaleData _data;
+	UndoData _data;
 	const float _scale;
 };
 
@@ -515,19 +577,21 @@ class ChangeModelRotationCommand : public BaseModelUndoCommand
 {
 public:
 	ChangeModelRotationCommand(
-		StudioModelAsset* asset, std::vector<studiomdl::RotateBoneData>&& data, const glm::vec3& angles)
-		: BaseModelUndoCommand(asset, ModelChangeId::ChangeModelRotation)
-		, _data(std::move(data))
-		, _angles(angles)
+		StudioModelAsset* asset, const std::vector<studiomdl::RotateBoneData>& data, const glm::vec3& angles);
+
+	void Undo() override;
+	void Redo() override;
+
+	void DiscardData() override
 	{
-		setText("Rotate model");
+		_data.Discard();
 	}
 
-	void undo() override;
-	void redo() override;
+private:
+	void Apply(std::optional<glm::vec3> angles);
 
 private:
-	const std::vector<studiomdl::RotateBoneData> _data;
+	UndoData _data;
 	const glm::vec3 _angles;
 };
 
@@ -607,17 +671,30 @@ struct ImportTextureData
 	ImportTextureData& operator=(ImportTextureData&& other) = default;
 };
 
-class ImportTextureCommand : public ModelListUndoCommand<ImportTextureData>
+/**
+*	@brief Stores the old and new texture in the asset's UndoDataStore instead of keeping copies of the pixels around.
+*/
+class ImportTextureCommand : public BaseModelUndoCommand
 {
 public:
-	ImportTextureCommand(StudioModelAsset* asset, int textureIndex, ImportTextureData&& oldTexture, ImportTextureData&& newTexture)
-		: ModelListUndoCommand(asset, ModelChangeId::ImportTexture, textureIndex, std::move(oldTexture), std::move(newTexture))
+	ImportTextureCommand(StudioModelAsset* asset, int textureIndex, const ImportTextureData& oldTexture, const ImportTextureData& newTexture);
+
+	void Undo() override;
+	void Redo() override;
+
+	void DiscardData() override
 	{
-		setText("Import texture");
+		_oldTexture.Discard();
+		_newTexture.Discard();
 	}
 
-protected:
-	void Apply(int index, const ImportTextureData& oldValue, const ImportTextureData& newValue) override;
+private:
+	void Apply(const UndoData& texture);
+
+private:
+	const int _index;
+	UndoData _oldTexture;
+	UndoData _newTexture;
 };
 
 struct SequenceProps
@@ -710,15 +787,62 @@ protected:
 	const int _modelIndex;
 };
 
+/**
+*	@brief Flipping normals is its own inverse, so no copy of the normals is kept.
+*/
 class FlipNormalsCommand : public BaseModelUndoCommand
 {
 public:
-	explicit FlipNormalsCommand(StudioModelAsset* asset);
+	explicit FlipNormalsCommand(StudioModelAsset* asset)
+		: BaseModelUndoCommand(asset, ModelChangeId::FlipNormals)
+	{
+		setText("Flip normals");
+	}
+
+	void Undo() override;
+	void Redo() override;
 
-	void undo() override;
-	void redo() override;
+private:
+	void FlipNormals();
+};
+
+class RecalculateBoundsCommand : public ModelUndoCommand<studiomdl::StudioModelBounds>
+{
+public:
+	RecalculateBoundsCommand(StudioModelAsset* asset,
+		studiomdl::StudioModelBounds&& oldBounds, studiomdl::StudioModelBounds&& newBounds)
+		: ModelUndoCommand(asset, ModelChangeId::RecalculateBounds, std::move(oldBounds), std::move(newBounds))
+	{
+		setText("Recalculate bounding boxes");
+	}
+
+protected:
+	void Apply(const studiomdl::StudioModelBounds& oldValue, const studiomdl::StudioModelBounds& newValue) override;
+};
+
+/**
+*	@brief Stores the old and new triangle commands of all meshes in the asset's UndoDataStore.
+*/
+class OptimizeMeshesCommand : public BaseModelUndoCommand
+{
+public:
+	OptimizeMeshesCommand(StudioModelAsset* asset,
+		const std::vector<std::vector<short>>& oldCommands, const std::vector<std::vector<short>>& newCommands);
+
+	void Undo() override;
+	void Redo() override;
+
+	void DiscardData() override
+	{
+		_oldCommands.Discard();
+		_newCommands.Discard();
+	}
+
+private:
+	void Apply(const UndoData& commands);
 
 private:
-	std::vector<glm::vec3> _normals;
+	UndoData _oldCommands;
+	UndoData _newCommands;
 };
 }
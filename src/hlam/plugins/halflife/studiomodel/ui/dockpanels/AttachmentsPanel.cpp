@@ -17,7 +17,7 @@
 namespace studiomodel
 {
 AttachmentsPanel::AttachmentsPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -28,8 +28,6 @@ AttachmentsPanel::AttachmentsPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Attachments, qOverload<int>(&QComboBox::currentIndexChanged),
 		attachmentNameValidator, &UniqueAttachmentNameValidator::SetCurrentIndex);
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &AttachmentsPanel::OnAssetChanged);
-
 	connect(_ui.Attachments, qOverload<int>(&QComboBox::currentIndexChanged),
 		this, &AttachmentsPanel::OnAttachmentChanged);
 	connect(_ui.HighlightAttachment, &QCheckBox::stateChanged, this, &AttachmentsPanel::OnHighlightAttachmentChanged);
@@ -40,7 +38,7 @@ AttachmentsPanel::AttachmentsPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Bone, qOverload<int>(&QComboBox::currentIndexChanged), this, &AttachmentsPanel::OnPropsChanged);
 	connect(_ui.Origin, &qt::widgets::ShortVector3Edit::ValueChanged, this, &AttachmentsPanel::OnPropsChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 AttachmentsPanel::~AttachmentsPanel() = default;
@@ -105,6 +103,14 @@ void AttachmentsPanel::OnLoadSnapshot(StateSnapshot* snapshot)
 		snapshot->Value("attachments.attachment").toInt(), _asset->GetEntity()->GetEditableModel()->Attachments.size(), *_ui.Attachments);
 }
 
+void AttachmentsPanel::OnObjectPicked(const studiomdl::PickResult& result)
+{
+	if (result.Type == studiomdl::PickType::Attachment)
+	{
+		_ui.Attachments->setCurrentIndex(result.Index);
+	}
+}
+
 void AttachmentsPanel::UpdateQCString()
 {
 	const auto model = _asset->GetEntity()->GetEditableModel();
@@ -2,17 +2,22 @@
 
 #include "ui_AttachmentsPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 class StateSnapshot;
 
+namespace studiomdl
+{
+struct PickResult;
+}
+
 namespace studiomodel
 {
 class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class AttachmentsPanel final : public DockableWidget
+class AttachmentsPanel final : public StudioModelDockPanel
 {
 public:
 	explicit AttachmentsPanel(StudioModelAssetProvider* provider);
@@ -24,11 +29,13 @@ private:
 	void UpdateQCString();
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
 
+	void OnObjectPicked(const studiomdl::PickResult& result) override;
+
 	void OnAttachmentChanged(int index);
 	void OnHighlightAttachmentChanged();
 
@@ -38,7 +45,6 @@ private slots:
 
 private:
 	Ui_AttachmentsPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
@@ -17,7 +17,7 @@
 namespace studiomodel
 {
 BodyPartsPanel::BodyPartsPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -30,8 +30,6 @@ BodyPartsPanel::BodyPartsPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Submodels, qOverload<int>(&QComboBox::currentIndexChanged),
 		modelNameValidator, &UniqueModelNameValidator::SetCurrentIndex);
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &BodyPartsPanel::OnAssetChanged);
-
 	connect(_ui.BodyParts, qOverload<int>(&QComboBox::currentIndexChanged), this, &BodyPartsPanel::OnBodyPartChanged);
 	connect(_ui.Submodels, qOverload<int>(&QComboBox::currentIndexChanged), this, &BodyPartsPanel::OnSubmodelChanged);
 	connect(_ui.Skins, qOverload<int>(&QComboBox::currentIndexChanged), this, &BodyPartsPanel::OnSkinChanged);
@@ -39,7 +37,7 @@ BodyPartsPanel::BodyPartsPanel(StudioModelAssetProvider* provider)
 	connect(_ui.ModelName, &QLineEdit::textChanged, this, &BodyPartsPanel::OnModelNameChanged);
 	connect(_ui.ModelName, &QLineEdit::inputRejected, this, &BodyPartsPanel::OnModelNameRejected);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 BodyPartsPanel::~BodyPartsPanel() = default;
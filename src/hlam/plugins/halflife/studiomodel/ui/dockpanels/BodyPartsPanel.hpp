@@ -2,7 +2,7 @@
 
 #include "ui_BodyPartsPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 class StateSnapshot;
 
@@ -12,7 +12,7 @@ class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class BodyPartsPanel final : public DockableWidget
+class BodyPartsPanel final : public StudioModelDockPanel
 {
 public:
 	explicit BodyPartsPanel(StudioModelAssetProvider* provider);
@@ -21,7 +21,7 @@ public:
 	void OnLayoutDirectionChanged(QBoxLayout::Direction direction) override;
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
@@ -37,7 +37,6 @@ private slots:
 
 private:
 	Ui_BodyPartsPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
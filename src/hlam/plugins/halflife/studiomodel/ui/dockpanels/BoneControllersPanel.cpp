@@ -19,7 +19,7 @@ namespace studiomodel
 constexpr int BoneOffset = 1;
 
 BoneControllersPanel::BoneControllersPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -36,8 +36,6 @@ BoneControllersPanel::BoneControllersPanel(StudioModelAssetProvider* provider)
 		spinBox->setRange(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max());
 	}
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &BoneControllersPanel::OnAssetChanged);
-
 	connect(_ui.BoneControllers, qOverload<int>(&QComboBox::currentIndexChanged),
 		this, &BoneControllersPanel::OnBoneControllerChanged);
 	connect(_ui.BoneControllerValueSlider, &QSlider::valueChanged,
@@ -59,7 +57,7 @@ BoneControllersPanel::BoneControllersPanel(StudioModelAssetProvider* provider)
 	connect(_ui.BoneControllerBoneAxis, qOverload<int>(&QComboBox::currentIndexChanged),
 		this, &BoneControllersPanel::OnPropsChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 BoneControllersPanel::~BoneControllersPanel() = default;
@@ -2,7 +2,7 @@
 
 #include "ui_BoneControllersPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 namespace studiomdl
 {
@@ -17,7 +17,7 @@ class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class BoneControllersPanel final : public DockableWidget
+class BoneControllersPanel final : public StudioModelDockPanel
 {
 public:
 	explicit BoneControllersPanel(StudioModelAssetProvider* provider);
@@ -27,7 +27,7 @@ private:
 	void UpdateControllerRange(const studiomdl::StudioBoneController& boneController);
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
@@ -41,7 +41,6 @@ private slots:
 
 private:
 	Ui_BoneControllersPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
@@ -20,7 +20,7 @@ constexpr int ParentBoneOffset = 1;
 constexpr int BoneControllerOffset = 1;
 
 BonesPanel::BonesPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -30,8 +30,6 @@ BonesPanel::BonesPanel(StudioModelAssetProvider* provider)
 
 	connect(_ui.Bones, qOverload<int>(&QComboBox::currentIndexChanged), boneNameValidator, &UniqueBoneNameValidator::SetCurrentIndex);
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &BonesPanel::OnAssetChanged);
-
 	connect(_ui.Bones, qOverload<int>(&QComboBox::currentIndexChanged), this, &BonesPanel::OnBoneChanged);
 	connect(_ui.HighlightBone, &QCheckBox::stateChanged, this, &BonesPanel::OnHightlightBoneChanged);
 
@@ -43,7 +41,7 @@ BonesPanel::BonesPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Rotation, &qt::widgets::ShortVector3Edit::ValueChanged, this, &BonesPanel::OnPropsChanged);
 	connect(_ui.RotationScale, &qt::widgets::ShortVector3Edit::ValueChanged, this, &BonesPanel::OnPropsChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 BonesPanel::~BonesPanel() = default;
@@ -160,6 +158,14 @@ void BonesPanel::OnLoadSnapshot(StateSnapshot* snapshot)
 	}
 }
 
+void BonesPanel::OnObjectPicked(const studiomdl::PickResult& result)
+{
+	if (result.Type == studiomdl::PickType::Bone)
+	{
+		_ui.Bones->setCurrentIndex(result.Index);
+	}
+}
+
 void BonesPanel::OnBoneChanged(int index)
 {
 	// Don't refresh the UI if this is getting called in response to a change we made.
@@ -2,19 +2,24 @@
 
 #include "ui_BonesPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 class QModelIndex;
 
 class StateSnapshot;
 
+namespace studiomdl
+{
+struct PickResult;
+}
+
 namespace studiomodel
 {
 class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class BonesPanel final : public DockableWidget
+class BonesPanel final : public StudioModelDockPanel
 {
 public:
 	explicit BonesPanel(StudioModelAssetProvider* provider);
@@ -24,11 +29,13 @@ private:
 	void UpdateRootBonesCount();
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
 
+	void OnObjectPicked(const studiomdl::PickResult& result) override;
+
 	void OnBoneChanged(int index);
 	void OnHightlightBoneChanged();
 
@@ -38,7 +45,6 @@ private slots:
 
 private:
 	Ui_BonesPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
@@ -29,6 +29,17 @@ ExportUVMeshDialog::ExportUVMeshDialog(StudioModelAsset* asset,
 
 	const auto& studioTexture = *entity.GetEditableModel()->Textures[_textureIndex];
 
+	auto meshes = entity.GetEditableModel()->ComputeMeshList(_textureIndex);
+
+	if (_meshIndex != -1)
+	{
+		auto singleMesh = meshes[_meshIndex];
+		meshes.clear();
+		meshes.emplace_back(singleMesh);
+	}
+
+	_uvEdges = studiomdl::ExtractUVEdges(meshes);
+
 	connect(_ui.FileName, &QLineEdit::textChanged, this, &ExportUVMeshDialog::OnFileNameChanged);
 	connect(_ui.BrowseFileName, &QPushButton::clicked, this, &ExportUVMeshDialog::OnBrowseFileName);
 
@@ -102,7 +113,7 @@ void ExportUVMeshDialog::OnBrowseFileName()
 
 void ExportUVMeshDialog::UpdatePreview()
 {
-	_uv = CreateUVMapImage(*_entity.GetEditableModel(), _textureIndex, _meshIndex,
+	_uv = CreateUVMapImage(_entity.GetEditableModel()->Textures[_textureIndex]->Data, _uvEdges,
 		ShouldAntiAliasLines(),
 		static_cast<float>(GetImageScale()),
 		static_cast<qreal>(GetUVLineWidth()));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <QDialog>
 #include <QImage>
@@ -8,6 +9,8 @@
 
 #include "ui_ExportUVMeshDialog.h"
 
+#include "formats/studiomodel/StudioModelUVEdges.hpp"
+
 class HLMVStudioModelEntity;
 
 namespace studiomodel
@@ -55,6 +58,12 @@ private:
 	const int _meshIndex;
 
 	const QImage _texture;
+
+	/**
+	*	@brief Extracted once since the preview is redrawn every time an option changes.
+	*/
+	std::vector<studiomdl::UVEdge> _uvEdges;
+
 	QImage _uv;
 	QImage _preview;
 };
@@ -15,14 +15,12 @@
 namespace studiomodel
 {
 HitboxesPanel::HitboxesPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
 	_ui.Hitgroup->setRange(0, std::numeric_limits<int>::max());
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &HitboxesPanel::OnAssetChanged);
-
 	connect(_ui.Hitboxes, qOverload<int>(&QComboBox::currentIndexChanged), this, &HitboxesPanel::OnHitboxChanged);
 	connect(_ui.HighlightHitbox, &QCheckBox::stateChanged, this, &HitboxesPanel::OnHighlightHitboxChanged);
 
@@ -32,7 +30,7 @@ HitboxesPanel::HitboxesPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Minimum, &qt::widgets::ShortVector3Edit::ValueChanged, this, &HitboxesPanel::OnHitboxPropsChanged);
 	connect(_ui.Maximum, &qt::widgets::ShortVector3Edit::ValueChanged, this, &HitboxesPanel::OnHitboxPropsChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 HitboxesPanel::~HitboxesPanel() = default;
@@ -95,6 +93,14 @@ void HitboxesPanel::OnLoadSnapshot(StateSnapshot* snapshot)
 	SetRestoredModelIndex(snapshot->Value("hitboxes.hitbox").toInt(), _asset->GetEntity()->GetEditableModel()->Hitboxes.size(), *_ui.Hitboxes);
 }
 
+void HitboxesPanel::OnObjectPicked(const studiomdl::PickResult& result)
+{
+	if (result.Type == studiomdl::PickType::Hitbox)
+	{
+		_ui.Hitboxes->setCurrentIndex(result.Index);
+	}
+}
+
 void HitboxesPanel::UpdateQCString()
 {
 	const int index = _ui.Hitboxes->currentIndex();
@@ -2,17 +2,22 @@
 
 #include "ui_HitboxesPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 class StateSnapshot;
 
+namespace studiomdl
+{
+struct PickResult;
+}
+
 namespace studiomodel
 {
 class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class HitboxesPanel final : public DockableWidget
+class HitboxesPanel final : public StudioModelDockPanel
 {
 public:
 	explicit HitboxesPanel(StudioModelAssetProvider* provider);
@@ -24,11 +29,13 @@ private:
 	void UpdateQCString();
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
 
+	void OnObjectPicked(const studiomdl::PickResult& result) override;
+
 	void OnHitboxChanged(int index);
 
 	void OnHighlightHitboxChanged();
@@ -37,7 +44,6 @@ private slots:
 
 private:
 	Ui_HitboxesPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
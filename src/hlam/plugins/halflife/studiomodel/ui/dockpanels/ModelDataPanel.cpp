@@ -17,12 +17,10 @@ namespace studiomodel
 constexpr char CheckBoxModelFlagProperty[]{"CheckBoxFlagProperty"};
 
 ModelDataPanel::ModelDataPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &ModelDataPanel::OnAssetChanged);
-
 	connect(_ui.EyePosition, &ShortVector3Edit::ValueChanged, this, &ModelDataPanel::OnEyePositionChanged);
 
 	connect(_ui.BBoxMin, &ShortVector3Edit::ValueChanged, this, &ModelDataPanel::OnBBoxChanged);
@@ -59,7 +57,7 @@ ModelDataPanel::ModelDataPanel(StudioModelAssetProvider* provider)
 	_ui.HitboxCollision->setProperty(CheckBoxModelFlagProperty, EF_HITBOXCOLLISIONS);
 	_ui.ForceSkylight->setProperty(CheckBoxModelFlagProperty, EF_FORCESKYLIGHT);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 ModelDataPanel::~ModelDataPanel() = default;
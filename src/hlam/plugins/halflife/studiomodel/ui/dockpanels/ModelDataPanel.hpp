@@ -2,7 +2,7 @@
 
 #include "ui_ModelDataPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 namespace studiomodel
 {
@@ -10,7 +10,7 @@ class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class ModelDataPanel final : public DockableWidget
+class ModelDataPanel final : public StudioModelDockPanel
 {
 public:
 	explicit ModelDataPanel(StudioModelAssetProvider* provider);
@@ -20,7 +20,7 @@ private:
 	void SetFlags(int flags);
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnEyePositionChanged();
 	void OnBBoxChanged();
@@ -30,7 +30,6 @@ private slots:
 
 private:
 	Ui_ModelDataPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
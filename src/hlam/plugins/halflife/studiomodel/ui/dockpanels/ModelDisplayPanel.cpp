@@ -18,7 +18,7 @@
 namespace studiomodel
 {
 ModelDisplayPanel::ModelDisplayPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -27,8 +27,6 @@ ModelDisplayPanel::ModelDisplayPanel(StudioModelAssetProvider* provider)
 		spinner->setRange(ApplicationSettings::MinimumAspectRatio, ApplicationSettings::MaximumAspectRatio);
 	}
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &ModelDisplayPanel::OnAssetChanged);
-
 	connect(_ui.RenderModeComboBox, qOverload<int>(&QComboBox::currentIndexChanged), this, &ModelDisplayPanel::OnRenderModeChanged);
 
 	connect(_ui.OpacitySlider, &QSlider::valueChanged, this, &ModelDisplayPanel::OnOpacityChanged);
@@ -78,6 +76,8 @@ ModelDisplayPanel::ModelDisplayPanel(StudioModelAssetProvider* provider)
 		connect(_ui.AspectRatioX, qOverload<int>(&QSpinBox::valueChanged), this, lambda);
 		connect(_ui.AspectRatioY, qOverload<int>(&QSpinBox::valueChanged), this, lambda);
 	}
+
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 ModelDisplayPanel::~ModelDisplayPanel() = default;
@@ -2,21 +2,21 @@
 
 #include "ui_ModelDisplayPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 namespace studiomodel
 {
 class StudioModelAsset;
 class StudioModelAssetProvider;
 
-class ModelDisplayPanel final : public DockableWidget
+class ModelDisplayPanel final : public StudioModelDockPanel
 {
 public:
 	explicit ModelDisplayPanel(StudioModelAssetProvider* provider);
 	~ModelDisplayPanel();
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnRenderModeChanged(int index);
 	void OnOpacityChanged(int value);
@@ -45,7 +45,6 @@ private slots:
 
 private:
 	Ui_ModelDisplayPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 };
 }
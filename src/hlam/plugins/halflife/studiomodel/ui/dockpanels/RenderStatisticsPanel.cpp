@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <sstream>
+
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QPainter>
+#include <QPixmap>
+#include <QTableWidgetItem>
+#include <QTimer>
+
+#include "application/AssetManager.hpp"
+
+#include "graphics/RenderStatistics.hpp"
+
+#include "plugins/halflife/studiomodel/ui/dockpanels/RenderStatisticsPanel.hpp"
+
+#include "utility/FrameScheduler.hpp"
+
+namespace studiomodel
+{
+const QString RenderStatisticsPathName{QStringLiteral("RenderStatisticsPath")};
+
+namespace
+{
+constexpr int UpdateIntervalMilliseconds = 500;
+
+// Table rows, in order: frame times, pass times, stage times, counters.
+constexpr int CPUTimeRow = 0;
+constexpr int GPUTimeRow = 1;
+constexpr int FirstPassRow = 2;
+constexpr int FirstStageRow = FirstPassRow + static_cast<int>(graphics::RenderPassCount);
+constexpr int FirstCounterRow = FirstStageRow + static_cast<int>(graphics::RenderStageCount);
+constexpr int CounterCount = 5;
+constexpr int RowCount = FirstCounterRow + CounterCount;
+
+QString FormatMilliseconds(double value)
+{
+	return QString{"%1 ms"}.arg(value, 0, 'f', 3);
+}
+
+void SetCell(QTableWidget* table, int row, int column, const QString& text)
+{
+	auto item = table->item(row, column);
+
+	if (!item)
+	{
+		item = new QTableWidgetItem();
+		table->setItem(row, column, item);
+	}
+
+	item->setText(text);
+}
+}
+
+RenderStatisticsPanel::RenderStatisticsPanel(AssetManager* application)
+	: _application(application)
+	, _updateTimer(new QTimer(this))
+{
+	_ui.setupUi(this);
+
+	QStringList rowLabels{"CPU Frame", "GPU Frame"};
+
+	for (std::size_t i = 0; i < graphics::RenderPassCount; ++i)
+	{
+		rowLabels.append(QString{"%1 Pass"}.arg(graphics::RenderPassIndexToString(i)));
+	}
+
+	for (std::size_t i = 0; i < graphics::RenderStageCount; ++i)
+	{
+		rowLabels.append(graphics::RenderStageToString(static_cast<graphics::RenderStage>(i)));
+	}
+
+	rowLabels.append({"Draw Calls", "State Changes", "Texture Binds", "Polygons", "Culled Entities"});
+
+	_ui.Timings->setRowCount(RowCount);
+	_ui.Timings->setVerticalHeaderLabels(rowLabels);
+
+	_updateTimer->setInterval(UpdateIntervalMilliseconds);
+
+	connect(_updateTimer, &QTimer::timeout, this, &RenderStatisticsPanel::UpdateStatistics);
+	connect(_ui.Clear, &QPushButton::clicked, this, &RenderStatisticsPanel::OnClear);
+	connect(_ui.ExportCSV, &QPushButton::clicked, this, &RenderStatisticsPanel::OnExportCSV);
+}
+
+RenderStatisticsPanel::~RenderStatisticsPanel() = default;
+
+void RenderStatisticsPanel::OnVisibilityChanged(bool visible)
+{
+	// Only poll for new statistics while someone can see them.
+	if (visible)
+	{
+		UpdateStatistics();
+		_updateTimer->start();
+	}
+	else
+	{
+		_updateTimer->stop();
+	}
+}
+
+void RenderStatisticsPanel::UpdateStatistics()
+{
+	const auto history = _application->GetRenderStatistics();
+	const auto tickStatistics = _application->GetFrameScheduler()->GetStatistics();
+
+	_ui.Summary->setText(QString{"Tick time over %1 ticks: min %2, avg %3, p99 %4, max %5\nFrames drawn: %6"}
+		.arg(tickStatistics.FrameCount)
+		.arg(FormatMilliseconds(tickStatistics.Minimum))
+		.arg(FormatMilliseconds(tickStatistics.Average))
+		.arg(FormatMilliseconds(tickStatistics.Percentile99))
+		.arg(FormatMilliseconds(tickStatistics.Maximum))
+		.arg(history->GetTotalFrameCount()));
+
+	const std::size_t frameCount = history->GetFrameCount();
+
+	graphics::RenderFrameStatistics total;
+	double totalGPUTime = 0;
+	std::size_t gpuFrameCount = 0;
+	std::uint64_t totalPolygons = 0;
+	std::uint64_t totalCulledEntities = 0;
+
+	for (std::size_t i = 0; i < frameCount; ++i)
+	{
+		const auto& frame = history->GetFrame(i);
+
+		total.CPUTime += frame.CPUTime;
+
+		if (frame.GPUTime)
+		{
+			totalGPUTime += *frame.GPUTime;
+			++gpuFrameCount;
+		}
+
+		for (std::size_t pass = 0; pass < graphics::RenderPassCount; ++pass)
+		{
+			total.PassTimes[pass] += frame.PassTimes[pass];
+		}
+
+		for (std::size_t stage = 0; stage < graphics::RenderStageCount; ++stage)
+		{
+			total.Counters.StageTimes[stage] += frame.Counters.StageTimes[stage];
+		}
+
+		total.Counters.DrawCalls += frame.Counters.DrawCalls;
+		total.Counters.StateChanges += frame.Counters.StateChanges;
+		total.Counters.TextureBinds += frame.Counters.TextureBinds;
+		totalPolygons += frame.Polygons;
+		totalCulledEntities += frame.CulledEntities;
+	}
+
+	const graphics::RenderFrameStatistics last = frameCount > 0 ? history->GetFrame(frameCount - 1) : graphics::RenderFrameStatistics{};
+	const double divisor = static_cast<double>(std::max<std::size_t>(frameCount, 1));
+
+	const auto setTime = [&](int row, double lastValue, double totalValue)
+	{
+		SetCell(_ui.Timings, row, 0, FormatMilliseconds(lastValue));
+		SetCell(_ui.Timings, row, 1, FormatMilliseconds(totalValue / divisor));
+	};
+
+	const auto setCount = [&](int row, std::uint64_t lastValue, std::uint64_t totalValue)
+	{
+		SetCell(_ui.Timings, row, 0, QString::number(lastValue));
+		SetCell(_ui.Timings, row, 1, QString::number(totalValue / divisor, 'f', 1));
+	};
+
+	setTime(CPUTimeRow, last.CPUTime, total.CPUTime);
+
+	if (gpuFrameCount > 0)
+	{
+		SetCell(_ui.Timings, GPUTimeRow, 0, last.GPUTime ? FormatMilliseconds(*last.GPUTime) : QString{"-"});
+		SetCell(_ui.Timings, GPUTimeRow, 1, FormatMilliseconds(totalGPUTime / gpuFrameCount));
+	}
+	else
+	{
+		SetCell(_ui.Timings, GPUTimeRow, 0, "Not available");
+		SetCell(_ui.Timings, GPUTimeRow, 1, "Not available");
+	}
+
+	for (std::size_t pass = 0; pass < graphics::RenderPassCount; ++pass)
+	{
+		setTime(FirstPassRow + static_cast<int>(pass), last.PassTimes[pass], total.PassTimes[pass]);
+	}
+
+	for (std::size_t stage = 0; stage < graphics::RenderStageCount; ++stage)
+	{
+		setTime(FirstStageRow + static_cast<int>(stage), last.Counters.StageTimes[stage], total.Counters.StageTimes[stage]);
+	}
+
+	setCount(FirstCounterRow, last.Counters.DrawCalls, total.Counters.DrawCalls);
+	setCount(FirstCounterRow + 1, last.Counters.StateChanges, total.Counters.StateChanges);
+	setCount(FirstCounterRow + 2, last.Counters.TextureBinds, total.Counters.TextureBinds);
+	setCount(FirstCounterRow + 3, last.Polygons, totalPolygons);
+	setCount(FirstCounterRow + 4, last.CulledEntities, totalCulledEntities);
+
+	UpdateHistogram();
+}
+
+void RenderStatisticsPanel::UpdateHistogram()
+{
+	const auto histogram = _application->GetRenderStatistics()->GetHistogram();
+
+	const QSize size = _ui.Histogram->minimumSize();
+
+	QPixmap pixmap{size};
+	pixmap.fill(palette().color(QPalette::ColorRole::Base));
+
+	const std::size_t largestBucket = *std::max_element(histogram.begin(), histogram.end());
+
+	if (largestBucket > 0)
+	{
+		QPainter painter{&pixmap};
+
+		const int barWidth = size.width() / static_cast<int>(histogram.size());
+
+		for (std::size_t i = 0; i < histogram.size(); ++i)
+		{
+			const int barHeight = static_cast<int>(size.height() * histogram[i] / largestBucket);
+
+			painter.fillRect(static_cast<int>(i) * barWidth, size.height() - barHeight, std::max(1, barWidth - 1), barHeight,
+				palette().color(QPalette::ColorRole::Highlight));
+		}
+	}
+
+	_ui.Histogram->setPixmap(pixmap);
+}
+
+void RenderStatisticsPanel::OnClear()
+{
+	_application->GetRenderStatistics()->Clear();
+	_application->GetFrameScheduler()->ResetStatistics();
+
+	UpdateStatistics();
+}
+
+void RenderStatisticsPanel::OnExportCSV()
+{
+	const QString fileName = QFileDialog::getSaveFileName(
+		this, "Export Render Statistics", _application->GetPath(RenderStatisticsPathName), "CSV Files (*.csv);;All Files (*.*)");
+
+	if (fileName.isEmpty())
+	{
+		return;
+	}
+
+	_application->SetPath(RenderStatisticsPathName, fileName);
+
+	std::ostringstream stream;
+	_application->GetRenderStatistics()->WriteCSV(stream);
+
+	QFile file{fileName};
+
+	if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+	{
+		QMessageBox::critical(this, "Error", QString{"Could not open file \"%1\" for writing"}.arg(fileName));
+		return;
+	}
+
+	const std::string contents = stream.str();
+
+	file.write(contents.data(), static_cast<qint64>(contents.size()));
+}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ui_RenderStatisticsPanel.h"
+
+#include "ui/DockableWidget.hpp"
+
+class AssetManager;
+class QTimer;
+
+namespace studiomodel
+{
+/**
+*	@brief Shows frame times, per pass and per stage render timings and render counters.
+*/
+class RenderStatisticsPanel final : public DockableWidget
+{
+public:
+	explicit RenderStatisticsPanel(AssetManager* application);
+	~RenderStatisticsPanel();
+
+	void OnVisibilityChanged(bool visible) override;
+
+private:
+	void UpdateStatistics();
+
+	void UpdateHistogram();
+
+private slots:
+	void OnClear();
+
+	void OnExportCSV();
+
+private:
+	Ui_RenderStatisticsPanel _ui;
+	AssetManager* const _application;
+	QTimer* const _updateTimer;
+};
+}
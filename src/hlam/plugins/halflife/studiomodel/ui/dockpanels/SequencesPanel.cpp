@@ -20,7 +20,7 @@
 namespace studiomodel
 {
 SequencesPanel::SequencesPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -49,8 +49,6 @@ SequencesPanel::SequencesPanel(StudioModelAssetProvider* provider)
 		_ui.Activity->setCompleter(nullptr);
 	}
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &SequencesPanel::OnAssetChanged);
-
 	connect(_ui.Sequences, qOverload<int>(&QComboBox::currentIndexChanged), this, &SequencesPanel::OnSequenceChanged);
 	connect(_ui.LoopingMode, qOverload<int>(&QComboBox::currentIndexChanged), this, &SequencesPanel::OnLoopingModeChanged);
 
@@ -83,7 +81,7 @@ SequencesPanel::SequencesPanel(StudioModelAssetProvider* provider)
 
 	_ui.EventDataWidget->setEnabled(false);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 SequencesPanel::~SequencesPanel() = default;
@@ -8,8 +8,8 @@
 #include "entity/StudioModelEntity.hpp"
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 
-#include "ui/DockableWidget.hpp"
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 class StateSnapshot;
 
@@ -19,7 +19,7 @@ class StudioModelAsset;
 class StudioModelAssetProvider;
 class StudioModelData;
 
-class SequencesPanel final : public DockableWidget
+class SequencesPanel final : public StudioModelDockPanel
 {
 public:
 	explicit SequencesPanel(StudioModelAssetProvider* provider);
@@ -37,7 +37,7 @@ private:
 	void UpdateBlendValue(int blender, BlendUpdateSource source, QSlider* slider, QDoubleSpinBox* spinner);
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnLoadSnapshot(StateSnapshot* snapshot);
 
@@ -69,7 +69,6 @@ private slots:
 
 private:
 	Ui_SequencesPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
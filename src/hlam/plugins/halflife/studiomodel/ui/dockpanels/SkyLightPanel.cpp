@@ -26,7 +26,8 @@ SkyLightPanel::SkyLightPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Ambient, qOverload<int>(&QSpinBox::valueChanged), this, &SkyLightPanel::OnAmbientChanged);
 	connect(_ui.Shade, qOverload<int>(&QSpinBox::valueChanged), this, &SkyLightPanel::OnShadeChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	// This panel is created when the Lighting panel is first shown, which can be after an asset was loaded.
+	OnAssetChanged(_provider->GetCurrentAsset());
 }
 
 SkyLightPanel::~SkyLightPanel() = default;
@@ -0,0 +1,69 @@
+#include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
+
+namespace studiomodel
+{
+StudioModelDockPanel::StudioModelDockPanel(StudioModelAssetProvider* provider)
+	: _provider(provider)
+{
+	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &StudioModelDockPanel::OnProviderAssetChanged);
+}
+
+StudioModelDockPanel::~StudioModelDockPanel() = default;
+
+void StudioModelDockPanel::OnVisibilityChanged(bool visible)
+{
+	_visible = visible;
+
+	if (_visible)
+	{
+		if (const auto asset = _provider->GetCurrentAsset(); _shownAsset != asset)
+		{
+			ShowAsset(asset);
+		}
+
+		if (_pendingPick)
+		{
+			const auto result = *_pendingPick;
+			_pendingPick.reset();
+			OnObjectPicked(result);
+		}
+	}
+}
+
+void StudioModelDockPanel::SelectPickedObject(const studiomdl::PickResult& result)
+{
+	if (_visible && _shownAsset == _provider->GetCurrentAsset())
+	{
+		OnObjectPicked(result);
+	}
+	else
+	{
+		_pendingPick = result;
+	}
+}
+
+void StudioModelDockPanel::ShowAsset(StudioModelAsset* asset)
+{
+	_shownAsset = asset;
+	OnAssetChanged(asset);
+}
+
+void StudioModelDockPanel::OnProviderAssetChanged(StudioModelAsset* asset)
+{
+	// A pick that hasn't been applied yet refers to the previous asset.
+	_pendingPick.reset();
+
+	if (_visible)
+	{
+		ShowAsset(asset);
+		return;
+	}
+
+	// Defer the refresh until the panel is shown, but don't hold on to an asset that may be closed in the meantime.
+	if (const auto dummyAsset = _provider->GetDummyAsset(); _shownAsset != dummyAsset)
+	{
+		ShowAsset(dummyAsset);
+	}
+}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <optional>
+
+#include "formats/studiomodel/StudioModelPicker.hpp"
+
+#include "ui/DockableWidget.hpp"
+
+namespace studiomodel
+{
+class StudioModelAsset;
+class StudioModelAssetProvider;
+
+/**
+*	@brief Base class for dock panels that show the current studio model asset.
+*	Panels are only updated while visible. Hidden panels switch to the dummy asset so they never
+*	refer to an asset that has been closed, and are refreshed with the current asset once they are shown again.
+*/
+class StudioModelDockPanel : public DockableWidget
+{
+public:
+	explicit StudioModelDockPanel(StudioModelAssetProvider* provider);
+	~StudioModelDockPanel();
+
+	/**
+	*	@brief Derived classes that override this must call this first
+	*	so the panel shows the current asset before it responds to becoming visible.
+	*/
+	void OnVisibilityChanged(bool visible) override;
+
+	/**
+	*	@brief Selects the object the user picked in the viewport.
+	*	If the panel is hidden the pick is applied once the panel is shown with the current asset.
+	*/
+	void SelectPickedObject(const studiomdl::PickResult& result);
+
+protected:
+	/**
+	*	@brief Shows @p asset in the panel.
+	*	Derived classes should call this at the end of their constructor with the dummy asset.
+	*/
+	void ShowAsset(StudioModelAsset* asset);
+
+	/**
+	*	@brief Called by @ref ShowAsset to update the panel.
+	*/
+	virtual void OnAssetChanged(StudioModelAsset* asset) = 0;
+
+	/**
+	*	@brief Called by @ref SelectPickedObject while the panel shows the current asset.
+	*/
+	virtual void OnObjectPicked(const studiomdl::PickResult& result) {}
+
+private:
+	void OnProviderAssetChanged(StudioModelAsset* asset);
+
+protected:
+	StudioModelAssetProvider* const _provider;
+
+private:
+	StudioModelAsset* _shownAsset{};
+	bool _visible{false};
+
+	std::optional<studiomdl::PickResult> _pendingPick;
+};
+}
@@ -1,4 +1,8 @@
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -7,7 +11,10 @@
 #include <QImage>
 #include <QMessageBox>
 #include <QMetaEnum>
+#include <QProgressDialog>
 #include <QSignalBlocker>
+#include <QStringList>
+#include <QThreadPool>
 #include <QToolTip>
 
 #include "entity/HLMVStudioModelEntity.hpp"
@@ -36,6 +43,8 @@
 
 #include "ui/camera_operators/TextureCameraOperator.hpp"
 
+#include "utility/ThreadPool.hpp"
+
 namespace studiomodel
 {
 static constexpr double TextureViewScaleMinimum = 0.1;
@@ -45,8 +54,70 @@ static constexpr double TextureViewScaleSingleStepValue = 0.1;
 static constexpr double TextureViewScaleSliderRatio = 10.0;
 static constexpr double UVLineWidthSliderRatio = 10.0;
 
+static constexpr std::size_t MaximumTextureImportThreads = 16;
+
+static constexpr int ExportProgressDialogDelayMilliseconds = 500;
+static constexpr int ExportProgressUpdateIntervalMilliseconds = 50;
+
 const QString TextureExtension{QStringLiteral(".bmp")};
 
+/**
+*	@brief Runs export tasks on worker threads while showing a progress dialog.
+*	Each task returns the name of the file it failed to write, or an empty string on success.
+*	@return Files that could not be written, in task order
+*/
+static QStringList RunExportTasks(QWidget* parent, const QString& labelText, std::vector<std::function<QString()>>&& tasks)
+{
+	QProgressDialog dialog{labelText, "Cancel", 0, static_cast<int>(tasks.size()), parent};
+	dialog.setWindowModality(Qt::WindowModal);
+	dialog.setMinimumDuration(ExportProgressDialogDelayMilliseconds);
+
+	std::vector<QString> results(tasks.size());
+	std::atomic<int> completedCount{0};
+	std::atomic<bool> canceled{false};
+
+	QThreadPool threadPool;
+
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+	{
+		threadPool.start([&, i]
+			{
+				if (!canceled)
+				{
+					results[i] = tasks[i]();
+				}
+
+				++completedCount;
+			});
+	}
+
+	// Modal progress dialogs process events when their value changes, which keeps the UI responsive.
+	while (!threadPool.waitForDone(ExportProgressUpdateIntervalMilliseconds))
+	{
+		dialog.setValue(completedCount);
+
+		if (dialog.wasCanceled())
+		{
+			canceled = true;
+			threadPool.clear();
+		}
+	}
+
+	dialog.setValue(static_cast<int>(tasks.size()));
+
+	QStringList failures;
+
+	for (auto& result : results)
+	{
+		if (!result.isEmpty())
+		{
+			failures.append(std::move(result));
+		}
+	}
+
+	return failures;
+}
+
 static int GetMeshIndexForDrawing(QComboBox* comboBox)
 {
 	int meshIndex = comboBox->currentIndex();
@@ -60,7 +131,7 @@ static int GetMeshIndexForDrawing(QComboBox* comboBox)
 }
 
 TexturesPanel::TexturesPanel(StudioModelAssetProvider* provider)
-	: _provider(provider)
+	: StudioModelDockPanel(provider)
 {
 	_ui.setupUi(this);
 
@@ -81,8 +152,6 @@ TexturesPanel::TexturesPanel(StudioModelAssetProvider* provider)
 
 	connect(_ui.Textures, qOverload<int>(&QComboBox::currentIndexChanged), textureNameValidator, &UniqueTextureNameValidator::SetCurrentIndex);
 
-	connect(_provider, &StudioModelAssetProvider::AssetChanged, this, &TexturesPanel::OnAssetChanged);
-
 	connect(_ui.Textures, qOverload<int>(&QComboBox::currentIndexChanged), this, &TexturesPanel::OnTextureChanged);
 	connect(_ui.ScaleTextureViewSlider, &QSlider::valueChanged, this, &TexturesPanel::OnTextureViewScaleSliderChanged);
 	connect(_ui.ScaleTextureViewSpinner, qOverload<double>(&QDoubleSpinBox::valueChanged), this, &TexturesPanel::OnTextureViewScaleSpinnerChanged);
@@ -116,13 +185,15 @@ TexturesPanel::TexturesPanel(StudioModelAssetProvider* provider)
 	connect(_ui.TopColorSpinner, qOverload<int>(&QSpinBox::valueChanged), this, &TexturesPanel::OnTopColorSpinnerChanged);
 	connect(_ui.BottomColorSpinner, qOverload<int>(&QSpinBox::valueChanged), this, &TexturesPanel::OnBottomColorSpinnerChanged);
 
-	OnAssetChanged(_provider->GetDummyAsset());
+	ShowAsset(_provider->GetDummyAsset());
 }
 
 TexturesPanel::~TexturesPanel() = default;
 
 void TexturesPanel::OnVisibilityChanged(bool visible)
 {
+	StudioModelDockPanel::OnVisibilityChanged(visible);
+
 	if (_provider->GetStudioModelSettings()->ShouldActivateTextureViewWhenTexturesPanelOpened()
 		&& _provider->GetEditWidget()->isVisible())
 	{
@@ -191,6 +262,15 @@ void TexturesPanel::OnAssetChanged(StudioModelAsset* asset)
 				SetTextureFlagCheckBoxes(_ui, _asset->GetEditableStudioModel()->Textures[index]->Flags);
 			}
 		});
+
+	connect(modelData, &StudioModelData::TextureDataChanged, this, [this](int index)
+		{
+			if (index == _ui.Textures->currentIndex())
+			{
+				// Texture coordinates may have been rescaled.
+				_asset->GetTextureEntity()->SetMeshIndex(GetMeshIndexForDrawing(_ui.Meshes));
+			}
+		});
 }
 
 void TexturesPanel::OnSaveSnapshot(StateSnapshot* snapshot)
@@ -239,6 +319,14 @@ void TexturesPanel::OnLoadSnapshot(StateSnapshot* snapshot)
 	_updatingUI = false;
 }
 
+void TexturesPanel::OnObjectPicked(const studiomdl::PickResult& result)
+{
+	if (result.Type == studiomdl::PickType::Mesh && result.Texture != -1)
+	{
+		_ui.Textures->setCurrentIndex(result.Texture);
+	}
+}
+
 void TexturesPanel::OnScaleChanged(float adjust)
 {
 	_ui.ScaleTextureViewSpinner->setValue(_ui.ScaleTextureViewSpinner->value() + adjust);
@@ -430,14 +518,76 @@ void TexturesPanel::OnOverlayUVMapChanged()
 	_asset->GetTextureEntity()->OverlayUVMap = _ui.OverlayUVMap->isChecked();
 }
 
+struct TexturesPanel::TextureImport
+{
+	int TextureIndex{};
+	QString FileName;
+
+	QImage Image;
+	std::optional<QSize> RequiredSize;
+	bool Skip{false};
+
+	std::optional<std::tuple<studiomdl::StudioTextureData, bool, bool>> ConvertedTexture;
+};
+
 void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::EditableStudioModel& model, int textureIndex)
 {
-	QImage image{fileName};
+	std::vector<TextureImport> imports;
+	imports.push_back({textureIndex, fileName});
+
+	ImportTextures(imports, model);
+}
+
+void TexturesPanel::ImportTextures(std::vector<TextureImport>& imports, studiomdl::EditableStudioModel& model)
+{
+	// Large images are also split up between threads, so this is useful even for a single texture.
+	ThreadPool threadPool{ThreadPool::GetDefaultThreadCount(1, MaximumTextureImportThreads)};
+
+	threadPool.ParallelFor(imports.size(), [&](std::size_t index)
+		{
+			auto& import = imports[index];
+			import.Image = QImage{import.FileName};
+		});
 
-	if (image.isNull())
+	for (auto& import : imports)
 	{
-		QMessageBox::critical(this, "Error loading image", QString{"Failed to load image \"%1\"."}.arg(fileName));
-		return;
+		import.Skip = !ShouldImportTexture(import, model);
+	}
+
+	const bool dither = _provider->GetStudioModelSettings()->ShouldDitherImportedTextures();
+
+	threadPool.ParallelFor(imports.size(), [&](std::size_t index)
+		{
+			auto& import = imports[index];
+
+			if (import.Skip)
+			{
+				return;
+			}
+
+			graphics::ColorQuantizerOptions options;
+			options.Masked = (model.Textures[import.TextureIndex]->Flags & STUDIO_NF_MASKED) != 0;
+			options.Dither = dither;
+			options.Pool = &threadPool;
+
+			import.ConvertedTexture = ConvertImageToTexture(import.Image, import.RequiredSize, options);
+		});
+
+	for (auto& import : imports)
+	{
+		if (!import.Skip)
+		{
+			FinishTextureImport(import, model);
+		}
+	}
+}
+
+bool TexturesPanel::ShouldImportTexture(TextureImport& import, const studiomdl::EditableStudioModel& model)
+{
+	if (import.Image.isNull())
+	{
+		QMessageBox::critical(this, "Error loading image", QString{"Failed to load image \"%1\"."}.arg(import.FileName));
+		return false;
 	}
 
 	// For models with multiple skins we need to enforce the original texture dimensions
@@ -452,7 +602,7 @@ void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::Editab
 
 			for (std::size_t j = 0; j < model.SkinFamilies.size(); ++j)
 			{
-				if (textureIndex == model.SkinFamilies[j][i])
+				if (import.TextureIndex == model.SkinFamilies[j][i])
 				{
 					++count;
 				}
@@ -466,31 +616,34 @@ void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::Editab
 		}
 	}
 
-	auto& texture = *model.Textures[textureIndex];
-
-	std::optional<QSize> requiredSize;
+	const auto& texture = *model.Textures[import.TextureIndex];
 
 	if (!allowResizing)
 	{
-		requiredSize = QSize{ texture.Data.Width, texture.Data.Height };
+		import.RequiredSize = QSize{ texture.Data.Width, texture.Data.Height };
 
-		if (requiredSize != image.size())
+		if (import.RequiredSize != import.Image.size())
 		{
 			if (QMessageBox::question(
 				this, "Input required",
 				"This texture is used in only some skins and must match the original dimensions to ensure UV coordinates are compatible with other skins.\nRescale image?",
 				QMessageBox::Ok, QMessageBox::Cancel) != QMessageBox::Ok)
 			{
-				return;
+				return false;
 			}
 		}
 	}
 
-	auto convertedTexture = ConvertImageToTexture(image, requiredSize);
+	return true;
+}
+
+void TexturesPanel::FinishTextureImport(TextureImport& import, studiomdl::EditableStudioModel& model)
+{
+	auto& convertedTexture = import.ConvertedTexture;
 
 	if (!convertedTexture)
 	{
-		QMessageBox::critical(this, "Error loading image", QString{"Palette for image \"%1\" does not exist."}.arg(fileName));
+		QMessageBox::critical(this, "Error loading image", QString{"Palette for image \"%1\" does not exist."}.arg(import.FileName));
 		return;
 	}
 
@@ -503,14 +656,16 @@ void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::Editab
 	{
 		QMessageBox::warning(this, "Warning",
 			QString{"Image \"%1\" has the format \"%2\" and will be converted to an indexed 8 bit image. Loss of color depth may occur."}
-			.arg(fileName)
-			.arg(QMetaEnum::fromType<QImage::Format>().valueToKey(image.format())));
+			.arg(import.FileName)
+			.arg(QMetaEnum::fromType<QImage::Format>().valueToKey(import.Image.format())));
 	}
 
+	auto& texture = *model.Textures[import.TextureIndex];
+
 	auto& textureData = std::get<0>(convertedTexture.value());
 
 	auto scaledSTCoordinates = studiomdl::CalculateScaledSTCoordinatesData(
-		model, textureIndex, texture.Data.Width, texture.Data.Height, textureData.Width, textureData.Height);
+		model, import.TextureIndex, texture.Data.Width, texture.Data.Height, textureData.Width, textureData.Height);
 
 	ImportTextureData oldTexture;
 	ImportTextureData newTexture;
@@ -518,10 +673,10 @@ void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::Editab
 	oldTexture.Data = texture.Data;
 	oldTexture.ScaledSTCoordinates = std::move(scaledSTCoordinates.first);
 
-	newTexture.Data = textureData;
+	newTexture.Data = std::move(textureData);
 	newTexture.ScaledSTCoordinates = std::move(scaledSTCoordinates.second);
 
-	_asset->AddUndoCommand(new ImportTextureCommand(_asset, textureIndex, std::move(oldTexture), std::move(newTexture)));
+	_asset->AddUndoCommand(new ImportTextureCommand(_asset, import.TextureIndex, oldTexture, newTexture));
 }
 
 void TexturesPanel::UpdateColormapValue()
@@ -643,22 +798,30 @@ void TexturesPanel::OnExportUVMap()
 	if (ExportUVMeshDialog dialog{_asset, *entity, textureIndex, GetMeshIndexForDrawing(_ui.Meshes), textureImage, this};
 		QDialog::DialogCode::Accepted == dialog.exec())
 	{
-		//Redraw the final image with a transparent background
+		const QString fileName{dialog.GetFileName()};
 		const auto uvMapImage = dialog.GetUVImage();
+		const bool overlayOnTexture = dialog.ShouldOverlayOnTexture();
+		const bool addAlphaChannel = dialog.ShouldAddAlphaChannel();
 
-		QImage resultImage{uvMapImage.width(), uvMapImage.height(), QImage::Format::Format_RGBA8888};
+		std::vector<std::function<QString()>> tasks;
 
-		//Set as transparent
-		DrawUVImage(Qt::transparent, true, dialog.ShouldOverlayOnTexture(), textureImage, uvMapImage, resultImage);
+		tasks.push_back([&]
+			{
+				//Redraw the final image with a transparent background
+				QImage resultImage{uvMapImage.width(), uvMapImage.height(), QImage::Format::Format_RGBA8888};
 
-		if (!dialog.ShouldAddAlphaChannel())
-		{
-			resultImage.convertTo(QImage::Format::Format_RGB888);
-		}
+				//Set as transparent
+				DrawUVImage(Qt::transparent, true, overlayOnTexture, textureImage, uvMapImage, resultImage);
 
-		const QString fileName{dialog.GetFileName()};
+				if (!addAlphaChannel)
+				{
+					resultImage.convertTo(QImage::Format::Format_RGB888);
+				}
+
+				return resultImage.save(fileName) ? QString{} : fileName;
+			});
 
-		if (!resultImage.save(fileName))
+		if (!RunExportTasks(this, "Exporting UV map...", std::move(tasks)).isEmpty())
 		{
 			QMessageBox::critical(this, "Error", QString{"Failed to save image \"%1\""}.arg(fileName));
 		}
@@ -686,6 +849,8 @@ void TexturesPanel::OnImportAllTextures()
 
 	//For each texture in the model, find if there is a file with the same name in the given directory
 	//If so, try to replace the texture
+	std::vector<TextureImport> imports;
+
 	for (int i = 0; i < model->Textures.size(); ++i)
 	{
 		auto& texture = *model->Textures[i];
@@ -694,10 +859,12 @@ void TexturesPanel::OnImportAllTextures()
 
 		if (fileName.exists())
 		{
-			ImportTextureFrom(fileName.absoluteFilePath(), *model, i);
+			imports.push_back({i, fileName.absoluteFilePath()});
 		}
 	}
 
+	ImportTextures(imports, *model);
+
 	_asset->GetUndoStack()->endMacro();
 }
 
@@ -716,7 +883,9 @@ void TexturesPanel::OnExportAllTextures()
 
 	auto model = _asset->GetEntity()->GetEditableModel();
 
-	QString errors;
+	std::vector<std::function<QString()>> tasks;
+
+	tasks.reserve(model->Textures.size());
 
 	for (int i = 0; i < model->Textures.size(); ++i)
 	{
@@ -724,18 +893,27 @@ void TexturesPanel::OnExportAllTextures()
 
 		const QFileInfo fileName{path, QString::fromStdString(texture.Name)};
 
-		auto fullPath = fileName.absoluteFilePath();
+		// Each task converts and writes its texture independently, so encoding and file writes of different textures overlap.
+		// The model can be reloaded while the progress dialog is open, so tasks work on a copy of the texture data.
+		tasks.push_back([fullPath = fileName.absoluteFilePath(), data = texture.Data]
+			{
+				const auto textureImage = ConvertTextureToIndexed8Image(data);
+
+				return textureImage.save(fullPath) ? QString{} : fullPath;
+			});
+	}
+
+	const QStringList failures = RunExportTasks(this, "Exporting textures...", std::move(tasks));
 
-		auto textureImage = ConvertTextureToIndexed8Image(texture.Data);
+	if (!failures.isEmpty())
+	{
+		QString errors;
 
-		if (!textureImage.save(fullPath))
+		for (const auto& fullPath : failures)
 		{
 			errors += QString{"\"%1\"\n"}.arg(fullPath);
 		}
-	}
 
-	if (!errors.isEmpty())
-	{
 		QMessageBox::warning(this, "One or more errors occurred", QString{"Failed to save images:\n%1"}.arg( errors));
 	}
 }
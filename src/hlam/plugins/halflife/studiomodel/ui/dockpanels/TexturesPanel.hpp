@@ -1,14 +1,17 @@
 #pragma once
 
+#include <vector>
+
 #include <QString>
 
 #include "ui_TexturesPanel.h"
 
-#include "ui/DockableWidget.hpp"
+#include "plugins/halflife/studiomodel/ui/dockpanels/StudioModelDockPanel.hpp"
 
 namespace studiomdl
 {
 class EditableStudioModel;
+struct PickResult;
 }
 
 class StateSnapshot;
@@ -21,7 +24,7 @@ class StudioModelData;
 
 const inline QString TexturePathName{QStringLiteral("TexturePath")};
 
-class TexturesPanel final : public DockableWidget
+class TexturesPanel final : public StudioModelDockPanel
 {
 	Q_OBJECT
 
@@ -33,16 +36,28 @@ public:
 
 private:
 	void SetTextureName(bool updateTextures);
+	struct TextureImport;
+
 	void ImportTextureFrom(const QString& fileName, studiomdl::EditableStudioModel& model, int textureIndex);
+
+	/**
+	*	@brief Loads and converts images on worker threads, then adds an undo command for each successfully imported texture.
+	*	User prompts are shown on the calling thread.
+	*/
+	void ImportTextures(std::vector<TextureImport>& imports, studiomdl::EditableStudioModel& model);
+	bool ShouldImportTexture(TextureImport& import, const studiomdl::EditableStudioModel& model);
+	void FinishTextureImport(TextureImport& import, studiomdl::EditableStudioModel& model);
 	void UpdateColormapValue();
 	void UpdateUVMapProperties();
 
 private slots:
-	void OnAssetChanged(StudioModelAsset* asset);
+	void OnAssetChanged(StudioModelAsset* asset) override;
 
 	void OnSaveSnapshot(StateSnapshot* snapshot);
 	void OnLoadSnapshot(StateSnapshot* snapshot);
 
+	void OnObjectPicked(const studiomdl::PickResult& result) override;
+
 	void OnScaleChanged(float adjust);
 
 	void OnTextureChanged(int index);
@@ -76,7 +91,6 @@ private slots:
 
 private:
 	Ui_TexturesPanel _ui;
-	StudioModelAssetProvider* const _provider;
 	StudioModelAsset* _asset{};
 	StudioModelData* _previousModelData{};
 
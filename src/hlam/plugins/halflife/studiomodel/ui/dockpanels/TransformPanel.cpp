@@ -59,7 +59,7 @@ void TransformPanel::OnApply()
 	{
 		auto data{studiomdl::GetRotateData(*asset->GetEntity()->GetEditableModel())};
 
-		asset->AddUndoCommand(new ChangeModelRotationCommand(asset, std::move(data), _ui.RotateValues->GetValue()));
+		asset->AddUndoCommand(new ChangeModelRotationCommand(asset, data, _ui.RotateValues->GetValue()));
 		break;
 	}
 
@@ -102,7 +102,7 @@ void TransformPanel::OnApply()
 		auto data{studiomdl::CalculateScaleData(*entity->GetEditableModel(), flags)};
 
 		asset->AddUndoCommand(new ChangeModelScaleCommand(asset,
-			std::move(data), static_cast<float>(_ui.ScaleValue->value())));
+			data, static_cast<float>(_ui.ScaleValue->value())));
 
 		break;
 	}
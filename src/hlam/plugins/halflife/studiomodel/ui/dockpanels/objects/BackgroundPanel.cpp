@@ -21,6 +21,8 @@ BackgroundPanel::BackgroundPanel(StudioModelAssetProvider* provider)
 
 	connect(_ui.BackgroundTexture, &QLineEdit::textChanged, this, &BackgroundPanel::OnTextureChanged);
 	connect(_ui.BrowseBackgroundTexture, &QPushButton::clicked, this, &BackgroundPanel::OnBrowseTexture);
+
+	OnAssetChanged(_provider->GetCurrentAsset());
 }
 
 void BackgroundPanel::OnAssetChanged(StudioModelAsset* asset)
@@ -29,6 +29,8 @@ GroundPanel::GroundPanel(StudioModelAssetProvider* provider)
 	connect(_ui.BrowseGroundTexture, &QPushButton::clicked, this, &GroundPanel::OnBrowseTexture);
 
 	connect(_ui.GroundOrigin, &qt::widgets::ShortVector3Edit::ValueChanged, this, &GroundPanel::OnOriginChanged);
+
+	OnAssetChanged(_provider->GetCurrentAsset());
 }
 
 void GroundPanel::OnAssetChanged(StudioModelAsset* asset)
@@ -17,6 +17,8 @@ ModelPanel::ModelPanel(StudioModelAssetProvider* provider)
 	connect(_ui.Origin, &qt::widgets::ShortVector3Edit::ValueChanged, this, &ModelPanel::OnOriginChanged);
 	connect(_ui.CenterOnWorldOrigin, &QPushButton::clicked, this, &ModelPanel::OnCenterOnWorldOrigin);
 	connect(_ui.AlignOnGround, &QPushButton::clicked, this, &ModelPanel::OnAlignOnGround);
+
+	OnAssetChanged(_provider->GetCurrentAsset());
 }
 
 void ModelPanel::OnAssetChanged(StudioModelAsset* asset)
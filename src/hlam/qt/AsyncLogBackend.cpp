@@ -0,0 +1,149 @@
+#include <QDebug>
+
+#include "qt/AsyncLogBackend.hpp"
+#include "qt/QtLogSink.hpp"
+
+AsyncLogBackend::AsyncLogBackend(const AsyncLogOptions& options)
+	: _options(options)
+	, _queue(options.QueueDepth)
+{
+	_thread = std::thread{&AsyncLogBackend::Run, this};
+}
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+	_quit = true;
+
+	_wakeCount.fetch_add(1);
+	_wakeCount.notify_one();
+
+	_thread.join();
+}
+
+void AsyncLogBackend::Enqueue(const QLoggingCategory& category, const spdlog::details::log_msg& msg)
+{
+	// Checked here so disabled categories cost nothing beyond formatting.
+	if (!IsQtLogLevelEnabled(category, msg.level))
+	{
+		return;
+	}
+
+	const auto fill = [&](Record& record)
+	{
+		record.Category = &category;
+		record.Level = msg.level;
+		record.FileName = msg.source.filename;
+		record.Line = msg.source.line;
+		record.FunctionName = msg.source.funcname;
+		record.Payload.assign(msg.payload.data(), msg.payload.size());
+	};
+
+	while (!_queue.TryPush(fill))
+	{
+		if (_options.OverflowPolicy == LogOverflowPolicy::Drop)
+		{
+			_droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// Logging from inside a message handler; the consumer can't make room while it's waiting for itself.
+		if (std::this_thread::get_id() == _thread.get_id())
+		{
+			WriteQtLogMessage(category, msg.level, msg.source.filename, msg.source.line, msg.source.funcname,
+				std::string_view{msg.payload.data(), msg.payload.size()});
+			return;
+		}
+
+		WakeConsumer();
+		std::this_thread::yield();
+	}
+
+	_pushedCount.fetch_add(1);
+
+	WakeConsumer();
+}
+
+void AsyncLogBackend::Flush()
+{
+	if (std::this_thread::get_id() == _thread.get_id())
+	{
+		// Logging from inside a message handler; waiting would deadlock.
+		return;
+	}
+
+	const std::uint64_t target = _pushedCount.load();
+
+	for (std::uint64_t written = _writtenCount.load(); written < target; written = _writtenCount.load())
+	{
+		WakeConsumer();
+		_writtenCount.wait(written);
+	}
+}
+
+void AsyncLogBackend::Run()
+{
+	const auto write = [](Record& record)
+	{
+		WriteQtLogMessage(*record.Category, record.Level, record.FileName, record.Line, record.FunctionName, record.Payload);
+
+		// Keep the preallocated capacity, but don't hold on to memory used by unusually large messages.
+		if (record.Payload.capacity() > PreallocatedMessageSize * 16)
+		{
+			record.Payload = std::string{};
+			record.Payload.reserve(PreallocatedMessageSize);
+		}
+	};
+
+	for (;;)
+	{
+		bool wroteMessages = false;
+
+		while (_queue.TryPop(write))
+		{
+			_writtenCount.fetch_add(1);
+			wroteMessages = true;
+		}
+
+		if (wroteMessages)
+		{
+			_writtenCount.notify_all();
+		}
+
+		ReportDroppedMessages();
+
+		// Producers check this flag after publishing a message, so either they see it and change the wake count,
+		// or we see their message in the count below and don't go to sleep.
+		_consumerWaiting = true;
+
+		const std::uint32_t wakeCount = _wakeCount.load();
+
+		if (_pushedCount.load() == _writtenCount.load())
+		{
+			if (_quit)
+			{
+				break;
+			}
+
+			_wakeCount.wait(wakeCount);
+		}
+
+		_consumerWaiting = false;
+	}
+}
+
+void AsyncLogBackend::WakeConsumer()
+{
+	if (_consumerWaiting.load())
+	{
+		_wakeCount.fetch_add(1);
+		_wakeCount.notify_one();
+	}
+}
+
+void AsyncLogBackend::ReportDroppedMessages()
+{
+	if (const auto droppedCount = _droppedCount.exchange(0, std::memory_order_relaxed); droppedCount > 0)
+	{
+		qWarning() << droppedCount << "log messages were discarded because the log queue was full";
+	}
+}
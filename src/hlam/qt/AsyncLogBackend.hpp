@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <QLoggingCategory>
+
+#include <spdlog/sinks/base_sink.h>
+
+#include "utility/BoundedMPSCQueue.hpp"
+
+enum class LogOverflowPolicy
+{
+	/**
+	*	@brief Discard messages logged while the queue is full. The number of discarded messages is reported later.
+	*/
+	Drop = 0,
+
+	/**
+	*	@brief Wait until the consumer has made room. No messages are lost, but logging threads can stall.
+	*	Messages logged on the log thread itself are written immediately instead.
+	*/
+	Block
+};
+
+struct AsyncLogOptions
+{
+	static constexpr std::size_t DefaultQueueDepth = 8192;
+
+	/**
+	*	@brief Maximum number of messages waiting to be written. Rounded up to a power of 2.
+	*/
+	std::size_t QueueDepth = DefaultQueueDepth;
+
+	LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Drop;
+};
+
+/**
+*	@brief Writes log messages to Qt's logging system, and through it to the log file, on a dedicated thread.
+*	Logging threads copy the formatted message into a preallocated queue slot without taking any locks.
+*/
+class AsyncLogBackend final
+{
+public:
+	/**
+	*	@brief Messages up to this size are copied without allocating memory.
+	*/
+	static constexpr std::size_t PreallocatedMessageSize = 256;
+
+	explicit AsyncLogBackend(const AsyncLogOptions& options);
+
+	/**
+	*	@brief Writes all queued messages before returning.
+	*/
+	~AsyncLogBackend();
+
+	AsyncLogBackend(const AsyncLogBackend&) = delete;
+	AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+	/**
+	*	@brief Gets the backend used by newly created loggers, if asynchronous logging is enabled.
+	*/
+	static std::shared_ptr<AsyncLogBackend> GetInstance() { return _instance; }
+
+	static void SetInstance(std::shared_ptr<AsyncLogBackend> instance)
+	{
+		_instance = std::move(instance);
+	}
+
+	const AsyncLogOptions& GetOptions() const { return _options; }
+
+	/**
+	*	@brief Queues a message. Safe to call from any thread.
+	*/
+	void Enqueue(const QLoggingCategory& category, const spdlog::details::log_msg& msg);
+
+	/**
+	*	@brief Waits until all messages queued before this call have been written.
+	*/
+	void Flush();
+
+private:
+	struct Record
+	{
+		Record()
+		{
+			Payload.reserve(PreallocatedMessageSize);
+		}
+
+		const QLoggingCategory* Category{};
+		spdlog::level::level_enum Level{};
+		const char* FileName{};
+		int Line{};
+		const char* FunctionName{};
+		std::string Payload;
+	};
+
+	void Run();
+
+	void WakeConsumer();
+
+	void ReportDroppedMessages();
+
+private:
+	static inline std::shared_ptr<AsyncLogBackend> _instance;
+
+	const AsyncLogOptions _options;
+
+	BoundedMPSCQueue<Record> _queue;
+
+	std::atomic<std::uint64_t> _pushedCount{0};
+	std::atomic<std::uint64_t> _writtenCount{0};
+	std::atomic<std::uint64_t> _droppedCount{0};
+
+	/**
+	*	@brief Changed to wake the consumer thread when it is waiting for messages.
+	*/
+	std::atomic<std::uint32_t> _wakeCount{0};
+	std::atomic<bool> _consumerWaiting{false};
+	std::atomic<bool> _quit{false};
+
+	std::thread _thread;
+};
+
+/**
+*	@brief spdlog sink that hands messages to an AsyncLogBackend. Does not need a mutex since the backend's queue is lock-free.
+*/
+class AsyncQtLogSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+{
+public:
+	AsyncQtLogSink(std::shared_ptr<AsyncLogBackend> backend, const QLoggingCategory& category)
+		: _backend(std::move(backend))
+		, _category(category)
+	{
+		this->set_level(spdlog::level::trace);
+	}
+
+protected:
+	void sink_it_(const spdlog::details::log_msg& msg) override
+	{
+		_backend->Enqueue(_category, msg);
+	}
+
+	void flush_() override
+	{
+		_backend->Flush();
+	}
+
+private:
+	const std::shared_ptr<AsyncLogBackend> _backend;
+	const QLoggingCategory& _category;
+};
@@ -2,6 +2,7 @@
 
 #include <limits>
 #include <memory>
+#include <string_view>
 
 #include <QDebug>
 #include <QLoggingCategory>
@@ -9,6 +10,63 @@
 
 #include <spdlog/sinks/base_sink.h>
 
+inline bool IsQtLogLevelEnabled(const QLoggingCategory& category, spdlog::level::level_enum level)
+{
+	switch (level)
+	{
+	case spdlog::level::trace:
+		[[fallthrough]];
+	case spdlog::level::debug: return category.isDebugEnabled();
+	case spdlog::level::info: return category.isInfoEnabled();
+	case spdlog::level::warn: return category.isWarningEnabled();
+	case spdlog::level::err:
+		[[fallthrough]];
+	case spdlog::level::critical: return category.isCriticalEnabled();
+	}
+
+	return false;
+}
+
+/**
+*	@brief Passes a message to Qt's logging system.
+*	@param fileName, functionName Must remain valid while the message is being handled, as with QMessageLogContext.
+*/
+inline void WriteQtLogMessage(const QLoggingCategory& category, spdlog::level::level_enum level,
+	const char* fileName, int line, const char* functionName, std::string_view payload)
+{
+	//Truncate payload if it's too large
+	int payloadSize = std::numeric_limits<int>::max();
+
+	if (payload.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()))
+	{
+		payloadSize = static_cast<int>(payload.size());
+	}
+
+	QMessageLogger logger{fileName, line, functionName, category.categoryName()};
+
+	auto debug = [&]
+	{
+		switch (level)
+		{
+		case spdlog::level::trace:
+			[[fallthrough]];
+		case spdlog::level::debug: return logger.debug();
+		case spdlog::level::info: return logger.info();
+		case spdlog::level::warn: return  logger.warning();
+		default:
+			[[fallthrough]];
+		case spdlog::level::err:
+			[[fallthrough]];
+		case spdlog::level::critical: return logger.critical();
+		}
+	}();
+
+	debug.nospace().noquote();
+
+	//This allocates memory, but there is no API for logging UTF8 directly so this will have to do
+	debug << QString::fromUtf8(payload.data(), payloadSize);
+}
+
 /**
 *	@brief spdlog sink that forward messages to Qt's logging system
 */
@@ -25,27 +83,13 @@ public:
 protected:
 	void sink_it_(const spdlog::details::log_msg& msg) override
 	{
-		if (!IsLevelEnabled(msg.level))
+		if (!IsQtLogLevelEnabled(_category, msg.level))
 		{
 			return;
 		}
 
-		//Truncate payload if it's too large
-		int payloadSize = std::numeric_limits<int>::max();
-
-		if (msg.payload.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()))
-		{
-			payloadSize = static_cast<int>(msg.payload.size());
-		}
-
-		QMessageLogger logger{msg.source.filename, msg.source.line, msg.source.funcname, _category.categoryName()};
-
-		auto debug = GetLogger(msg.level, logger);
-
-		debug.nospace().noquote();
-
-		//This allocates memory, but there is no API for logging UTF8 directly so this will have to do
-		debug << QString::fromUtf8(msg.payload.data(), payloadSize);
+		WriteQtLogMessage(_category, msg.level, msg.source.filename, msg.source.line, msg.source.funcname,
+			std::string_view{msg.payload.data(), msg.payload.size()});
 	}
 
 	void flush_() override
@@ -53,41 +97,6 @@ protected:
 		//Nothing
 	}
 
-private:
-	bool IsLevelEnabled(spdlog::level_t level) const
-	{
-		switch (level)
-		{
-		case spdlog::level::trace:
-			[[fallthrough]];
-		case spdlog::level::debug: return _category.isDebugEnabled();
-		case spdlog::level::info: return _category.isInfoEnabled();
-		case spdlog::level::warn: return _category.isWarningEnabled();
-		case spdlog::level::err:
-			[[fallthrough]];
-		case spdlog::level::critical: return _category.isCriticalEnabled();
-		}
-
-		return false;
-	}
-
-	static QDebug GetLogger(spdlog::level_t level, const QMessageLogger& logger)
-	{
-		switch (level)
-		{
-		case spdlog::level::trace:
-			[[fallthrough]];
-		case spdlog::level::debug: return logger.debug();
-		case spdlog::level::info: return logger.info();
-		case spdlog::level::warn: return  logger.warning();
-		default:
-			[[fallthrough]];
-		case spdlog::level::err:
-			[[fallthrough]];
-		case spdlog::level::critical: return logger.critical();
-		}
-	}
-
 private:
 	const QLoggingCategory& _category;
 };
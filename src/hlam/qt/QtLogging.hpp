@@ -9,11 +9,25 @@
 #include <spdlog/logger.h>
 #include <spdlog/fmt/fmt.h>
 
+#include "qt/AsyncLogBackend.hpp"
 #include "qt/QtLogSink.hpp"
 
+/**
+*	@brief Creates a logger that forwards messages to Qt's logging system.
+*	If asynchronous logging is enabled messages are written on the log thread, otherwise on the thread that logs them.
+*/
 inline std::shared_ptr<spdlog::logger> CreateQtLoggerSt(const QLoggingCategory& category)
 {
-	auto sink = std::make_shared<QtLogSink<spdlog::details::null_mutex>>(category);
+	spdlog::sink_ptr sink;
+
+	if (auto backend = AsyncLogBackend::GetInstance(); backend)
+	{
+		sink = std::make_shared<AsyncQtLogSink>(std::move(backend), category);
+	}
+	else
+	{
+		sink = std::make_shared<QtLogSink<spdlog::details::null_mutex>>(category);
+	}
 
 	auto logger = std::make_shared<spdlog::logger>(category.categoryName(), std::move(sink));
 
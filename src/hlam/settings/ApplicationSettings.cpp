@@ -68,6 +68,7 @@ void ApplicationSettings::LoadSettings()
 	PauseAnimationsOnTimelineClick = _settings->value("PauseAnimationsOnTimelineClick", DefaultPauseAnimationsOnTimelineClick).toBool();
 	OneAssetAtATime = _settings->value("OneAssetAtATime", DefaultOneAssetAtATime).toBool();
 	_tickRate = std::clamp(_settings->value("TickRate", DefaultTickRate).toInt(), MinimumTickRate, MaximumTickRate);
+	FixedTimeStep = _settings->value("FixedTimeStep", DefaultFixedTimeStep).toBool();
 	_settings->endGroup();
 
 	_settings->beginGroup("Mouse");
@@ -129,6 +130,7 @@ void ApplicationSettings::SaveSettings()
 	_settings->setValue("PauseAnimationsOnTimelineClick", PauseAnimationsOnTimelineClick);
 	_settings->setValue("OneAssetAtATime", OneAssetAtATime);
 	_settings->setValue("TickRate", _tickRate);
+	_settings->setValue("FixedTimeStep", FixedTimeStep);
 	_settings->endGroup();
 
 	_settings->beginGroup("Mouse");
@@ -192,6 +194,20 @@ void ApplicationSettings::SetEnableVSync(bool value)
 	}
 }
 
+bool ApplicationSettings::ShouldRenderContinuously() const
+{
+	return _settings->value("Video/ContinuousRendering", DefaultContinuousRendering).toBool();
+}
+
+void ApplicationSettings::SetRenderContinuously(bool value)
+{
+	if (ShouldRenderContinuously() != value)
+	{
+		_settings->setValue("Video/ContinuousRendering", value);
+		emit ContinuousRenderingChanged(value);
+	}
+}
+
 QString ApplicationSettings::GetSavedPath(const QString& pathName)
 {
 	_settings->beginGroup("Paths");
@@ -243,3 +259,13 @@ void ApplicationSettings::SetFileListRootDirectory(const QString& directory)
 {
 	_settings->setValue("FileList/RootDirectory", directory);
 }
+
+bool ApplicationSettings::ShouldShowFileListThumbnails() const
+{
+	return _settings->value("FileList/ShowThumbnails", false).toBool();
+}
+
+void ApplicationSettings::SetShowFileListThumbnails(bool value)
+{
+	_settings->setValue("FileList/ShowThumbnails", value);
+}
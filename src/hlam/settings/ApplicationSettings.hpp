@@ -32,6 +32,7 @@ public:
 	static constexpr int DefaultTickRate{60};
 	static constexpr int MinimumTickRate{1};
 	static constexpr int MaximumTickRate{1000};
+	static constexpr bool DefaultFixedTimeStep{false};
 
 	static constexpr int DefaultMouseSensitivity{5};
 	static constexpr int MinimumMouseSensitivity{1};
@@ -47,6 +48,7 @@ public:
 	static constexpr bool DefaultFramerateAffectsPitch{false};
 
 	static constexpr bool DefaultEnableVSync{true};
+	static constexpr bool DefaultContinuousRendering{false};
 	static constexpr bool DefaultPowerOf2Textures{false};
 
 	static constexpr int DefaultMSAALevel{0};
@@ -142,6 +144,12 @@ public:
 	bool ShouldEnableVSync() const;
 	void SetEnableVSync(bool value);
 
+	/**
+	*	@brief Whether the scene is redrawn every frame instead of only when something has changed.
+	*/
+	bool ShouldRenderContinuously() const;
+	void SetRenderContinuously(bool value);
+
 	bool ShouldResizeTexturesToPowerOf2() const { return _powerOf2Textures; }
 
 	void SetResizeTexturesToPowerOf2(bool value)
@@ -204,6 +212,9 @@ public:
 	QString GetFileListRootDirectory() const;
 	void SetFileListRootDirectory(const QString& directory);
 
+	bool ShouldShowFileListThumbnails() const;
+	void SetShowFileListThumbnails(bool value);
+
 signals:
 	void SettingsLoaded();
 	void SettingsSaved();
@@ -217,6 +228,8 @@ signals:
 
 	void SceneWidgetSettingsChanged();
 
+	void ContinuousRenderingChanged(bool value);
+
 	void StylePathChanged(const QString& stylePath);
 
 private slots:
@@ -225,6 +238,7 @@ private slots:
 public:
 	bool PauseAnimationsOnTimelineClick{DefaultPauseAnimationsOnTimelineClick};
 	bool OneAssetAtATime{DefaultOneAssetAtATime};
+	bool FixedTimeStep{DefaultFixedTimeStep};
 	bool TransparentScreenshots{DefaultTransparentScreenshots};
 
 private:
@@ -0,0 +1,55 @@
+#include <utility>
+
+#include <QVBoxLayout>
+
+#include "ui/LazyDockableWidget.hpp"
+
+LazyDockableWidget::LazyDockableWidget(Factory factory, QWidget* parent)
+	: _factory(std::move(factory))
+{
+	setParent(parent);
+
+	auto layout = new QVBoxLayout(this);
+	layout->setContentsMargins(0, 0, 0, 0);
+}
+
+LazyDockableWidget::~LazyDockableWidget() = default;
+
+DockableWidget* LazyDockableWidget::GetOrCreateWidget()
+{
+	if (!_widget)
+	{
+		_widget = _factory();
+		_factory = {};
+
+		layout()->addWidget(_widget);
+
+		if (_direction)
+		{
+			_widget->OnLayoutDirectionChanged(*_direction);
+		}
+	}
+
+	return _widget;
+}
+
+void LazyDockableWidget::OnLayoutDirectionChanged(QBoxLayout::Direction direction)
+{
+	// Our own layout only ever holds the one widget, so only the widget needs to change.
+	_direction = direction;
+
+	if (_widget)
+	{
+		_widget->OnLayoutDirectionChanged(direction);
+	}
+}
+
+void LazyDockableWidget::OnVisibilityChanged(bool visible)
+{
+	if (!_widget && !visible)
+	{
+		return;
+	}
+
+	GetOrCreateWidget()->OnVisibilityChanged(visible);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include <QBoxLayout>
+
+#include "ui/DockableWidget.hpp"
+
+/**
+*	@brief Placeholder that creates the actual dockable widget the first time it becomes visible.
+*	Layout direction and visibility changes are forwarded to the created widget.
+*/
+class LazyDockableWidget final : public DockableWidget
+{
+public:
+	using Factory = std::function<DockableWidget*()>;
+
+	explicit LazyDockableWidget(Factory factory, QWidget* parent = nullptr);
+	~LazyDockableWidget();
+
+	/**
+	*	@brief Gets the created widget, or @c nullptr if it has not been shown yet.
+	*/
+	DockableWidget* GetWidget() const { return _widget; }
+
+	/**
+	*	@brief Gets the widget, creating it first if it has not been shown yet.
+	*/
+	DockableWidget* GetOrCreateWidget();
+
+	void OnLayoutDirectionChanged(QBoxLayout::Direction direction) override;
+
+	void OnVisibilityChanged(bool visible) override;
+
+private:
+	Factory _factory;
+	DockableWidget* _widget{};
+
+	std::optional<QBoxLayout::Direction> _direction;
+};
@@ -247,6 +247,9 @@ MainWindow::MainWindow(AssetManager* application)
 	connect(_ui.ActionWaitForVerticalSync, &QAction::toggled,
 		_application->GetApplicationSettings(), &ApplicationSettings::SetEnableVSync);
 
+	connect(_ui.ActionContinuousRendering, &QAction::toggled,
+		_application->GetApplicationSettings(), &ApplicationSettings::SetRenderContinuously);
+
 	connect(_ui.ActionMinPoint, &QAction::triggered, this, &MainWindow::OnTextureFiltersChanged);
 	connect(_ui.ActionMinLinear, &QAction::triggered, this, &MainWindow::OnTextureFiltersChanged);
 
@@ -331,18 +334,10 @@ MainWindow::MainWindow(AssetManager* application)
 
 	connect(_application, &AssetManager::SettingsChanged, this, &MainWindow::SyncSettings);
 
-	{
-		const bool isSoundAvailable = _application->GetSoundSystem()->IsSoundAvailable();
+	// The sound system is initialized after the window is shown.
+	connect(_application, &AssetManager::SoundSystemInitialized, this, &MainWindow::OnSoundSystemInitialized);
 
-		_ui.ActionPlaySounds->setEnabled(isSoundAvailable);
-		_ui.ActionFramerateAffectsPitch->setEnabled(isSoundAvailable);
-
-		if (isSoundAvailable)
-		{
-			_ui.ActionPlaySounds->setChecked(_application->GetApplicationSettings()->PlaySounds);
-			_ui.ActionFramerateAffectsPitch->setChecked(_application->GetApplicationSettings()->FramerateAffectsPitch);
-		}
-	}
+	OnSoundSystemInitialized();
 
 	_assetsWidget->setVisible(false);
 
@@ -421,6 +416,7 @@ MainWindow::MainWindow(AssetManager* application)
 
 		_ui.ActionPowerOf2Textures->setChecked(textureLoader->ShouldResizeToPowerOf2());
 		_ui.ActionWaitForVerticalSync->setChecked(_application->GetApplicationSettings()->ShouldEnableVSync());
+		_ui.ActionContinuousRendering->setChecked(_application->GetApplicationSettings()->ShouldRenderContinuously());
 		_ui.MinFilterGroup->actions()[static_cast<int>(textureLoader->GetMinFilter())]->setChecked(true);
 		_ui.MagFilterGroup->actions()[static_cast<int>(textureLoader->GetMagFilter())]->setChecked(true);
 		_ui.MipmapFilterGroup->actions()[static_cast<int>(textureLoader->GetMipmapFilter())]->setChecked(true);
@@ -1052,6 +1048,20 @@ void MainWindow::OnTextureFiltersChanged()
 		static_cast<graphics::MipmapFilter>(currentIndex(_ui.MipmapFilterGroup)));
 }
 
+void MainWindow::OnSoundSystemInitialized()
+{
+	const bool isSoundAvailable = _application->GetSoundSystem()->IsSoundAvailable();
+
+	_ui.ActionPlaySounds->setEnabled(isSoundAvailable);
+	_ui.ActionFramerateAffectsPitch->setEnabled(isSoundAvailable);
+
+	if (isSoundAvailable)
+	{
+		_ui.ActionPlaySounds->setChecked(_application->GetApplicationSettings()->PlaySounds);
+		_ui.ActionFramerateAffectsPitch->setChecked(_application->GetApplicationSettings()->FramerateAffectsPitch);
+	}
+}
+
 void MainWindow::OnOpenOptionsDialog()
 {
 	OptionsDialog dialog{_application, this};
@@ -89,6 +89,8 @@ private slots:
 
 	void OnTextureFiltersChanged();
 
+	void OnSoundSystemInitialized();
+
 	void OnOpenOptionsDialog();
 
 private:
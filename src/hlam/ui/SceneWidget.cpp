@@ -1,10 +1,12 @@
 #include <QApplication>
+#include <QOpenGLTimerQuery>
 #include <QSurfaceFormat>
 #include <QWheelEvent>
 #include <QWidget>
 
 #include "settings/ApplicationSettings.hpp"
 
+#include "graphics/RenderStatistics.hpp"
 #include "graphics/Scene.hpp"
 #include "graphics/SceneContext.hpp"
 #include "application/AssetManager.hpp"
@@ -13,6 +15,7 @@
 SceneWidget::SceneWidget(AssetManager* application,
 	QOpenGLFunctions_1_1* openglFunctions, graphics::TextureLoader* textureLoader)
 	: QOpenGLWindow()
+	, _application(application)
 	, _container(QWidget::createWindowContainer(this))
 	, _sceneContext(std::make_unique<graphics::SceneContext>(openglFunctions, textureLoader))
 {
@@ -30,14 +33,29 @@ SceneWidget::SceneWidget(AssetManager* application,
 
 	_container->setFocusPolicy(Qt::FocusPolicy::WheelFocus);
 
-	connect(this, &SceneWidget::frameSwapped, this, qOverload<>(&SceneWidget::update));
+	SetContinuousRendering(settings->ShouldRenderContinuously());
+
+	connect(settings, &ApplicationSettings::ContinuousRenderingChanged, this, &SceneWidget::SetContinuousRendering);
 
 	connect(qGuiApp, &QGuiApplication::focusObjectChanged, this, &SceneWidget::OnFocusObjectChanged);
 
 	_previousFocusObject = qGuiApp->focusObject();
 }
 
-SceneWidget::~SceneWidget() = default;
+SceneWidget::~SceneWidget()
+{
+	if (_timerQueries[0])
+	{
+		makeCurrent();
+
+		for (auto query : _timerQueries)
+		{
+			delete query;
+		}
+
+		doneCurrent();
+	}
+}
 
 void SceneWidget::SetScene(graphics::Scene* scene)
 {
@@ -48,6 +66,27 @@ void SceneWidget::SetScene(graphics::Scene* scene)
 		const QSize size{this->size()};
 		_scene->UpdateWindowSize(static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
 	}
+
+	update();
+}
+
+void SceneWidget::SetContinuousRendering(bool value)
+{
+	if (value == static_cast<bool>(_continuousRenderingConnection))
+	{
+		return;
+	}
+
+	if (value)
+	{
+		_continuousRenderingConnection = connect(this, &SceneWidget::frameSwapped, this, qOverload<>(&SceneWidget::update));
+		update();
+	}
+	else
+	{
+		disconnect(_continuousRenderingConnection);
+		_continuousRenderingConnection = {};
+	}
 }
 
 bool SceneWidget::event(QEvent* event)
@@ -141,9 +180,82 @@ void SceneWidget::paintGL()
 	{
 		if (_scene)
 		{
+			if (!_timerQueriesInitialized)
+			{
+				InitializeTimerQueries();
+			}
+
+			std::optional<double> gpuTime;
+			QOpenGLTimerQuery* timerQuery = nullptr;
+
+			if (_timerQueries[0])
+			{
+				gpuTime = TryGetGPUTime();
+
+				// If all queries are still in flight this frame isn't timed.
+				if (_pendingTimerQueryCount < TimerQueryCount)
+				{
+					timerQuery = _timerQueries[_nextTimerQuery];
+					timerQuery->begin();
+				}
+			}
+
 			//TODO: this is temporary until window sized resources can be decoupled from the scene class
 			_scene->UpdateWindowSize(static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
 			_scene->Draw(*_sceneContext);
+
+			if (timerQuery)
+			{
+				timerQuery->end();
+				_nextTimerQuery = (_nextTimerQuery + 1) % TimerQueryCount;
+				++_pendingTimerQueryCount;
+			}
+
+			auto statistics = _scene->GetFrameStatistics();
+			statistics.GPUTime = gpuTime;
+			_application->GetRenderStatistics()->AddFrame(statistics);
 		}
 	}
 }
+
+void SceneWidget::InitializeTimerQueries()
+{
+	_timerQueriesInitialized = true;
+
+	// Timer queries require OpenGL 3.3 or ARB_timer_query. If they aren't available only CPU times are recorded.
+	for (auto& query : _timerQueries)
+	{
+		query = new QOpenGLTimerQuery(this);
+
+		if (!query->create())
+		{
+			for (auto& created : _timerQueries)
+			{
+				delete created;
+				created = nullptr;
+			}
+
+			return;
+		}
+	}
+}
+
+std::optional<double> SceneWidget::TryGetGPUTime()
+{
+	if (_pendingTimerQueryCount == 0)
+	{
+		return {};
+	}
+
+	auto query = _timerQueries[(_nextTimerQuery + TimerQueryCount - _pendingTimerQueryCount) % TimerQueryCount];
+
+	if (!query->isResultAvailable())
+	{
+		return {};
+	}
+
+	--_pendingTimerQueryCount;
+
+	// Result is in nanoseconds.
+	return query->waitForResult() / 1'000'000.0;
+}
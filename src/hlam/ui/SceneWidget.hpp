@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <optional>
 
 #include <QOpenGLWindow>
 #include <QPointer>
 
 class AssetManager;
 class QOpenGLFunctions_1_1;
+class QOpenGLTimerQuery;
 
 namespace graphics
 {
@@ -37,6 +40,12 @@ public:
 
 	void SetScene(graphics::Scene* scene);
 
+	/**
+	*	@brief If enabled, a new frame is requested as soon as the previous one has been presented.
+	*	Otherwise the widget is only redrawn when @c update is called.
+	*/
+	void SetContinuousRendering(bool value);
+
 signals:
 	void MouseEvent(QMouseEvent* event);
 
@@ -59,8 +68,26 @@ protected:
 	void paintGL() override;
 
 private:
+	void InitializeTimerQueries();
+
+	/**
+	*	@brief Gets the GPU time of the oldest frame whose timer query has finished, in milliseconds.
+	*/
+	std::optional<double> TryGetGPUTime();
+
+private:
+	// Timer queries are read a few frames later to avoid stalling the pipeline.
+	static constexpr std::size_t TimerQueryCount = 3;
+
+	AssetManager* const _application;
 	QWidget* const _container;
 	const std::unique_ptr<graphics::SceneContext> _sceneContext;
 	graphics::Scene* _scene{};
 	QPointer<QObject> _previousFocusObject;
+	QMetaObject::Connection _continuousRenderingConnection;
+
+	bool _timerQueriesInitialized{false};
+	std::array<QOpenGLTimerQuery*, TimerQueryCount> _timerQueries{};
+	std::size_t _nextTimerQuery{0};
+	std::size_t _pendingTimerQueryCount{0};
 };
@@ -0,0 +1,189 @@
+#include <algorithm>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QThread>
+
+#include "application/AssetManager.hpp"
+#include "application/Assets.hpp"
+
+#include "ui/dockpanels/AssetClassificationCache.hpp"
+
+#include "utility/IOUtils.hpp"
+
+namespace
+{
+const quint32 CacheFileMagic{0x484C4143};
+const quint32 CacheFileVersion{1};
+
+/**
+*	@brief Classification only reads file headers, so a few threads are enough to keep the disk busy.
+*/
+constexpr int MaximumThreadCount = 4;
+
+/**
+*	@brief Caches larger than this are not saved, to keep startup fast and the file small.
+*/
+constexpr int MaximumPersistedEntryCount = 200000;
+}
+
+AssetClassificationCache::AssetClassificationCache(const QString& cacheFileName, QObject* parent)
+	: QObject(parent)
+	, _cacheFileName(cacheFileName)
+{
+	_threadPool.setMaxThreadCount(std::max(1, std::min(MaximumThreadCount, QThread::idealThreadCount() - 1)));
+
+	Load();
+}
+
+AssetClassificationCache::~AssetClassificationCache()
+{
+	_threadPool.clear();
+	_threadPool.waitForDone();
+
+	Save();
+}
+
+std::optional<bool> AssetClassificationCache::GetClassification(AssetProvider* provider, const QFileInfo& fileInfo)
+{
+	const QString fileName = fileInfo.absoluteFilePath();
+	const QString key = GetKey(provider->GetProviderName(), fileName);
+
+	const qint64 size = fileInfo.size();
+	const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+	if (const auto it = _entries.constFind(key); it != _entries.constEnd())
+	{
+		if (it->Size == size && it->LastModified == lastModified)
+		{
+			return it->Accepted;
+		}
+	}
+
+	if (_pending.contains(key))
+	{
+		return {};
+	}
+
+	_pending.insert(key);
+
+	_threadPool.start([this, provider, key, fileName, size, lastModified]
+		{
+			Entry entry{size, lastModified, false};
+
+			if (FilePtr file{utf8_fopen(fileName.toStdString().c_str(), "rb")}; file)
+			{
+				entry.Accepted = provider->IsCandidateForLoading(fileName, file.get());
+			}
+
+			QMetaObject::invokeMethod(this, [this, key, fileName, entry]
+				{
+					OnClassified(key, fileName, entry);
+				}, Qt::QueuedConnection);
+		});
+
+	return {};
+}
+
+void AssetClassificationCache::CancelPending()
+{
+	_threadPool.clear();
+
+	// Tasks that are already running will still report their results, which is harmless.
+	_pending.clear();
+}
+
+QString AssetClassificationCache::GetKey(const QString& providerName, const QString& fileName)
+{
+	return providerName + QLatin1Char('\n') + fileName;
+}
+
+void AssetClassificationCache::OnClassified(const QString& key, const QString& fileName, const Entry& entry)
+{
+	_pending.remove(key);
+	_entries.insert(key, entry);
+	_modified = true;
+
+	emit FileClassified(fileName, entry.Accepted);
+}
+
+void AssetClassificationCache::Load()
+{
+	if (_cacheFileName.isEmpty())
+	{
+		return;
+	}
+
+	QFile file{_cacheFileName};
+
+	if (!file.open(QFile::ReadOnly))
+	{
+		return;
+	}
+
+	QDataStream stream{&file};
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	qint32 count = 0;
+
+	stream >> magic >> version >> count;
+
+	if (magic != CacheFileMagic || version != CacheFileVersion || count < 0 || count > MaximumPersistedEntryCount)
+	{
+		qCDebug(HLAM) << "Ignoring invalid file browser cache" << _cacheFileName;
+		return;
+	}
+
+	_entries.reserve(count);
+
+	for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		QString key;
+		Entry entry;
+
+		stream >> key >> entry.Size >> entry.LastModified >> entry.Accepted;
+
+		_entries.insert(key, entry);
+	}
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		qCDebug(HLAM) << "File browser cache" << _cacheFileName << "is corrupt";
+		_entries.clear();
+	}
+}
+
+void AssetClassificationCache::Save() const
+{
+	if (_cacheFileName.isEmpty() || !_modified || _entries.size() > MaximumPersistedEntryCount)
+	{
+		return;
+	}
+
+	QDir{}.mkpath(QFileInfo{_cacheFileName}.absolutePath());
+
+	QSaveFile file{_cacheFileName};
+
+	if (!file.open(QFile::WriteOnly))
+	{
+		qCWarning(HLAM) << "Could not save file browser cache" << _cacheFileName;
+		return;
+	}
+
+	QDataStream stream{&file};
+
+	stream << CacheFileMagic << CacheFileVersion << static_cast<qint32>(_entries.size());
+
+	for (auto it = _entries.constBegin(); it != _entries.constEnd(); ++it)
+	{
+		stream << it.key() << it->Size << it->LastModified << it->Accepted;
+	}
+
+	file.commit();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+class AssetProvider;
+class QFileInfo;
+
+/**
+*	@brief Determines in the background whether files are candidates for loading by an asset provider.
+*	Results are cached by provider, path, size and modification time, and can be saved to disk so they persist between sessions.
+*	Providers must be able to run AssetProvider::IsCandidateForLoading on any thread.
+*/
+class AssetClassificationCache final : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	*	@param cacheFileName File to load the cache from and save it to. If empty the cache is not persisted.
+	*/
+	explicit AssetClassificationCache(const QString& cacheFileName, QObject* parent = nullptr);
+	~AssetClassificationCache() override;
+
+	/**
+	*	@brief Gets whether @p fileInfo is a candidate for loading by @p provider.
+	*	If the result is not known yet the file is queued for classification and an empty optional is returned.
+	*	@ref FileClassified is emitted when the result becomes available.
+	*/
+	std::optional<bool> GetClassification(AssetProvider* provider, const QFileInfo& fileInfo);
+
+	/**
+	*	@brief Discards pending work, for example when the directory being browsed changes.
+	*	Files that are still needed will be queued again the next time they are requested.
+	*/
+	void CancelPending();
+
+signals:
+	void FileClassified(const QString& fileName, bool accepted);
+
+private:
+	struct Entry
+	{
+		qint64 Size{};
+		qint64 LastModified{};
+		bool Accepted{};
+	};
+
+	static QString GetKey(const QString& providerName, const QString& fileName);
+
+	void OnClassified(const QString& key, const QString& fileName, const Entry& entry);
+
+	void Load();
+	void Save() const;
+
+private:
+	const QString _cacheFileName;
+
+	QThreadPool _threadPool;
+
+	QHash<QString, Entry> _entries;
+	QSet<QString> _pending;
+
+	bool _modified{false};
+};
@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <cstdio>
 #include <utility>
 #include <vector>
 
@@ -8,9 +7,11 @@
 #include <QFileInfo>
 #include <QFileSystemModel>
 #include <QMessageBox>
+#include <QSize>
 #include <QSortFilterProxyModel>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 
 #include "application/AssetManager.hpp"
 #include "application/Assets.hpp"
@@ -20,14 +21,94 @@
 
 #include "ui/MainWindow.hpp"
 #include "ui/dialogs/SelectGameConfigurationDialog.hpp"
+#include "ui/dockpanels/AssetClassificationCache.hpp"
 #include "ui/dockpanels/FileBrowser.hpp"
+#include "ui/dockpanels/ThumbnailCache.hpp"
+
+namespace
+{
+const QString CacheBaseFileName{QStringLiteral("FileBrowserCache.dat")};
+const QString ThumbnailDirectoryName{QStringLiteral("thumbnails")};
+
+/**
+*	@brief How long to wait after a file is classified before refiltering, so results are applied in batches.
+*/
+constexpr int RefilterDelayMilliseconds = 100;
+}
 
 class AssetFilterModel final : public QSortFilterProxyModel
 {
 public:
-	explicit AssetFilterModel(QObject* parent = nullptr)
+	AssetFilterModel(AssetClassificationCache* classificationCache, ThumbnailCache* thumbnailCache, QObject* parent = nullptr)
 		: QSortFilterProxyModel(parent)
+		, _classificationCache(classificationCache)
+		, _thumbnailCache(thumbnailCache)
+		, _refilterTimer(new QTimer(this))
+	{
+		_refilterTimer->setSingleShot(true);
+		_refilterTimer->setInterval(RefilterDelayMilliseconds);
+
+		connect(_refilterTimer, &QTimer::timeout, this, &AssetFilterModel::invalidateFilter);
+
+		connect(_classificationCache, &AssetClassificationCache::FileClassified, this,
+			[this](const QString& fileName, bool accepted)
+			{
+				// Rejected files are already hidden, so only accepted files need the filter to be reapplied.
+				if (accepted && !_refilterTimer->isActive())
+				{
+					_refilterTimer->start();
+				}
+			});
+
+		connect(_thumbnailCache, &ThumbnailCache::ThumbnailReady, this,
+			[this](const QString& fileName)
+			{
+				auto fileSystemModel = static_cast<QFileSystemModel*>(sourceModel());
+
+				if (const auto index = mapFromSource(fileSystemModel->index(fileName)); index.isValid())
+				{
+					emit dataChanged(index, index, {Qt::DecorationRole});
+				}
+			});
+	}
+
+	void SetShowThumbnails(bool value)
 	{
+		if (_showThumbnails != value)
+		{
+			_showThumbnails = value;
+
+			if (!_showThumbnails)
+			{
+				_thumbnailCache->CancelPending();
+			}
+
+			if (const int rows = rowCount(); rows > 0)
+			{
+				emit dataChanged(index(0, 0), index(rows - 1, 0), {Qt::DecorationRole});
+			}
+		}
+	}
+
+	QVariant data(const QModelIndex& index, int role) const override
+	{
+		if (_showThumbnails && role == Qt::DecorationRole && index.column() == 0)
+		{
+			auto fileSystemModel = static_cast<QFileSystemModel*>(sourceModel());
+
+			const auto fileInfo = fileSystemModel->fileInfo(mapToSource(index));
+
+			// Only rows that are painted request data, so thumbnails are generated for visible files only.
+			if (fileInfo.isFile() && ThumbnailCache::CanHaveThumbnail(fileInfo))
+			{
+				if (const auto thumbnail = _thumbnailCache->GetThumbnail(fileInfo); !thumbnail.isNull())
+				{
+					return thumbnail;
+				}
+			}
+		}
+
+		return QSortFilterProxyModel::data(index, role);
 	}
 
 	void SetProvider(AssetProvider* provider)
@@ -45,6 +126,8 @@ public:
 				_extensions.clear();
 			}
 
+			_classificationCache->CancelPending();
+
 			invalidate();
 		}
 	}
@@ -79,32 +162,30 @@ protected:
 			return false;
 		}
 
-		const auto fileName = fileInfo.absoluteFilePath();
-
-		FILE* file = fopen(fileName.toStdString().c_str(), "rb");
-
-		if (!file)
-		{
-			return false;
-		}
-
-		const bool acceptFile = _provider->IsCandidateForLoading(fileName, file);
-
-		fclose(file);
-
-		return acceptFile;
+		// Files are hidden until they have been classified in the background.
+		return _classificationCache->GetClassification(_provider, fileInfo).value_or(false);
 	}
 
 private:
+	AssetClassificationCache* const _classificationCache;
+	ThumbnailCache* const _thumbnailCache;
+	QTimer* const _refilterTimer;
+
 	AssetProvider* _provider{};
 	QStringList _extensions;
+
+	bool _showThumbnails{false};
 };
 
 FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 	: QWidget(parent)
 	, _application(application)
 	, _model(new QFileSystemModel(this))
-	, _filterModel(new AssetFilterModel(this))
+	, _classificationCache(new AssetClassificationCache(
+		QFileInfo{application->GetSettings()->fileName()}.absolutePath() + QDir::separator() + CacheBaseFileName, this))
+	, _thumbnailCache(new ThumbnailCache(
+		QFileInfo{application->GetSettings()->fileName()}.absolutePath() + QDir::separator() + ThumbnailDirectoryName, this))
+	, _filterModel(new AssetFilterModel(_classificationCache, _thumbnailCache, this))
 {
 	_ui.setupUi(this);
 
@@ -121,6 +202,8 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 			_filterModel->SetProvider(_ui.Filters->currentData().value<AssetProvider*>());
 		});
 
+	connect(_ui.ShowThumbnails, &QCheckBox::toggled, this, &FileBrowser::SetShowThumbnails);
+
 	connect(_ui.FileView, &QTreeView::activated, this, &FileBrowser::OnFileSelected);
 	connect(_ui.FileView, &QTreeView::doubleClicked, this, &FileBrowser::OnFileDoubleClicked);
 
@@ -240,6 +323,8 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 	}
 
 	_ui.Filters->setCurrentIndex(filterIndex);
+
+	_ui.ShowThumbnails->setChecked(_application->GetApplicationSettings()->ShouldShowFileListThumbnails());
 }
 
 FileBrowser::~FileBrowser()
@@ -249,6 +334,7 @@ FileBrowser::~FileBrowser()
 	auto provider = _ui.Filters->currentData().value<AssetProvider*>();
 	auto providerName = provider ? provider->GetProviderName() : QString{};
 	_application->GetApplicationSettings()->SetFileListFilter(providerName);
+	_application->GetApplicationSettings()->SetShowFileListThumbnails(_ui.ShowThumbnails->isChecked());
 }
 
 void FileBrowser::Initialize()
@@ -270,11 +356,22 @@ void FileBrowser::Initialize()
 
 void FileBrowser::SetRootDirectory(const QString& directory)
 {
+	_classificationCache->CancelPending();
+	_thumbnailCache->CancelPending();
+
 	_model->setRootPath(directory);
 	_ui.FileView->setRootIndex(_filterModel->mapFromSource(_model->index(directory)));
 	_ui.Root->setText(directory);
 }
 
+void FileBrowser::SetShowThumbnails(bool value)
+{
+	_filterModel->SetShowThumbnails(value);
+
+	// An invalid size makes the view use the style's default icon size.
+	_ui.FileView->setIconSize(value ? QSize{ThumbnailCache::ThumbnailSize, ThumbnailCache::ThumbnailSize} : QSize{});
+}
+
 void FileBrowser::MaybeOpenFiles(const QModelIndexList& indices)
 {
 	QStringList fileNames;
@@ -6,10 +6,12 @@
 
 #include "ui_FileBrowser.h"
 
+class AssetClassificationCache;
 class AssetFilterModel;
 class AssetManager;
 class GameConfiguration;
 class QFileSystemModel;
+class ThumbnailCache;
 
 class FileBrowser final : public QWidget
 {
@@ -24,6 +26,8 @@ public:
 private:
 	void SetRootDirectory(const QString& directory);
 
+	void SetShowThumbnails(bool value);
+
 	void MaybeOpenFiles(const QModelIndexList& indices);
 
 signals:
@@ -37,6 +41,8 @@ private:
 	Ui_FileBrowser _ui;
 	AssetManager* const _application;
 	QFileSystemModel* const _model;
+	AssetClassificationCache* const _classificationCache;
+	ThumbnailCache* const _thumbnailCache;
 	AssetFilterModel* const _filterModel;
 
 	bool _initialized{false};
@@ -0,0 +1,231 @@
+#include <algorithm>
+
+#include <QBrush>
+#include <QStringList>
+#include <QTimer>
+
+#include "ui/dockpanels/MessagesModel.hpp"
+
+MessagesModel::MessagesModel(QObject* parent)
+	: QAbstractListModel(parent)
+	, _flushTimer(new QTimer(this))
+{
+	_messages.resize(MaximumMessageCount);
+
+	_flushTimer->setSingleShot(true);
+	_flushTimer->setInterval(FlushIntervalMilliseconds);
+
+	connect(_flushTimer, &QTimer::timeout, this, &MessagesModel::Flush);
+}
+
+MessagesModel::~MessagesModel() = default;
+
+int MessagesModel::rowCount(const QModelIndex& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+
+	return static_cast<int>(_visibleMessages.size());
+}
+
+QVariant MessagesModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid() || index.row() >= rowCount())
+	{
+		return {};
+	}
+
+	const auto& message = GetStoredMessage(_visibleMessages[index.row()]);
+
+	switch (role)
+	{
+	case Qt::DisplayRole:
+	{
+		if (_showCategory)
+		{
+			return QString{"%1: %2"}.arg(message.Category).arg(message.Text);
+		}
+
+		return message.Text;
+	}
+
+	case Qt::ForegroundRole:
+	{
+		if (IsCritical(message.Type))
+		{
+			return QBrush{Qt::GlobalColor::red};
+		}
+
+		break;
+	}
+	}
+
+	return {};
+}
+
+void MessagesModel::AddMessage(QtMsgType type, const QString& category, const QString& message)
+{
+	for (auto& line : message.split('\n'))
+	{
+		_pendingMessages.push_back({type, category, std::move(line)});
+	}
+
+	// Keep only as many messages as the ring buffer can hold so bursts don't grow the queue without limit.
+	if (_pendingMessages.size() > MaximumMessageCount)
+	{
+		_pendingMessages.erase(_pendingMessages.begin(), _pendingMessages.end() - MaximumMessageCount);
+	}
+
+	if (!_flushTimer->isActive())
+	{
+		_flushTimer->start();
+	}
+}
+
+void MessagesModel::Clear()
+{
+	beginResetModel();
+
+	_pendingMessages.clear();
+	_visibleMessages.clear();
+
+	for (std::uint64_t sequence = _firstSequence; sequence < _nextSequence; ++sequence)
+	{
+		_messages[sequence % MaximumMessageCount] = {};
+	}
+
+	_firstSequence = _nextSequence;
+
+	endResetModel();
+}
+
+void MessagesModel::SetShowCategory(bool value)
+{
+	if (_showCategory != value)
+	{
+		_showCategory = value;
+
+		if (!_visibleMessages.empty())
+		{
+			emit dataChanged(index(0), index(rowCount() - 1), {Qt::DisplayRole});
+		}
+	}
+}
+
+void MessagesModel::SetTypeVisible(QtMsgType type, bool value)
+{
+	switch (type)
+	{
+	case QtDebugMsg:
+		_showDebug = value;
+		break;
+
+	case QtInfoMsg:
+		_showInfo = value;
+		break;
+
+	default: return;
+	}
+
+	RebuildVisibleMessages();
+}
+
+void MessagesModel::SetCategoryVisible(const QString& category, bool value)
+{
+	if (value)
+	{
+		_hiddenCategories.remove(category);
+	}
+	else
+	{
+		_hiddenCategories.insert(category);
+	}
+
+	RebuildVisibleMessages();
+}
+
+void MessagesModel::Flush()
+{
+	_flushTimer->stop();
+
+	if (_pendingMessages.empty())
+	{
+		return;
+	}
+
+	const std::uint64_t endSequence = _nextSequence + _pendingMessages.size();
+	const std::uint64_t firstKeptSequence = std::max(_firstSequence,
+		endSequence > MaximumMessageCount ? endSequence - MaximumMessageCount : 0);
+
+	// Remove rows whose messages are about to be overwritten before the storage is reused.
+	const auto firstKept = std::lower_bound(_visibleMessages.begin(), _visibleMessages.end(), firstKeptSequence);
+
+	if (const auto removedCount = static_cast<int>(firstKept - _visibleMessages.begin()); removedCount > 0)
+	{
+		beginRemoveRows({}, 0, removedCount - 1);
+		_visibleMessages.erase(_visibleMessages.begin(), firstKept);
+		endRemoveRows();
+	}
+
+	_firstSequence = firstKeptSequence;
+
+	const std::size_t firstNewRow = _visibleMessages.size();
+	std::vector<std::uint64_t> newVisibleMessages;
+
+	for (auto& message : _pendingMessages)
+	{
+		const std::uint64_t sequence = _nextSequence++;
+
+		if (IsVisible(message))
+		{
+			newVisibleMessages.push_back(sequence);
+		}
+
+		_messages[sequence % MaximumMessageCount] = std::move(message);
+	}
+
+	_pendingMessages.clear();
+
+	if (!newVisibleMessages.empty())
+	{
+		beginInsertRows({}, static_cast<int>(firstNewRow), static_cast<int>(firstNewRow + newVisibleMessages.size() - 1));
+		_visibleMessages.insert(_visibleMessages.end(), newVisibleMessages.begin(), newVisibleMessages.end());
+		endInsertRows();
+
+		emit MessagesAdded();
+	}
+}
+
+bool MessagesModel::IsVisible(const Message& message) const
+{
+	if (_hiddenCategories.contains(message.Category))
+	{
+		return false;
+	}
+
+	switch (message.Type)
+	{
+	case QtDebugMsg: return _showDebug;
+	case QtInfoMsg: return _showInfo;
+	default: return true;
+	}
+}
+
+void MessagesModel::RebuildVisibleMessages()
+{
+	beginResetModel();
+
+	_visibleMessages.clear();
+
+	for (std::uint64_t sequence = _firstSequence; sequence < _nextSequence; ++sequence)
+	{
+		if (IsVisible(GetStoredMessage(sequence)))
+		{
+			_visibleMessages.push_back(sequence);
+		}
+	}
+
+	endResetModel();
+}
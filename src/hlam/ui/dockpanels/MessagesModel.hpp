@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <QAbstractListModel>
+#include <QSet>
+#include <QString>
+#include <QtGlobal>
+
+class QTimer;
+
+/**
+*	@brief Stores the most recent log messages in a fixed size ring buffer and exposes the ones that pass the filters as a list.
+*	New messages are collected and added to the list in batches so views are updated at most once per flush interval.
+*/
+class MessagesModel final : public QAbstractListModel
+{
+	Q_OBJECT
+
+public:
+	static constexpr std::size_t MaximumMessageCount = 10000;
+	static constexpr int FlushIntervalMilliseconds = 50;
+
+	explicit MessagesModel(QObject* parent = nullptr);
+	~MessagesModel() override;
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+	QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+	/**
+	*	@brief Queues a message to be added on the next flush. Messages with multiple lines are split into one row per line.
+	*/
+	void AddMessage(QtMsgType type, const QString& category, const QString& message);
+
+	void Clear();
+
+	void SetShowCategory(bool value);
+
+	/**
+	*	@brief Sets whether messages of the given type are shown.
+	*	Warnings and errors are always shown.
+	*/
+	void SetTypeVisible(QtMsgType type, bool value);
+
+	void SetCategoryVisible(const QString& category, bool value);
+
+	/**
+	*	@brief Adds all queued messages to the list. Called automatically after new messages have been queued.
+	*/
+	void Flush();
+
+signals:
+	/**
+	*	@brief Emitted after a flush added rows to the end of the list.
+	*/
+	void MessagesAdded();
+
+private:
+	struct Message
+	{
+		QtMsgType Type{};
+		QString Category;
+		QString Text;
+	};
+
+	static bool IsCritical(QtMsgType type)
+	{
+		return type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg;
+	}
+
+	bool IsVisible(const Message& message) const;
+
+	const Message& GetStoredMessage(std::uint64_t sequence) const
+	{
+		return _messages[sequence % MaximumMessageCount];
+	}
+
+	void RebuildVisibleMessages();
+
+private:
+	QTimer* const _flushTimer;
+
+	std::vector<Message> _pendingMessages;
+
+	/**
+	*	@brief Ring buffer of stored messages. Message number n is stored at index n % MaximumMessageCount.
+	*/
+	std::vector<Message> _messages;
+
+	/**
+	*	@brief Sequence number of the oldest stored message.
+	*/
+	std::uint64_t _firstSequence{};
+
+	/**
+	*	@brief Total number of messages stored, including ones that have since been overwritten or cleared.
+	*/
+	std::uint64_t _nextSequence{};
+
+	/**
+	*	@brief Sequence numbers of the stored messages that pass the filters, in order.
+	*/
+	std::deque<std::uint64_t> _visibleMessages;
+
+	bool _showCategory{false};
+	bool _showDebug{false};
+	bool _showInfo{true};
+	QSet<QString> _hiddenCategories;
+};
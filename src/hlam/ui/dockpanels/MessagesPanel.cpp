@@ -1,83 +1,106 @@
-#include <cstring>
+#include <algorithm>
 
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
+#include <QKeySequence>
 #include <QScrollBar>
+#include <QStringList>
 
 #include "application/AssetManager.hpp"
 
 #include "ui_MessagesPanel.h"
 
+#include "ui/dockpanels/MessagesModel.hpp"
 #include "ui/dockpanels/MessagesPanel.hpp"
 
-const int MaxLines = 1000;
+namespace
+{
+const QString QtDiagnosticsCategory{QStringLiteral("default")};
+}
 
 MessagesPanel::MessagesPanel(AssetManager* application, QWidget* parent)
 	: QWidget(parent)
 	, _ui(std::make_unique<Ui_MessagesPanel>())
 	, _application(application)
+	, _model(new MessagesModel(this))
 {
 	_ui->setupUi(this);
 
-	_defaultTextColor = _ui->Text->textColor();
+	_model->SetShowCategory(_ui->Category->isChecked());
+	_model->SetTypeVisible(QtDebugMsg, _ui->Debug->isChecked());
+	_model->SetTypeVisible(QtInfoMsg, _ui->Info->isChecked());
+	_model->SetCategoryVisible(QtDiagnosticsCategory, _ui->QtDiagnostics->isChecked());
+
+	_ui->Messages->setModel(_model);
+
+	auto copyAction = new QAction("Copy", _ui->Messages);
+	copyAction->setShortcut(QKeySequence::Copy);
+	copyAction->setShortcutContext(Qt::WidgetShortcut);
+	_ui->Messages->addAction(copyAction);
+
+	connect(copyAction, &QAction::triggered, this, &MessagesPanel::OnCopy);
+
+	connect(_ui->Category, &QCheckBox::toggled, _model, &MessagesModel::SetShowCategory);
+	connect(_ui->Debug, &QCheckBox::toggled, this, [this](bool checked) { _model->SetTypeVisible(QtDebugMsg, checked); });
+	connect(_ui->Info, &QCheckBox::toggled, this, [this](bool checked) { _model->SetTypeVisible(QtInfoMsg, checked); });
+	connect(_ui->QtDiagnostics, &QCheckBox::toggled, this,
+		[this](bool checked) { _model->SetCategoryVisible(QtDiagnosticsCategory, checked); });
+	connect(_ui->Clear, &QPushButton::clicked, _model, &MessagesModel::Clear);
+
+	connect(_model, &MessagesModel::rowsAboutToBeInserted, this, &MessagesPanel::OnAboutToAddMessages);
+	connect(_model, &MessagesModel::MessagesAdded, this, &MessagesPanel::OnMessagesAdded);
 
-	connect(_ui->Clear, &QPushButton::clicked, _ui->Text, &QTextEdit::clear);
 	connect(_application, &AssetManager::LogMessageReceived, this, &MessagesPanel::OnMessageReceived);
 }
 
 MessagesPanel::~MessagesPanel() = default;
 
-void MessagesPanel::OnMessageReceived(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+void MessagesPanel::OnMessageReceived(QtMsgType type, const QString& category, const QString& msg)
 {
-	if (std::strcmp(context.category, "default") == 0 && !_ui->QtDiagnostics->isChecked())
-	{
-		return;
-	}
-
-	if (type == QtDebugMsg && !_ui->Debug->isChecked())
-	{
-		return;
-	}
-
-	if (type == QtInfoMsg && !_ui->Info->isChecked())
-	{
-		return;
-	}
+	_model->AddMessage(type, category, msg);
 
 	const bool isCritical = type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg;
 
-	_ui->Text->setTextColor(isCritical ? Qt::GlobalColor::red : _defaultTextColor);
-
-	if (!_ui->Text->document()->isEmpty())
+	if (isCritical)
 	{
-		_ui->Text->insertPlainText("\n");
+		parentWidget()->show();
 	}
+}
+
+void MessagesPanel::OnAboutToAddMessages()
+{
+	// Only follow new messages if the user hasn't scrolled up to read older ones.
+	const auto scrollBar = _ui->Messages->verticalScrollBar();
+	_scrollToBottom = scrollBar->value() == scrollBar->maximum();
+}
 
-	if (_ui->Category->isChecked())
+void MessagesPanel::OnMessagesAdded()
+{
+	if (_scrollToBottom)
 	{
-		_ui->Text->insertPlainText(QString{"%1: "}.arg(context.category));
+		_ui->Messages->scrollToBottom();
 	}
+}
 
-	_ui->Text->insertPlainText(msg);
+void MessagesPanel::OnCopy()
+{
+	auto rows = _ui->Messages->selectionModel()->selectedRows();
 
-	if (int lines = _ui->Text->document()->lineCount(); lines > MaxLines)
+	if (rows.isEmpty())
 	{
-		QTextCursor cursor = _ui->Text->textCursor();
-
-		do
-		{
-			cursor.movePosition(QTextCursor::Start);
-			cursor.movePosition(QTextCursor::Down, QTextCursor::MoveAnchor, 0);
-			cursor.select(QTextCursor::LineUnderCursor);
-			cursor.removeSelectedText();
-			cursor.deleteChar(); // clean up new line
-		} while (--lines > MaxLines);
-
-		_ui->Text->setTextCursor(cursor);
+		return;
 	}
 
-	_ui->Text->verticalScrollBar()->setValue(_ui->Text->verticalScrollBar()->maximum());
+	std::sort(rows.begin(), rows.end());
 
-	if (isCritical)
+	QStringList lines;
+	lines.reserve(rows.size());
+
+	for (const auto& row : rows)
 	{
-		parentWidget()->show();
+		lines.append(row.data().toString());
 	}
+
+	QApplication::clipboard()->setText(lines.join('\n'));
 }
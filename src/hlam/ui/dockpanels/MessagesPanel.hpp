@@ -2,11 +2,11 @@
 
 #include <memory>
 
-#include <QColor>
 #include <QLoggingCategory>
 #include <QWidget>
 
 class AssetManager;
+class MessagesModel;
 class Ui_MessagesPanel;
 
 class MessagesPanel final : public QWidget
@@ -16,10 +16,17 @@ public:
 	~MessagesPanel();
 
 private slots:
-	void OnMessageReceived(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+	void OnMessageReceived(QtMsgType type, const QString& category, const QString& msg);
+
+	void OnAboutToAddMessages();
+	void OnMessagesAdded();
+
+	void OnCopy();
 
 private:
 	std::unique_ptr<Ui_MessagesPanel> _ui;
 	AssetManager* const _application;
-	QColor _defaultTextColor;
+	MessagesModel* const _model;
+
+	bool _scrollToBottom{true};
 };
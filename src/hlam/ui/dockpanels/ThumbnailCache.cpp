@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <limits>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QThread>
+
+#include "application/AssetManager.hpp"
+
+#include "filesystem/FileSystem.hpp"
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/StudioModelIO.hpp"
+#include "formats/studiomodel/StudioModelThumbnail.hpp"
+#include "formats/studiomodel/StudioModelUtils.hpp"
+
+#include "ui/dockpanels/ThumbnailCache.hpp"
+
+#include "utility/IOUtils.hpp"
+
+namespace
+{
+/**
+*	@brief Increment when the renderer output changes so old thumbnails on disk are no longer used.
+*/
+const int ThumbnailVersion{1};
+
+/**
+*	@brief Rendering is CPU bound, so leave some cores free for the rest of the application.
+*/
+constexpr int MaximumThreadCount = 2;
+
+/**
+*	@brief Number of thumbnails kept in memory.
+*/
+constexpr int MaximumCachedThumbnailCount = 2000;
+
+QString GetThumbnailFileName(const QString& cacheDirectory, const QByteArray& contents)
+{
+	QCryptographicHash hash{QCryptographicHash::Sha1};
+
+	hash.addData(contents);
+	hash.addData(QStringLiteral("%1:%2").arg(ThumbnailVersion).arg(ThumbnailCache::ThumbnailSize).toUtf8());
+
+	return cacheDirectory + QDir::separator() + QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".png");
+}
+
+QImage RenderThumbnail(const QString& fileName)
+{
+	FilePtr file{utf8_fopen(fileName.toStdString().c_str(), "rb")};
+
+	if (!file || !studiomdl::IsMainStudioModel(file.get()))
+	{
+		return {};
+	}
+
+	FileSystem fileSystem;
+
+	const auto studioModel = studiomdl::LoadStudioModel(
+		std::filesystem::u8path(fileName.toStdString()), file.get(), fileSystem);
+
+	file.reset();
+
+	const auto editableModel = studiomdl::ConvertToEditable(*studioModel);
+
+	const auto thumbnail = studiomdl::RenderStudioModelThumbnail(editableModel, ThumbnailCache::ThumbnailSize);
+
+	if (thumbnail.Pixels.empty())
+	{
+		return {};
+	}
+
+	QImage image{thumbnail.Width, thumbnail.Height, QImage::Format_ARGB32};
+
+	for (int y = 0; y < thumbnail.Height; ++y)
+	{
+		std::copy_n(thumbnail.Pixels.data() + (y * thumbnail.Width), thumbnail.Width,
+			reinterpret_cast<std::uint32_t*>(image.scanLine(y)));
+	}
+
+	return image;
+}
+}
+
+ThumbnailCache::ThumbnailCache(const QString& cacheDirectory, QObject* parent)
+	: QObject(parent)
+	, _cacheDirectory(cacheDirectory)
+	, _entries(MaximumCachedThumbnailCount)
+{
+	_threadPool.setMaxThreadCount(std::max(1, std::min(MaximumThreadCount, QThread::idealThreadCount() - 1)));
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+	_threadPool.clear();
+	_threadPool.waitForDone();
+}
+
+bool ThumbnailCache::CanHaveThumbnail(const QFileInfo& fileInfo)
+{
+	const QString suffix = fileInfo.suffix();
+
+	return suffix.compare(QStringLiteral("mdl"), Qt::CaseInsensitive) == 0
+		|| suffix.compare(QStringLiteral("dol"), Qt::CaseInsensitive) == 0;
+}
+
+QPixmap ThumbnailCache::GetThumbnail(const QFileInfo& fileInfo)
+{
+	const QString fileName = fileInfo.absoluteFilePath();
+
+	const qint64 size = fileInfo.size();
+	const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+	if (const auto entry = _entries.object(fileName); entry)
+	{
+		if (entry->Size == size && entry->LastModified == lastModified)
+		{
+			return entry->Thumbnail;
+		}
+	}
+
+	if (_pending.contains(fileName))
+	{
+		return {};
+	}
+
+	_pending.insert(fileName);
+
+	// Views request data for the rows they are about to paint, so newer requests are more likely to be visible.
+	if (_nextPriority == std::numeric_limits<int>::max())
+	{
+		_nextPriority = 0;
+	}
+
+	_threadPool.start([this, cacheDirectory = _cacheDirectory, fileName, size, lastModified]
+		{
+			const QImage image = CreateThumbnail(cacheDirectory, fileName);
+
+			QMetaObject::invokeMethod(this, [this, fileName, size, lastModified, image]
+				{
+					OnThumbnailCreated(fileName, size, lastModified, image);
+				}, Qt::QueuedConnection);
+		}, _nextPriority++);
+
+	return {};
+}
+
+void ThumbnailCache::CancelPending()
+{
+	_threadPool.clear();
+
+	// Tasks that are already running will still report their results, which is harmless.
+	_pending.clear();
+}
+
+QImage ThumbnailCache::CreateThumbnail(const QString& cacheDirectory, const QString& fileName)
+{
+	QFile file{fileName};
+
+	if (!file.open(QFile::ReadOnly))
+	{
+		return {};
+	}
+
+	const QByteArray contents = file.readAll();
+
+	file.close();
+
+	QString thumbnailFileName;
+
+	if (!cacheDirectory.isEmpty())
+	{
+		thumbnailFileName = GetThumbnailFileName(cacheDirectory, contents);
+
+		if (QImage image{thumbnailFileName}; !image.isNull())
+		{
+			return image;
+		}
+	}
+
+	QImage image;
+
+	try
+	{
+		image = RenderThumbnail(fileName);
+	}
+	catch (const std::exception& e)
+	{
+		qCDebug(HLAM) << "Could not create thumbnail for" << fileName << ":" << e.what();
+		return {};
+	}
+
+	if (!image.isNull() && !thumbnailFileName.isEmpty())
+	{
+		QDir{}.mkpath(cacheDirectory);
+
+		// Write to a temporary file first so other threads never see a partially written thumbnail.
+		if (QSaveFile thumbnailFile{thumbnailFileName}; thumbnailFile.open(QFile::WriteOnly))
+		{
+			if (image.save(&thumbnailFile, "PNG"))
+			{
+				thumbnailFile.commit();
+			}
+		}
+	}
+
+	return image;
+}
+
+void ThumbnailCache::OnThumbnailCreated(const QString& fileName, qint64 size, qint64 lastModified, const QImage& image)
+{
+	_pending.remove(fileName);
+
+	// Pixmaps can only be created on the GUI thread.
+	_entries.insert(fileName, new Entry{size, lastModified, QPixmap::fromImage(image)});
+
+	emit ThumbnailReady(fileName);
+}
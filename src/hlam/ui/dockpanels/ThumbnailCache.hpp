@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QCache>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+class QFileInfo;
+class QImage;
+
+/**
+*	@brief Generates model thumbnails in the background and caches them in memory and on disk.
+*	Thumbnails are rendered with the software renderer so no graphics context is needed on the worker threads.
+*	Files on disk are named after a hash of the model file contents and the thumbnail settings,
+*	so renamed or copied files reuse existing thumbnails and modified files get new ones.
+*/
+class ThumbnailCache final : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	*	@brief Width and height of thumbnails, in pixels.
+	*/
+	static constexpr int ThumbnailSize = 64;
+
+	/**
+	*	@param cacheDirectory Directory to store thumbnails in. If empty thumbnails are only cached in memory.
+	*/
+	explicit ThumbnailCache(const QString& cacheDirectory, QObject* parent = nullptr);
+	~ThumbnailCache() override;
+
+	/**
+	*	@brief Gets whether a thumbnail can be generated for files like @p fileInfo, based on the file extension.
+	*/
+	static bool CanHaveThumbnail(const QFileInfo& fileInfo);
+
+	/**
+	*	@brief Gets the thumbnail for @p fileInfo.
+	*	If the thumbnail is not available yet it is queued for generation and a null pixmap is returned.
+	*	The most recently requested files are generated first so files currently in view take priority.
+	*	@ref ThumbnailReady is emitted when the thumbnail becomes available.
+	*	Files that are not valid models return a null pixmap once they have been checked.
+	*/
+	QPixmap GetThumbnail(const QFileInfo& fileInfo);
+
+	/**
+	*	@brief Discards pending work, for example when the directory being browsed changes.
+	*/
+	void CancelPending();
+
+signals:
+	void ThumbnailReady(const QString& fileName);
+
+private:
+	struct Entry
+	{
+		qint64 Size{};
+		qint64 LastModified{};
+		QPixmap Thumbnail;
+	};
+
+	/**
+	*	@brief Loads the thumbnail from the disk cache or renders it. Runs on a worker thread.
+	*/
+	static QImage CreateThumbnail(const QString& cacheDirectory, const QString& fileName);
+
+	void OnThumbnailCreated(const QString& fileName, qint64 size, qint64 lastModified, const QImage& image);
+
+private:
+	const QString _cacheDirectory;
+
+	QThreadPool _threadPool;
+
+	QCache<QString, Entry> _entries;
+	QSet<QString> _pending;
+
+	int _nextPriority{};
+};
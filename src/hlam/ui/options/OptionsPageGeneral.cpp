@@ -47,6 +47,7 @@ OptionsPageGeneralWidget::OptionsPageGeneralWidget(
 	_ui.OneAssetAtATime->setChecked(_applicationSettings->OneAssetAtATime);
 	_ui.MaxRecentFiles->setValue(_applicationSettings->GetRecentFiles()->GetMaxRecentFiles());
 	_ui.TickRate->setValue(_applicationSettings->GetTickRate());
+	_ui.FixedTimeStep->setChecked(_applicationSettings->FixedTimeStep);
 	_ui.InvertMouseX->setChecked(_applicationSettings->ShouldInvertMouseX());
 	_ui.InvertMouseY->setChecked(_applicationSettings->ShouldInvertMouseY());
 	_ui.MouseSensitivitySlider->setValue(_applicationSettings->GetMouseSensitivity());
@@ -72,6 +73,7 @@ void OptionsPageGeneralWidget::ApplyChanges()
 	_applicationSettings->OneAssetAtATime = _ui.OneAssetAtATime->isChecked();
 	_applicationSettings->GetRecentFiles()->SetMaxRecentFiles(_ui.MaxRecentFiles->value());
 	_applicationSettings->SetTickRate(_ui.TickRate->value());
+	_applicationSettings->FixedTimeStep = _ui.FixedTimeStep->isChecked();
 	_applicationSettings->SetInvertMouseX(_ui.InvertMouseX->isChecked());
 	_applicationSettings->SetInvertMouseY(_ui.InvertMouseY->isChecked());
 	_applicationSettings->SetMouseSensitivity(_ui.MouseSensitivitySlider->value());
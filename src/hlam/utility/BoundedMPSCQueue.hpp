@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+*	@brief Fixed capacity queue that any number of threads can add to without locking, and that a single thread removes from.
+*	All slots are allocated up front. Values are filled in and consumed in place so slots can reuse their own memory,
+*	for example a string that keeps its capacity between messages.
+*	Based on Dmitry Vyukov's bounded MPMC queue: each slot has a sequence number that tells producers and the consumer whose turn it is.
+*/
+template<typename T>
+class BoundedMPSCQueue final
+{
+public:
+	/**
+	*	@param capacity Number of slots. Rounded up to a power of 2.
+	*/
+	explicit BoundedMPSCQueue(std::size_t capacity)
+		: _capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2)))
+		, _slots(std::make_unique<Slot[]>(_capacity))
+	{
+		for (std::size_t i = 0; i < _capacity; ++i)
+		{
+			_slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+	BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+	std::size_t GetCapacity() const { return _capacity; }
+
+	/**
+	*	@brief Claims a free slot and calls @p fill with a reference to its value. Safe to call from any thread.
+	*	@return Whether a slot was available. @p fill is not called if the queue is full.
+	*/
+	template<typename Fill>
+	bool TryPush(Fill&& fill)
+	{
+		std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Slot& slot = _slots[position & (_capacity - 1)];
+
+			const std::size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+			if (difference == 0)
+			{
+				if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					fill(slot.Value);
+					slot.Sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The consumer hasn't freed this slot yet.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed this slot first.
+				position = _enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	*	@brief Calls @p consume with a reference to the oldest value, then makes its slot available again.
+	*	Must only be called from the consumer thread.
+	*	@return Whether a value was available.
+	*/
+	template<typename Consume>
+	bool TryPop(Consume&& consume)
+	{
+		Slot& slot = _slots[_dequeuePosition & (_capacity - 1)];
+
+		const std::size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+
+		if (sequence != _dequeuePosition + 1)
+		{
+			// Empty, or the producer that claimed this slot hasn't finished filling it in.
+			return false;
+		}
+
+		consume(slot.Value);
+
+		slot.Sequence.store(_dequeuePosition + _capacity, std::memory_order_release);
+		++_dequeuePosition;
+
+		return true;
+	}
+
+private:
+	static constexpr std::size_t CacheLineSize = 64;
+
+	struct alignas(CacheLineSize) Slot
+	{
+		std::atomic<std::size_t> Sequence{};
+		T Value{};
+	};
+
+	const std::size_t _capacity;
+	const std::unique_ptr<Slot[]> _slots;
+
+	alignas(CacheLineSize) std::atomic<std::size_t> _enqueuePosition{0};
+	alignas(CacheLineSize) std::size_t _dequeuePosition{0};
+};
@@ -0,0 +1,120 @@
+#include <cassert>
+#include <numeric>
+
+#include "utility/BoundingVolumeHierarchy.hpp"
+
+namespace
+{
+glm::vec3 GetCenter(const BoundingVolumeHierarchy::Bounds& bounds)
+{
+	return (bounds.Min + bounds.Max) * 0.5f;
+}
+}
+
+void BoundingVolumeHierarchy::Build(const std::vector<Bounds>& primitiveBounds)
+{
+	Clear();
+
+	if (primitiveBounds.empty())
+	{
+		return;
+	}
+
+	_primitives.resize(primitiveBounds.size());
+	std::iota(_primitives.begin(), _primitives.end(), 0);
+
+	// A tree with leaves of at least half the maximum size has fewer than 2 * (count / (MaximumLeafSize / 2)) nodes.
+	_nodes.reserve(((primitiveBounds.size() * 4) / MaximumLeafSize) + 1);
+
+	Node root;
+	root.First = 0;
+	root.PrimitiveCount = static_cast<std::uint32_t>(_primitives.size());
+	_nodes.push_back(root);
+
+	// Children are always added after their parent, which Refit relies on.
+	for (std::size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex)
+	{
+		const std::uint32_t first = _nodes[nodeIndex].First;
+		const std::uint32_t count = _nodes[nodeIndex].PrimitiveCount;
+
+		Bounds centers;
+
+		for (std::uint32_t i = first; i < first + count; ++i)
+		{
+			_nodes[nodeIndex].Box.Add(primitiveBounds[_primitives[i]]);
+			centers.Add(GetCenter(primitiveBounds[_primitives[i]]));
+		}
+
+		if (count <= MaximumLeafSize)
+		{
+			continue;
+		}
+
+		// Split at the median along the axis where the primitives are spread out the most.
+		const glm::vec3 extents = centers.Max - centers.Min;
+
+		int axis = 0;
+
+		if (extents.y > extents[axis])
+		{
+			axis = 1;
+		}
+
+		if (extents.z > extents[axis])
+		{
+			axis = 2;
+		}
+
+		const std::uint32_t half = count / 2;
+
+		std::nth_element(_primitives.begin() + first, _primitives.begin() + first + half, _primitives.begin() + first + count,
+			[&](std::uint32_t lhs, std::uint32_t rhs)
+			{
+				return GetCenter(primitiveBounds[lhs])[axis] < GetCenter(primitiveBounds[rhs])[axis];
+			});
+
+		Node left;
+		left.First = first;
+		left.PrimitiveCount = half;
+
+		Node right;
+		right.First = first + half;
+		right.PrimitiveCount = count - half;
+
+		_nodes[nodeIndex].First = static_cast<std::uint32_t>(_nodes.size());
+		_nodes[nodeIndex].PrimitiveCount = 0;
+
+		_nodes.push_back(left);
+		_nodes.push_back(right);
+	}
+}
+
+void BoundingVolumeHierarchy::Refit(const std::vector<Bounds>& primitiveBounds)
+{
+	assert(primitiveBounds.size() == _primitives.size());
+
+	// Children come after their parent, so walking backwards updates children first.
+	for (auto node = _nodes.rbegin(); node != _nodes.rend(); ++node)
+	{
+		node->Box = {};
+
+		if (node->PrimitiveCount > 0)
+		{
+			for (std::uint32_t i = node->First; i < node->First + node->PrimitiveCount; ++i)
+			{
+				node->Box.Add(primitiveBounds[_primitives[i]]);
+			}
+		}
+		else
+		{
+			node->Box.Add(_nodes[node->First].Box);
+			node->Box.Add(_nodes[node->First + 1].Box);
+		}
+	}
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+	_nodes.clear();
+	_primitives.clear();
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/vec3.hpp>
+
+/**
+*	@brief Axis aligned bounding box tree over a fixed set of primitives, used to speed up ray queries.
+*	The tree is built once for a set of primitives. When the primitives move, call Refit to update the bounds
+*	without changing the structure of the tree.
+*/
+class BoundingVolumeHierarchy final
+{
+public:
+	static constexpr std::size_t MaximumLeafSize = 4;
+
+	struct Bounds
+	{
+		glm::vec3 Min{std::numeric_limits<float>::max()};
+		glm::vec3 Max{std::numeric_limits<float>::lowest()};
+
+		void Add(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		void Add(const Bounds& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+	};
+
+	std::size_t GetPrimitiveCount() const { return _primitives.size(); }
+
+	/**
+	*	@brief Builds the tree for primitives with the given bounds.
+	*	Primitives are identified by their index in @p primitiveBounds.
+	*/
+	void Build(const std::vector<Bounds>& primitiveBounds);
+
+	/**
+	*	@brief Updates the bounds of all nodes after primitives have moved.
+	*	@param primitiveBounds Bounds of the same primitives passed to Build, in the same order.
+	*/
+	void Refit(const std::vector<Bounds>& primitiveBounds);
+
+	void Clear();
+
+	/**
+	*	@brief Visits the primitives whose node is hit by a ray, nearest nodes first.
+	*	@param intersect Called as <tt>intersect(primitiveIndex, closestDistance)</tt>.
+	*		It should test the primitive and reduce @c closestDistance if the primitive is hit closer than that.
+	*		Nodes further away than @c closestDistance are skipped.
+	*	@return The distance to the closest hit, or @p maximumDistance if nothing was hit.
+	*/
+	template<typename Intersect>
+	float Traverse(const glm::vec3& origin, const glm::vec3& direction, float maximumDistance, Intersect&& intersect) const
+	{
+		if (_nodes.empty())
+		{
+			return maximumDistance;
+		}
+
+		const glm::vec3 inverseDirection{1.f / direction.x, 1.f / direction.y, 1.f / direction.z};
+
+		float closest = maximumDistance;
+
+		std::array<std::uint32_t, MaximumDepth> stack;
+		std::size_t stackSize = 0;
+
+		if (IntersectNode(_nodes[0], origin, inverseDirection, closest) < closest)
+		{
+			stack[stackSize++] = 0;
+		}
+
+		while (stackSize > 0)
+		{
+			const auto& node = _nodes[stack[--stackSize]];
+
+			if (node.PrimitiveCount > 0)
+			{
+				for (std::uint32_t i = 0; i < node.PrimitiveCount; ++i)
+				{
+					intersect(_primitives[node.First + i], closest);
+				}
+
+				continue;
+			}
+
+			const float leftDistance = IntersectNode(_nodes[node.First], origin, inverseDirection, closest);
+			const float rightDistance = IntersectNode(_nodes[node.First + 1], origin, inverseDirection, closest);
+
+			// Push the furthest child first so the nearest one is visited first.
+			const bool leftIsNearest = leftDistance <= rightDistance;
+
+			const float nearDistance = leftIsNearest ? leftDistance : rightDistance;
+			const float farDistance = leftIsNearest ? rightDistance : leftDistance;
+
+			if (farDistance < closest)
+			{
+				stack[stackSize++] = leftIsNearest ? node.First + 1 : node.First;
+			}
+
+			if (nearDistance < closest)
+			{
+				stack[stackSize++] = leftIsNearest ? node.First : node.First + 1;
+			}
+		}
+
+		return closest;
+	}
+
+private:
+	/**
+	*	@brief Build splits at the median, so the tree depth is bounded by the log of the primitive count.
+	*	This is enough for 2^60 primitives.
+	*/
+	static constexpr std::size_t MaximumDepth = 64;
+
+	struct Node
+	{
+		Bounds Box;
+
+		/**
+		*	@brief Index of the first primitive for leaves, index of the left child for inner nodes.
+		*	The right child always follows the left child.
+		*/
+		std::uint32_t First{};
+
+		/**
+		*	@brief 0 for inner nodes.
+		*/
+		std::uint32_t PrimitiveCount{};
+	};
+
+	/**
+	*	@brief Gets the distance at which the ray enters the node,
+	*	or the maximum float value if it misses the node or enters it beyond @p maximumDistance.
+	*/
+	static float IntersectNode(
+		const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maximumDistance)
+	{
+		const glm::vec3 t0 = (node.Box.Min - origin) * inverseDirection;
+		const glm::vec3 t1 = (node.Box.Max - origin) * inverseDirection;
+
+		const glm::vec3 entries = glm::min(t0, t1);
+		const glm::vec3 exits = glm::max(t0, t1);
+
+		const float entry = std::max({entries.x, entries.y, entries.z, 0.f});
+		const float exit = std::min({exits.x, exits.y, exits.z, maximumDistance});
+
+		return entry <= exit ? entry : std::numeric_limits<float>::max();
+	}
+
+private:
+	std::vector<Node> _nodes;
+
+	/**
+	*	@brief Primitive indices, ordered so that each leaf references a contiguous range.
+	*/
+	std::vector<std::uint32_t> _primitives;
+};
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cmath>
+
+#include "utility/FrameScheduler.hpp"
+
+namespace
+{
+double ToSeconds(FrameScheduler::Duration duration)
+{
+	return std::chrono::duration<double>{duration}.count();
+}
+
+double ToMilliseconds(FrameScheduler::Duration duration)
+{
+	return std::chrono::duration<double, std::milli>{duration}.count();
+}
+}
+
+void FrameScheduler::SetInterval(Duration interval)
+{
+	_interval = std::max(interval, Duration{1});
+	_accumulatedTime = {};
+
+	if (_hasPreviousFrame)
+	{
+		_nextDeadline = _previousFrameTime + _interval;
+	}
+}
+
+void FrameScheduler::SetFixedTimeStep(bool value)
+{
+	if (_fixedTimeStep != value)
+	{
+		_fixedTimeStep = value;
+		_accumulatedTime = {};
+	}
+}
+
+FrameScheduler::Frame FrameScheduler::BeginFrame(Clock::time_point now)
+{
+	if (!_hasPreviousFrame)
+	{
+		_hasPreviousFrame = true;
+		_previousFrameTime = now;
+		_nextDeadline = now + _interval;
+
+		if (_fixedTimeStep)
+		{
+			return {0, ToSeconds(_interval)};
+		}
+
+		return {1, 0.0};
+	}
+
+	auto frameTime = std::chrono::duration_cast<Duration>(now - _previousFrameTime);
+
+	_previousFrameTime = now;
+
+	_frameTimes[_nextFrameTimeIndex] = frameTime;
+	_nextFrameTimeIndex = (_nextFrameTimeIndex + 1) % _frameTimes.size();
+	_frameTimeCount = std::min(_frameTimeCount + 1, _frameTimes.size());
+
+	// Deadlines advance by exactly one interval so the frame rate does not drift.
+	// If we've fallen too far behind, start a new schedule from this frame instead of running frames back to back.
+	_nextDeadline += _interval;
+
+	if (_nextDeadline <= now)
+	{
+		_nextDeadline = now + _interval;
+	}
+
+	if (frameTime > MaximumFrameTime)
+	{
+		frameTime = StalledFrameTime;
+	}
+
+	if (!_fixedTimeStep)
+	{
+		return {1, ToSeconds(frameTime)};
+	}
+
+	_accumulatedTime += frameTime;
+
+	std::size_t stepCount = static_cast<std::size_t>(_accumulatedTime / _interval);
+
+	if (stepCount > MaximumStepsPerFrame)
+	{
+		// Drop the time we can't catch up on so we don't keep falling further behind.
+		stepCount = MaximumStepsPerFrame;
+		_accumulatedTime %= _interval;
+	}
+	else
+	{
+		_accumulatedTime -= _interval * static_cast<Duration::rep>(stepCount);
+	}
+
+	return {stepCount, ToSeconds(_interval)};
+}
+
+FrameScheduler::Duration FrameScheduler::GetTimeUntilNextFrame(Clock::time_point now) const
+{
+	if (!_hasPreviousFrame || _nextDeadline <= now)
+	{
+		return Duration::zero();
+	}
+
+	return std::chrono::duration_cast<Duration>(_nextDeadline - now);
+}
+
+FrameStatistics FrameScheduler::GetStatistics() const
+{
+	FrameStatistics statistics;
+
+	statistics.FrameCount = _frameTimeCount;
+
+	if (_frameTimeCount == 0)
+	{
+		return statistics;
+	}
+
+	std::array<Duration, StatisticsFrameCount> frameTimes;
+
+	const auto end = std::copy_n(_frameTimes.begin(), _frameTimeCount, frameTimes.begin());
+
+	const auto [minimum, maximum] = std::minmax_element(frameTimes.begin(), end);
+
+	statistics.Minimum = ToMilliseconds(*minimum);
+	statistics.Maximum = ToMilliseconds(*maximum);
+
+	Duration total{};
+
+	for (auto it = frameTimes.begin(); it != end; ++it)
+	{
+		total += *it;
+	}
+
+	statistics.Average = ToMilliseconds(total) / _frameTimeCount;
+
+	const std::size_t percentileIndex = static_cast<std::size_t>(std::ceil(_frameTimeCount * 0.99)) - 1;
+
+	std::nth_element(frameTimes.begin(), frameTimes.begin() + percentileIndex, end);
+
+	statistics.Percentile99 = ToMilliseconds(frameTimes[percentileIndex]);
+
+	return statistics;
+}
+
+void FrameScheduler::ResetStatistics()
+{
+	_frameTimeCount = 0;
+	_nextFrameTimeIndex = 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+*	@brief Frame time statistics over the most recent frames, in milliseconds.
+*/
+struct FrameStatistics
+{
+	std::size_t FrameCount{};
+	double Minimum{};
+	double Average{};
+	double Maximum{};
+	double Percentile99{};
+};
+
+/**
+*	@brief Decides when frames should run and how far simulation time should advance for each frame.
+*	Frame deadlines are computed from a fixed origin so rounding errors in the timer that wakes up the application do not accumulate.
+*	Does not depend on Qt; the caller is responsible for waking up at the requested time.
+*/
+class FrameScheduler final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	using Duration = std::chrono::microseconds;
+
+	/**
+	*	@brief Frames longer than this are assumed to be caused by the application being suspended or stalled.
+	*/
+	static constexpr Duration MaximumFrameTime{std::chrono::seconds{1}};
+
+	/**
+	*	@brief How far time advances for frames longer than @ref MaximumFrameTime.
+	*/
+	static constexpr Duration StalledFrameTime{std::chrono::milliseconds{100}};
+
+	/**
+	*	@brief Maximum number of fixed steps to run in a single frame.
+	*	Limits how much work is done to catch up after a slow frame.
+	*/
+	static constexpr std::size_t MaximumStepsPerFrame{8};
+
+	static constexpr std::size_t StatisticsFrameCount{256};
+
+	struct Frame
+	{
+		/**
+		*	@brief Number of simulation steps to run this frame. May be 0 in fixed step mode.
+		*/
+		std::size_t StepCount{};
+
+		/**
+		*	@brief How far simulation time advances for each step, in seconds.
+		*/
+		double StepTime{};
+	};
+
+	FrameScheduler() = default;
+	FrameScheduler(const FrameScheduler&) = delete;
+	FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+	Duration GetInterval() const { return _interval; }
+
+	/**
+	*	@brief Sets the time between frames. Resets the frame deadline schedule.
+	*/
+	void SetInterval(Duration interval);
+
+	bool IsFixedTimeStep() const { return _fixedTimeStep; }
+
+	/**
+	*	@brief If enabled, simulation time advances in steps of exactly one interval.
+	*	Time that has not been simulated yet is carried over to the next frame.
+	*/
+	void SetFixedTimeStep(bool value);
+
+	/**
+	*	@brief Starts a new frame at time @p now.
+	*	If frames have fallen behind by more than one interval the schedule is moved forward instead of trying to catch up.
+	*/
+	Frame BeginFrame(Clock::time_point now);
+
+	/**
+	*	@brief Gets the amount of time to wait from @p now until the next frame should start.
+	*/
+	Duration GetTimeUntilNextFrame(Clock::time_point now) const;
+
+	/**
+	*	@brief Gets statistics for the last @ref StatisticsFrameCount frames.
+	*/
+	FrameStatistics GetStatistics() const;
+
+	void ResetStatistics();
+
+private:
+	Duration _interval{std::chrono::milliseconds{16}};
+	bool _fixedTimeStep{false};
+
+	bool _hasPreviousFrame{false};
+	Clock::time_point _previousFrameTime;
+	Clock::time_point _nextDeadline;
+	Duration _accumulatedTime{};
+
+	std::array<Duration, StatisticsFrameCount> _frameTimes{};
+	std::size_t _frameTimeCount{};
+	std::size_t _nextFrameTimeIndex{};
+};
@@ -10,6 +10,8 @@
 #include <Windows.h>
 #include <fcntl.h>
 #include <io.h>
+#else
+#include <unistd.h>
 #endif
 
 FILE* utf8_fopen(const char* filename, const char* mode)
@@ -88,3 +90,19 @@ std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadFileIntoBuffer(FILE* file)
 
 	return { std::move(buffer), size };
 }
+
+bool FlushFileToDisk(FILE* file)
+{
+	assert(file);
+
+	if (fflush(file) != 0)
+	{
+		return false;
+	}
+
+#ifdef WIN32
+	return _commit(_fileno(file)) == 0;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
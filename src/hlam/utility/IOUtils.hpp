@@ -37,3 +37,9 @@ inline FILE* utf8_exclusive_read_fopen(const char8_t* filename, bool asBinary)
 }
 
 std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadFileIntoBuffer(FILE* file);
+
+/**
+*	@brief Flushes buffered data and waits for the operating system to write the file's contents to the storage device.
+*	@return Whether all data was written
+*/
+bool FlushFileToDisk(FILE* file);
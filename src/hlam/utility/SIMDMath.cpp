@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "utility/SIMDMath.hpp"
+
+#if HLAM_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// Matches glm::epsilon<float>(), used by glm::slerp to decide when to fall back to linear interpolation.
+constexpr float SlerpLinearThreshold = 1.0f - FLT_EPSILON;
+
+void SlerpQuaternion(QuaternionArrays to, ConstQuaternionArrays from, float s, std::size_t i)
+{
+	const float xx = to.X[i];
+	const float xy = to.Y[i];
+	const float xz = to.Z[i];
+	const float xw = to.W[i];
+
+	float zx = from.X[i];
+	float zy = from.Y[i];
+	float zz = from.Z[i];
+	float zw = from.W[i];
+
+	float cosTheta = (xw * zw + xx * zx) + (xy * zy + xz * zz);
+
+	if (cosTheta < 0.0f)
+	{
+		zx = -zx;
+		zy = -zy;
+		zz = -zz;
+		zw = -zw;
+		cosTheta = -cosTheta;
+	}
+
+	if (cosTheta > SlerpLinearThreshold)
+	{
+		const float s1 = 1.0f - s;
+
+		to.X[i] = xx * s1 + zx * s;
+		to.Y[i] = xy * s1 + zy * s;
+		to.Z[i] = xz * s1 + zz * s;
+		to.W[i] = xw * s1 + zw * s;
+	}
+	else
+	{
+		const float angle = std::acos(cosTheta);
+		const float fromWeight = std::sin((1.0f - s) * angle);
+		const float toWeight = std::sin(s * angle);
+		const float divisor = std::sin(angle);
+
+		to.X[i] = (xx * fromWeight + zx * toWeight) / divisor;
+		to.Y[i] = (xy * fromWeight + zy * toWeight) / divisor;
+		to.Z[i] = (xz * fromWeight + zz * toWeight) / divisor;
+		to.W[i] = (xw * fromWeight + zw * toWeight) / divisor;
+	}
+}
+
+void QuaternionToMatrix(ConstQuaternionArrays rotations, ConstVector3Arrays positions, glm::mat4x4& matrix, std::size_t i)
+{
+	const float x = rotations.X[i];
+	const float y = rotations.Y[i];
+	const float z = rotations.Z[i];
+	const float w = rotations.W[i];
+
+	const float qxx = x * x;
+	const float qyy = y * y;
+	const float qzz = z * z;
+	const float qxz = x * z;
+	const float qxy = x * y;
+	const float qyz = y * z;
+	const float qwx = w * x;
+	const float qwy = w * y;
+	const float qwz = w * z;
+
+	matrix[0] = glm::vec4{1.0f - 2.0f * (qyy + qzz), 2.0f * (qxy + qwz), 2.0f * (qxz - qwy), 0.0f};
+	matrix[1] = glm::vec4{2.0f * (qxy - qwz), 1.0f - 2.0f * (qxx + qzz), 2.0f * (qyz + qwx), 0.0f};
+	matrix[2] = glm::vec4{2.0f * (qxz + qwy), 2.0f * (qyz - qwx), 1.0f - 2.0f * (qxx + qyy), 0.0f};
+	matrix[3] = glm::vec4{positions.X[i], positions.Y[i], positions.Z[i], 1.0f};
+}
+
+#if HLAM_SIMD_SSE2
+float HorizontalMinimum(__m128 value)
+{
+	value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+	value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtss_f32(value);
+}
+
+float HorizontalMaximum(__m128 value)
+{
+	value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+	value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtss_f32(value);
+}
+#endif
+}
+
+void SlerpQuaternions(QuaternionArrays to, ConstQuaternionArrays from, float s, std::size_t count)
+{
+	std::size_t i = 0;
+
+#if HLAM_SIMD_SSE2
+	const __m128 weight = _mm_set1_ps(s);
+	const __m128 inverseWeight = _mm_set1_ps(1.0f - s);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	const __m128 linearThreshold = _mm_set1_ps(SlerpLinearThreshold);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 xx = _mm_load_ps(to.X + i);
+		const __m128 xy = _mm_load_ps(to.Y + i);
+		const __m128 xz = _mm_load_ps(to.Z + i);
+		const __m128 xw = _mm_load_ps(to.W + i);
+
+		__m128 zx = _mm_load_ps(from.X + i);
+		__m128 zy = _mm_load_ps(from.Y + i);
+		__m128 zz = _mm_load_ps(from.Z + i);
+		__m128 zw = _mm_load_ps(from.W + i);
+
+		__m128 cosTheta = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(xw, zw), _mm_mul_ps(xx, zx)),
+			_mm_add_ps(_mm_mul_ps(xy, zy), _mm_mul_ps(xz, zz)));
+
+		// Take the short way around by negating the second quaternion.
+		const __m128 negate = _mm_and_ps(_mm_cmplt_ps(cosTheta, zero), signBit);
+
+		zx = _mm_xor_ps(zx, negate);
+		zy = _mm_xor_ps(zy, negate);
+		zz = _mm_xor_ps(zz, negate);
+		zw = _mm_xor_ps(zw, negate);
+		cosTheta = _mm_xor_ps(cosTheta, negate);
+
+		const __m128 linearMask = _mm_cmpgt_ps(cosTheta, linearThreshold);
+		const int linearLanes = _mm_movemask_ps(linearMask);
+
+		const __m128 lx = _mm_add_ps(_mm_mul_ps(xx, inverseWeight), _mm_mul_ps(zx, weight));
+		const __m128 ly = _mm_add_ps(_mm_mul_ps(xy, inverseWeight), _mm_mul_ps(zy, weight));
+		const __m128 lz = _mm_add_ps(_mm_mul_ps(xz, inverseWeight), _mm_mul_ps(zz, weight));
+		const __m128 lw = _mm_add_ps(_mm_mul_ps(xw, inverseWeight), _mm_mul_ps(zw, weight));
+
+		if (linearLanes == 0xF)
+		{
+			_mm_store_ps(to.X + i, lx);
+			_mm_store_ps(to.Y + i, ly);
+			_mm_store_ps(to.Z + i, lz);
+			_mm_store_ps(to.W + i, lw);
+			continue;
+		}
+
+		// There is no SSE2 acos or sin, so the trigonometry is evaluated per lane using the same functions glm uses.
+		alignas(16) float cosines[4];
+		alignas(16) float fromWeights[4]{0, 0, 0, 0};
+		alignas(16) float toWeights[4]{0, 0, 0, 0};
+		alignas(16) float divisors[4]{1, 1, 1, 1};
+
+		_mm_store_ps(cosines, cosTheta);
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			if (!(linearLanes & (1 << lane)))
+			{
+				const float angle = std::acos(cosines[lane]);
+				fromWeights[lane] = std::sin((1.0f - s) * angle);
+				toWeights[lane] = std::sin(s * angle);
+				divisors[lane] = std::sin(angle);
+			}
+		}
+
+		const __m128 fromWeight = _mm_load_ps(fromWeights);
+		const __m128 toWeight = _mm_load_ps(toWeights);
+		const __m128 divisor = _mm_load_ps(divisors);
+
+		const __m128 sx = _mm_div_ps(_mm_add_ps(_mm_mul_ps(xx, fromWeight), _mm_mul_ps(zx, toWeight)), divisor);
+		const __m128 sy = _mm_div_ps(_mm_add_ps(_mm_mul_ps(xy, fromWeight), _mm_mul_ps(zy, toWeight)), divisor);
+		const __m128 sz = _mm_div_ps(_mm_add_ps(_mm_mul_ps(xz, fromWeight), _mm_mul_ps(zz, toWeight)), divisor);
+		const __m128 sw = _mm_div_ps(_mm_add_ps(_mm_mul_ps(xw, fromWeight), _mm_mul_ps(zw, toWeight)), divisor);
+
+		_mm_store_ps(to.X + i, _mm_or_ps(_mm_and_ps(linearMask, lx), _mm_andnot_ps(linearMask, sx)));
+		_mm_store_ps(to.Y + i, _mm_or_ps(_mm_and_ps(linearMask, ly), _mm_andnot_ps(linearMask, sy)));
+		_mm_store_ps(to.Z + i, _mm_or_ps(_mm_and_ps(linearMask, lz), _mm_andnot_ps(linearMask, sz)));
+		_mm_store_ps(to.W + i, _mm_or_ps(_mm_and_ps(linearMask, lw), _mm_andnot_ps(linearMask, sw)));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		SlerpQuaternion(to, from, s, i);
+	}
+}
+
+void LerpVectors(Vector3Arrays to, ConstVector3Arrays from, float s, std::size_t count)
+{
+	const float s1 = 1.0f - s;
+
+	std::size_t i = 0;
+
+#if HLAM_SIMD_SSE2
+	const __m128 weight = _mm_set1_ps(s);
+	const __m128 inverseWeight = _mm_set1_ps(s1);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_store_ps(to.X + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(to.X + i), inverseWeight), _mm_mul_ps(_mm_load_ps(from.X + i), weight)));
+		_mm_store_ps(to.Y + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(to.Y + i), inverseWeight), _mm_mul_ps(_mm_load_ps(from.Y + i), weight)));
+		_mm_store_ps(to.Z + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(to.Z + i), inverseWeight), _mm_mul_ps(_mm_load_ps(from.Z + i), weight)));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		to.X[i] = to.X[i] * s1 + from.X[i] * s;
+		to.Y[i] = to.Y[i] * s1 + from.Y[i] * s;
+		to.Z[i] = to.Z[i] * s1 + from.Z[i] * s;
+	}
+}
+
+void QuaternionsToMatrices(
+	ConstQuaternionArrays rotations, ConstVector3Arrays positions, glm::mat4x4* matrices, std::size_t count)
+{
+	std::size_t i = 0;
+
+#if HLAM_SIMD_SSE2
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = _mm_load_ps(rotations.X + i);
+		const __m128 y = _mm_load_ps(rotations.Y + i);
+		const __m128 z = _mm_load_ps(rotations.Z + i);
+		const __m128 w = _mm_load_ps(rotations.W + i);
+
+		const __m128 qxx = _mm_mul_ps(x, x);
+		const __m128 qyy = _mm_mul_ps(y, y);
+		const __m128 qzz = _mm_mul_ps(z, z);
+		const __m128 qxz = _mm_mul_ps(x, z);
+		const __m128 qxy = _mm_mul_ps(x, y);
+		const __m128 qyz = _mm_mul_ps(y, z);
+		const __m128 qwx = _mm_mul_ps(w, x);
+		const __m128 qwy = _mm_mul_ps(w, y);
+		const __m128 qwz = _mm_mul_ps(w, z);
+
+		// Each register holds one matrix element for 4 bones; transposing turns them into one column per bone.
+		__m128 c00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qyy, qzz)));
+		__m128 c01 = _mm_mul_ps(two, _mm_add_ps(qxy, qwz));
+		__m128 c02 = _mm_mul_ps(two, _mm_sub_ps(qxz, qwy));
+		__m128 c03 = zero;
+
+		__m128 c10 = _mm_mul_ps(two, _mm_sub_ps(qxy, qwz));
+		__m128 c11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qzz)));
+		__m128 c12 = _mm_mul_ps(two, _mm_add_ps(qyz, qwx));
+		__m128 c13 = zero;
+
+		__m128 c20 = _mm_mul_ps(two, _mm_add_ps(qxz, qwy));
+		__m128 c21 = _mm_mul_ps(two, _mm_sub_ps(qyz, qwx));
+		__m128 c22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qyy)));
+		__m128 c23 = zero;
+
+		__m128 c30 = _mm_load_ps(positions.X + i);
+		__m128 c31 = _mm_load_ps(positions.Y + i);
+		__m128 c32 = _mm_load_ps(positions.Z + i);
+		__m128 c33 = one;
+
+		_MM_TRANSPOSE4_PS(c00, c01, c02, c03);
+		_MM_TRANSPOSE4_PS(c10, c11, c12, c13);
+		_MM_TRANSPOSE4_PS(c20, c21, c22, c23);
+		_MM_TRANSPOSE4_PS(c30, c31, c32, c33);
+
+		const __m128 columns[4][4] =
+		{
+			{c00, c10, c20, c30},
+			{c01, c11, c21, c31},
+			{c02, c12, c22, c32},
+			{c03, c13, c23, c33}
+		};
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			auto& matrix = matrices[i + lane];
+
+			for (int column = 0; column < 4; ++column)
+			{
+				_mm_storeu_ps(&matrix[column][0], columns[lane][column]);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		QuaternionToMatrix(rotations, positions, matrices[i], i);
+	}
+}
+
+void MultiplyMatrices(const glm::mat4x4& lhs, const glm::mat4x4& rhs, glm::mat4x4& result)
+{
+#if HLAM_SIMD_SSE2
+	const __m128 lhs0 = _mm_loadu_ps(&lhs[0][0]);
+	const __m128 lhs1 = _mm_loadu_ps(&lhs[1][0]);
+	const __m128 lhs2 = _mm_loadu_ps(&lhs[2][0]);
+	const __m128 lhs3 = _mm_loadu_ps(&lhs[3][0]);
+
+	for (int column = 0; column < 4; ++column)
+	{
+		const auto& source = rhs[column];
+
+		// Same order of operations as glm's operator* so the results are identical.
+		const __m128 value = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(lhs0, _mm_set1_ps(source[0])),
+			_mm_mul_ps(lhs1, _mm_set1_ps(source[1]))),
+			_mm_mul_ps(lhs2, _mm_set1_ps(source[2]))),
+			_mm_mul_ps(lhs3, _mm_set1_ps(source[3])));
+
+		_mm_storeu_ps(&result[column][0], value);
+	}
+#else
+	result = lhs * rhs;
+#endif
+}
+
+void ExpandBoundsByTransformedPoints(
+	const glm::mat4x4& matrix, ConstVector3Arrays points, std::size_t count, glm::vec3& mins, glm::vec3& maxs)
+{
+	std::size_t i = 0;
+
+#if HLAM_SIMD_SSE2
+	if (count >= 4)
+	{
+		const __m128 m00 = _mm_set1_ps(matrix[0][0]);
+		const __m128 m01 = _mm_set1_ps(matrix[0][1]);
+		const __m128 m02 = _mm_set1_ps(matrix[0][2]);
+		const __m128 m10 = _mm_set1_ps(matrix[1][0]);
+		const __m128 m11 = _mm_set1_ps(matrix[1][1]);
+		const __m128 m12 = _mm_set1_ps(matrix[1][2]);
+		const __m128 m20 = _mm_set1_ps(matrix[2][0]);
+		const __m128 m21 = _mm_set1_ps(matrix[2][1]);
+		const __m128 m22 = _mm_set1_ps(matrix[2][2]);
+		const __m128 m30 = _mm_set1_ps(matrix[3][0]);
+		const __m128 m31 = _mm_set1_ps(matrix[3][1]);
+		const __m128 m32 = _mm_set1_ps(matrix[3][2]);
+
+		__m128 minX = _mm_set1_ps(mins.x);
+		__m128 minY = _mm_set1_ps(mins.y);
+		__m128 minZ = _mm_set1_ps(mins.z);
+		__m128 maxX = _mm_set1_ps(maxs.x);
+		__m128 maxY = _mm_set1_ps(maxs.y);
+		__m128 maxZ = _mm_set1_ps(maxs.z);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(points.X + i);
+			const __m128 y = _mm_loadu_ps(points.Y + i);
+			const __m128 z = _mm_loadu_ps(points.Z + i);
+
+			// Same order of operations as glm's matrix * vector operator.
+			const __m128 tx = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), _mm_add_ps(_mm_mul_ps(m20, z), m30));
+			const __m128 ty = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m21, z), m31));
+			const __m128 tz = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), _mm_add_ps(_mm_mul_ps(m22, z), m32));
+
+			minX = _mm_min_ps(minX, tx);
+			minY = _mm_min_ps(minY, ty);
+			minZ = _mm_min_ps(minZ, tz);
+			maxX = _mm_max_ps(maxX, tx);
+			maxY = _mm_max_ps(maxY, ty);
+			maxZ = _mm_max_ps(maxZ, tz);
+		}
+
+		mins = glm::vec3{HorizontalMinimum(minX), HorizontalMinimum(minY), HorizontalMinimum(minZ)};
+		maxs = glm::vec3{HorizontalMaximum(maxX), HorizontalMaximum(maxY), HorizontalMaximum(maxZ)};
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const float x = points.X[i];
+		const float y = points.Y[i];
+		const float z = points.Z[i];
+
+		const float tx = (matrix[0][0] * x + matrix[1][0] * y) + (matrix[2][0] * z + matrix[3][0]);
+		const float ty = (matrix[0][1] * x + matrix[1][1] * y) + (matrix[2][1] * z + matrix[3][1]);
+		const float tz = (matrix[0][2] * x + matrix[1][2] * y) + (matrix[2][2] * z + matrix[3][2]);
+
+		mins = glm::vec3{std::min(mins.x, tx), std::min(mins.y, ty), std::min(mins.z, tz)};
+		maxs = glm::vec3{std::max(maxs.x, tx), std::max(maxs.y, ty), std::max(maxs.z, tz)};
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+/**
+*	@file
+*
+*	Batched math operations over structure of arrays data.
+*	Uses SSE2 when available and falls back to scalar code otherwise.
+*	Results match the equivalent glm operations exactly (apart from the sign of zero),
+*	because every lane performs the same operations in the same order as glm does.
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HLAM_SIMD_SSE2 1
+#else
+#define HLAM_SIMD_SSE2 0
+#endif
+
+/**
+*	@brief Quaternions stored as separate arrays of components.
+*	Arrays must be 16 byte aligned and hold at least @c count elements rounded up to a multiple of 4.
+*/
+struct QuaternionArrays
+{
+	float* X;
+	float* Y;
+	float* Z;
+	float* W;
+};
+
+struct ConstQuaternionArrays
+{
+	const float* X;
+	const float* Y;
+	const float* Z;
+	const float* W;
+};
+
+/**
+*	@brief 3D vectors stored as separate arrays of components. Same requirements as QuaternionArrays.
+*/
+struct Vector3Arrays
+{
+	float* X;
+	float* Y;
+	float* Z;
+};
+
+struct ConstVector3Arrays
+{
+	const float* X;
+	const float* Y;
+	const float* Z;
+};
+
+/**
+*	@brief Equivalent to <tt>to[i] = glm::slerp(to[i], from[i], s)</tt> for the first @p count quaternions.
+*/
+void SlerpQuaternions(QuaternionArrays to, ConstQuaternionArrays from, float s, std::size_t count);
+
+/**
+*	@brief Equivalent to <tt>to[i] = to[i] * (1 - s) + from[i] * s</tt> for the first @p count vectors.
+*/
+void LerpVectors(Vector3Arrays to, ConstVector3Arrays from, float s, std::size_t count);
+
+/**
+*	@brief Equivalent to <tt>matrices[i] = glm::translate(positions[i]) * glm::toMat4(rotations[i])</tt>
+*	for the first @p count elements.
+*/
+void QuaternionsToMatrices(
+	ConstQuaternionArrays rotations, ConstVector3Arrays positions, glm::mat4x4* matrices, std::size_t count);
+
+/**
+*	@brief Equivalent to <tt>result = lhs * rhs</tt>. @p result may not alias either operand.
+*/
+void MultiplyMatrices(const glm::mat4x4& lhs, const glm::mat4x4& rhs, glm::mat4x4& result);
+
+/**
+*	@brief Expands @p mins and @p maxs to include <tt>glm::vec3{matrix * glm::vec4{points[i], 1}}</tt>
+*	for the first @p count points. Unlike the other functions, the arrays do not need to be aligned or padded.
+*/
+void ExpandBoundsByTransformedPoints(
+	const glm::mat4x4& matrix, ConstVector3Arrays points, std::size_t count, glm::vec3& mins, glm::vec3& maxs);
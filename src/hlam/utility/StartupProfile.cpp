@@ -0,0 +1,30 @@
+#include <utility>
+
+#include "utility/StartupProfile.hpp"
+
+namespace
+{
+double ToMilliseconds(StartupProfile::Clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>{duration}.count();
+}
+}
+
+StartupProfile::StartupProfile()
+	: _start(Clock::now())
+	, _phaseStart(_start)
+{
+}
+
+void StartupProfile::EndPhase(std::string name)
+{
+	const auto now = Clock::now();
+
+	_phases.push_back({std::move(name), ToMilliseconds(now - _phaseStart)});
+	_phaseStart = now;
+}
+
+double StartupProfile::GetTotalTime() const
+{
+	return ToMilliseconds(_phaseStart - _start);
+}
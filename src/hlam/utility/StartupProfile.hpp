@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+*	@brief Records how long each phase of program startup takes.
+*	Phases are consecutive: each phase starts when the previous one ended.
+*/
+class StartupProfile final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase
+	{
+		std::string Name;
+
+		/**
+		*	@brief Time taken by this phase, in milliseconds.
+		*/
+		double Duration{};
+	};
+
+	StartupProfile();
+
+	/**
+	*	@brief Ends the current phase and starts the next one.
+	*/
+	void EndPhase(std::string name);
+
+	const std::vector<Phase>& GetPhases() const { return _phases; }
+
+	/**
+	*	@brief Time from the start of the profile to the end of the last phase, in milliseconds.
+	*/
+	double GetTotalTime() const;
+
+private:
+	const Clock::time_point _start;
+	Clock::time_point _phaseStart;
+
+	std::vector<Phase> _phases;
+};
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "utility/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+	_threads.reserve(threadCount);
+
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		_threads.emplace_back(&ThreadPool::WorkerMain, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock{_mutex};
+		_quit = true;
+	}
+
+	_condition.notify_all();
+
+	for (auto& thread : _threads)
+	{
+		thread.join();
+	}
+}
+
+std::size_t ThreadPool::GetDefaultThreadCount(std::size_t reservedThreads, std::size_t maximumThreads)
+{
+	const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+
+	if (hardwareThreads <= reservedThreads)
+	{
+		return 0;
+	}
+
+	return std::min(hardwareThreads - reservedThreads, maximumThreads);
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	if (count == 1 || _threads.empty())
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			function(i);
+		}
+
+		return;
+	}
+
+	struct Job
+	{
+		const std::function<void(std::size_t)>* Function;
+		const std::size_t Count;
+		std::atomic<std::size_t> Next{0};
+		std::atomic<std::size_t> Completed{0};
+		std::mutex Mutex;
+		std::condition_variable Done;
+	};
+
+	// Helpers that start after all indices have been claimed must not touch the job's function,
+	// so the job is shared and indices are claimed before the function is dereferenced.
+	const auto job = std::make_shared<Job>(&function, count);
+
+	const auto runJob = [](Job& job)
+	{
+		std::size_t completed = 0;
+
+		for (std::size_t index; (index = job.Next.fetch_add(1, std::memory_order_relaxed)) < job.Count;)
+		{
+			(*job.Function)(index);
+			++completed;
+		}
+
+		if (completed > 0 && job.Completed.fetch_add(completed, std::memory_order_acq_rel) + completed == job.Count)
+		{
+			std::lock_guard lock{job.Mutex};
+			job.Done.notify_all();
+		}
+	};
+
+	const std::size_t helperCount = std::min(count - 1, _threads.size());
+
+	for (std::size_t i = 0; i < helperCount; ++i)
+	{
+		Enqueue([job, runJob] { runJob(*job); });
+	}
+
+	runJob(*job);
+
+	std::unique_lock lock{job->Mutex};
+	job->Done.wait(lock, [&] { return job->Completed.load(std::memory_order_acquire) == job->Count; });
+}
+
+void ThreadPool::Enqueue(std::function<void()>&& task)
+{
+	{
+		std::lock_guard lock{_mutex};
+		_tasks.push_back(std::move(task));
+	}
+
+	_condition.notify_one();
+}
+
+void ThreadPool::WorkerMain()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock lock{_mutex};
+			_condition.wait(lock, [this] { return _quit || !_tasks.empty(); });
+
+			if (_quit && _tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		task();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+*	@brief Small pool of persistent worker threads.
+*	Does not depend on Qt so it can be used by code that has no event loop.
+*/
+class ThreadPool final
+{
+public:
+	/**
+	*	@param threadCount Number of worker threads to create. May be 0, in which case all work runs on the calling thread.
+	*/
+	explicit ThreadPool(std::size_t threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	*	@brief Gets the number of worker threads, not including the calling thread.
+	*/
+	std::size_t GetThreadCount() const { return _threads.size(); }
+
+	/**
+	*	@brief Gets a sensible number of worker threads for a pool that should leave @p reservedThreads cores free.
+	*	@param maximumThreads Upper limit on the number of threads to return.
+	*/
+	static std::size_t GetDefaultThreadCount(std::size_t reservedThreads, std::size_t maximumThreads);
+
+	/**
+	*	@brief Invokes @p function once for every index in [0, count) and waits until all invocations have finished.
+	*	The calling thread participates in the work, so this may safely be called from inside a worker.
+	*	The order in which indices are processed is unspecified; callers must write results to disjoint locations.
+	*/
+	void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+private:
+	void Enqueue(std::function<void()>&& task);
+
+	void WorkerMain();
+
+private:
+	std::vector<std::thread> _threads;
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::deque<std::function<void()>> _tasks;
+	bool _quit{false};
+};
@@ -1,14 +1,8 @@
 #include "utility/WorldTime.hpp"
 
-void WorldTime::TimeChanged(double currentTime)
+void WorldTime::Advance(double frameTime)
 {
-	double frameTime = currentTime - GetPreviousRealTime();
-
-	if (frameTime > 1.0)
-		frameTime = 0.1;
-
-	SetPreviousTime(GetTime());
-	SetTime(static_cast<float>(GetTime() + frameTime));
+	_prevTime = _currentTime;
+	_currentTime += frameTime;
 	SetFrameTime(static_cast<float>(frameTime));
-	SetPreviousRealTime(GetRealTime());
 }
@@ -13,7 +13,7 @@ public:
 	/**
 	*	@brief The current time. Starts at 1.0.
 	*/
-	float GetTime() const { return _currentTime; }
+	float GetTime() const { return static_cast<float>(_currentTime); }
 
 	/**
 	*	@brief Sets the current time. Avoid using this.
@@ -23,7 +23,7 @@ public:
 	/**
 	*	@brief Gets the previous current time before the last time increment. Equal to GetCurrentTime() - GetFrameTime().
 	*/
-	float GetPreviousTime() const { return _prevTime; }
+	float GetPreviousTime() const { return static_cast<float>(_prevTime); }
 
 	/**
 	*	@brief Sets the previous time. Avoid using this.
@@ -61,13 +61,15 @@ public:
 	void SetPreviousRealTime(double realTime) { _prevRealTime = realTime; }
 
 	/**
-	*	@brief Call with the new current time to update world time.
+	*	@brief Advances world time by @p frameTime seconds.
+	*	The caller is responsible for limiting the frame time.
 	*/
-	void TimeChanged(double currentTime);
+	void Advance(double frameTime);
 
 private:
-	float _currentTime = 1.0f;
-	float _prevTime = 1.0f;
+	// Accumulated in double precision so time doesn't drift when the program runs for a long time.
+	double _currentTime = 1.0;
+	double _prevTime = 1.0;
 	float _frameTime = 0.0f;
 	double _realTime = 0.0f;
 	double _prevRealTime = 0.0f;